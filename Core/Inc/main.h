@@ -73,6 +73,9 @@ void Error_Handler(void);
 #define SWO_GPIO_Port GPIOB
 
 /* USER CODE BEGIN Private defines */
+#define RTC_SQW_Pin GPIO_PIN_5
+#define RTC_SQW_GPIO_Port GPIOB
+#define RTC_SQW_EXTI_IRQn EXTI9_5_IRQn
 
 /* USER CODE END Private defines */
 
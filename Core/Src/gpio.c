@@ -70,4 +70,24 @@ void MX_GPIO_Init(void)
 
 /* USER CODE BEGIN 2 */
 
+/** Configure INT/SQW del DS3231 (open drain) como EXTI en flanco descendente */
+void RTC_SQW_GPIO_Init(void)
+{
+
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  __HAL_RCC_GPIOB_CLK_ENABLE();
+
+  /*Configure GPIO pin : RTC_SQW_Pin */
+  GPIO_InitStruct.Pin = RTC_SQW_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_IT_FALLING;
+  GPIO_InitStruct.Pull = GPIO_PULLUP;
+  HAL_GPIO_Init(RTC_SQW_GPIO_Port, &GPIO_InitStruct);
+
+  /* EXTI interrupt init: debajo del SysTick, cuyos timeouts usan las escrituras bloqueantes desde la ISR */
+  HAL_NVIC_SetPriority(RTC_SQW_EXTI_IRQn, TICK_INT_PRIORITY + 1U, 0);
+  HAL_NVIC_EnableIRQ(RTC_SQW_EXTI_IRQn);
+
+}
+
 /* USER CODE END 2 */
@@ -20,8 +20,10 @@
 #include "main.h"
 #include "dev_i2cm.h"
 #include "ds3231.h"
+#include "ds3231_clock.h"
 #include "usart.h"
 #include "gpio.h"
+#include "dev_prof.h"
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
@@ -46,6 +48,7 @@
 /* Private variables ---------------------------------------------------------*/
 
 /* USER CODE BEGIN PV */
+static DS3231_Clock rtc_clock;
 
 /* USER CODE END PV */
 
@@ -57,6 +60,12 @@ void SystemClock_Config(void);
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
+static DS3231_Status DS3231_Resync(const DS3231_PowerLoss *event, void *ctx)
+{
+    // Sin fuente de hora externa en la demo: 2025-09-25 (jueves=4) 16:05:30
+    return DS3231_SetTime(2025, 9, 25, 4, 16, 5, 30);
+}
+
 static void DS3231_Test(void)
 {
     DS3231_Status st;
@@ -67,8 +76,9 @@ static void DS3231_Test(void)
         Error_Handler();
     }
 
-    // Configuro la fecha y hora inicial -> 2025-09-25 (jueves=4) 16:05:30
-    st = DS3231_SetTime(25, 9, 25, 4, 16, 5, 30);
+    // Si el oscilador se detuvo (OSF), cargo la fecha y hora inicial y limpio el flag.
+    DS3231_SetResyncCallback(DS3231_Resync, NULL);
+    st = DS3231_Supervise();
 
     // Apago y enciendo la salida de 32Khz
     st = DS3231_Enable32KHz(false);
@@ -92,16 +102,37 @@ static void DS3231_Test(void)
     DS3231_GetStatus(&status_reg);
     DS3231_GetControl(&control_reg);
 
-    // Leer hora y temperatura cada 1 s
+    // La EXTI de la SQW se habilita recién con la SQW en 1 Hz: a 4 kHz la ISR
+    // (prioridad 0) se comería la CPU.
+    st = DS3231_SetSQWFreq(DS3231_SQW_1HZ);
+    RTC_SQW_GPIO_Init();
+
+    // Reloj local: una lectura del chip y después avanza con la SQW de 1 Hz.
+    st = DS3231_Clock_Start(&rtc_clock, DS3231_DefaultHandle(), DS3231_CLOCK_CHECK_PERIOD_S);
+    if (st != DS3231_OK) {
+        Error_Handler();
+    }
+
     while (1)
     {
         DS3231_Time now;
-        float temp_c = 0.0f;
 
-        st = DS3231_ReadTime(&now);
+        // Hora sin acceso al bus.
+        st = DS3231_Clock_Now(&rtc_clock, &now);
+
+        // Chequeo contra el chip cada DS3231_CLOCK_CHECK_PERIOD_S.
+        st = DS3231_Clock_Poll(&rtc_clock);
 
-        st = DS3231_GetTemperature(&temp_c);
+        // Resincroniza si alguna lectura de STATUS encontró OSF; sin eventos no usa el bus.
+        st = DS3231_Supervise();
 
+#ifdef DEV_PROF_ENABLE
+        // Vuelco de ciclos por llamada cada 60 s.
+        static uint32_t prof_ticks;
+        if (++prof_ticks % 60 == 0) {
+            PROF_DumpUART();
+        }
+#endif
         HAL_Delay(1000);
     }
 }
@@ -139,9 +170,13 @@ int main(void)
 	MX_USART2_UART_Init();
 	/* USER CODE BEGIN 2 */
 
+#ifdef DEV_PROF_ENABLE
+	PROF_Init();
+#endif
+
 	// Inicialización del I2C master.
 	if (I2CM_I2C1_Init() != HAL_OK) { Error_Handler(); }
-	
+
   DS3231_Test();  
 
 	while (1)
@@ -197,6 +232,12 @@ void SystemClock_Config(void)
 }
 
 /* USER CODE BEGIN 4 */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  if (GPIO_Pin == RTC_SQW_Pin) {
+    DS3231_Clock_OnEdge(&rtc_clock);
+  }
+}
 
 /* USER CODE END 4 */
 
@@ -6,15 +6,30 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../Devices/API/Src/ds3231.c \
-../Devices/API/Src/ds3231_port.c 
+../Devices/API/Src/ds3231_bcd.c \
+../Devices/API/Src/ds3231_cal.c \
+../Devices/API/Src/ds3231_clock.c \
+../Devices/API/Src/ds3231_drift.c \
+../Devices/API/Src/ds3231_port.c \
+../Devices/API/Src/ds3231_slew.c 
 
 OBJS += \
 ./Devices/API/Src/ds3231.o \
-./Devices/API/Src/ds3231_port.o 
+./Devices/API/Src/ds3231_bcd.o \
+./Devices/API/Src/ds3231_cal.o \
+./Devices/API/Src/ds3231_clock.o \
+./Devices/API/Src/ds3231_drift.o \
+./Devices/API/Src/ds3231_port.o \
+./Devices/API/Src/ds3231_slew.o 
 
 C_DEPS += \
 ./Devices/API/Src/ds3231.d \
-./Devices/API/Src/ds3231_port.d 
+./Devices/API/Src/ds3231_bcd.d \
+./Devices/API/Src/ds3231_cal.d \
+./Devices/API/Src/ds3231_clock.d \
+./Devices/API/Src/ds3231_drift.d \
+./Devices/API/Src/ds3231_port.d \
+./Devices/API/Src/ds3231_slew.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -24,7 +39,7 @@ Devices/API/Src/%.o Devices/API/Src/%.su Devices/API/Src/%.cyclo: ../Devices/API
 clean: clean-Devices-2f-API-2f-Src
 
 clean-Devices-2f-API-2f-Src:
-	-$(RM) ./Devices/API/Src/ds3231.cyclo ./Devices/API/Src/ds3231.d ./Devices/API/Src/ds3231.o ./Devices/API/Src/ds3231.su ./Devices/API/Src/ds3231_port.cyclo ./Devices/API/Src/ds3231_port.d ./Devices/API/Src/ds3231_port.o ./Devices/API/Src/ds3231_port.su
+	-$(RM) ./Devices/API/Src/ds3231.cyclo ./Devices/API/Src/ds3231.d ./Devices/API/Src/ds3231.o ./Devices/API/Src/ds3231.su ./Devices/API/Src/ds3231_bcd.cyclo ./Devices/API/Src/ds3231_bcd.d ./Devices/API/Src/ds3231_bcd.o ./Devices/API/Src/ds3231_bcd.su ./Devices/API/Src/ds3231_cal.cyclo ./Devices/API/Src/ds3231_cal.d ./Devices/API/Src/ds3231_cal.o ./Devices/API/Src/ds3231_cal.su ./Devices/API/Src/ds3231_clock.cyclo ./Devices/API/Src/ds3231_clock.d ./Devices/API/Src/ds3231_clock.o ./Devices/API/Src/ds3231_clock.su ./Devices/API/Src/ds3231_drift.cyclo ./Devices/API/Src/ds3231_drift.d ./Devices/API/Src/ds3231_drift.o ./Devices/API/Src/ds3231_drift.su ./Devices/API/Src/ds3231_port.cyclo ./Devices/API/Src/ds3231_port.d ./Devices/API/Src/ds3231_port.o ./Devices/API/Src/ds3231_port.su ./Devices/API/Src/ds3231_slew.cyclo ./Devices/API/Src/ds3231_slew.d ./Devices/API/Src/ds3231_slew.o ./Devices/API/Src/ds3231_slew.su
 
 .PHONY: clean-Devices-2f-API-2f-Src
 
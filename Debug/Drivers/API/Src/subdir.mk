@@ -5,13 +5,19 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
-../Drivers/API/Src/dev_i2cm.c 
+../Drivers/API/Src/dev_i2cm.c \
+../Drivers/API/Src/dev_i2cm_ll.c \
+../Drivers/API/Src/dev_prof.c 
 
 OBJS += \
-./Drivers/API/Src/dev_i2cm.o 
+./Drivers/API/Src/dev_i2cm.o \
+./Drivers/API/Src/dev_i2cm_ll.o \
+./Drivers/API/Src/dev_prof.o 
 
 C_DEPS += \
-./Drivers/API/Src/dev_i2cm.d 
+./Drivers/API/Src/dev_i2cm.d \
+./Drivers/API/Src/dev_i2cm_ll.d \
+./Drivers/API/Src/dev_prof.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -21,7 +27,7 @@ Drivers/API/Src/%.o Drivers/API/Src/%.su Drivers/API/Src/%.cyclo: ../Drivers/API
 clean: clean-Drivers-2f-API-2f-Src
 
 clean-Drivers-2f-API-2f-Src:
-	-$(RM) ./Drivers/API/Src/dev_i2cm.cyclo ./Drivers/API/Src/dev_i2cm.d ./Drivers/API/Src/dev_i2cm.o ./Drivers/API/Src/dev_i2cm.su
+	-$(RM) ./Drivers/API/Src/dev_i2cm.cyclo ./Drivers/API/Src/dev_i2cm.d ./Drivers/API/Src/dev_i2cm.o ./Drivers/API/Src/dev_i2cm.su ./Drivers/API/Src/dev_i2cm_ll.cyclo ./Drivers/API/Src/dev_i2cm_ll.d ./Drivers/API/Src/dev_i2cm_ll.o ./Drivers/API/Src/dev_i2cm_ll.su ./Drivers/API/Src/dev_prof.cyclo ./Drivers/API/Src/dev_prof.d ./Drivers/API/Src/dev_prof.o ./Drivers/API/Src/dev_prof.su
 
 .PHONY: clean-Drivers-2f-API-2f-Src
 
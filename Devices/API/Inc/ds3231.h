@@ -3,6 +3,16 @@
  * @brief   Driver del RTC DS3231 utilizando dev_i2cm.
  * @details
  *  API utilizada para leer y escribir registros del RTC DS3231.
+ *
+ *  Cada función DS3231_X tiene una variante DS3231_Dev_X que recibe un
+ *  DS3231_Handle (transporte, bus, dirección, cache y buffers propios), para
+ *  operar varios chips sin estado global. DS3231_X opera sobre la instancia
+ *  por defecto (DS3231_DefaultHandle).
+ *
+ *  La temperatura está disponible en cuartos de grado (int16_t, sin float).
+ *  Con DS3231_NO_FLOAT definido el driver no usa float en ningún camino:
+ *  DS3231_GetTemperature() desaparece y los callbacks y el snapshot entregan
+ *  cuartos de grado (DS3231_Temp = int16_t).
  */
 
 #ifndef DS3231_H
@@ -30,19 +40,267 @@ typedef enum {
     DS3231_BUSY             = -5, // HAL Busy
 } DS3231_Status;
 
+/**
+ * @brief Temperatura que entregan los callbacks: °C en float, o cuartos de
+ *        grado con DS3231_NO_FLOAT.
+ *
+ * Los callbacks de lecturas asíncronas corren en la ISR de I2C. Con float, si
+ * el código interrumpido usaba la FPU, la conversión es la primera instrucción
+ * de FPU de la ISR y dispara el apilado diferido (lazy stacking) de S0..S15 y
+ * FPSCR: 17 palabras guardadas y restauradas, unos 35 ciclos más por
+ * interrupción en el Cortex-M4.
+ */
+#ifdef DS3231_NO_FLOAT
+typedef int16_t DS3231_Temp;
+#else
+typedef float   DS3231_Temp;
+#endif
+
 /**
  * @brief Estructura de tiempo.
  */
 typedef struct {
     uint8_t seconds; /**< 0x00: segundos */
     uint8_t minutes; /**< 0x01: minutos  */
-    uint8_t hours;   /**< 0x02: horas    */
+    uint8_t hours;   /**< 0x02: horas (0..23, también si el chip está en 12 h) */
     uint8_t day;     /**< 0x03: día de semana */
     uint8_t date;    /**< 0x04: día del mes */
-    uint8_t month;   /**< 0x05: mes, bit7=Century */
-    uint8_t year;    /**< 0x06: año (00..99) */
+    uint8_t month;   /**< 0x05: mes (1..12) */
+    uint16_t year;   /**< 0x06 + bit de siglo de 0x05: año completo (2000..2199) */
 } DS3231_Time;
 
+#define DS3231_YEAR_MIN    (2000U)          /**< Año con siglo = 0 y registro de año = 00. */
+#define DS3231_YEAR_MAX    (2199U)          /**< Año con siglo = 1 y registro de año = 99. */
+
+#define DS3231_EPOCH_MIN   (946684800LL)    /**< 2000-01-01 00:00:00 UTC */
+#define DS3231_EPOCH_MAX   (7258118399LL)   /**< 2199-12-31 23:59:59 UTC */
+
+/** Del START al ACK de los segundos en una escritura de hora: START y 3 bytes
+ *  (dirección, puntero, segundos) a DS3231_I2C_SPEED_HZ, en ns. */
+#define DS3231_ALIGN_LEAD_NS  ((uint32_t)((1U + 3U * 9U) * 1000000000ULL / DS3231_I2C_SPEED_HZ))
+
+/** Mayor offset de una escritura alineada, en ns: acota la espera activa de
+ *  la ISR del flanco (peor latencia de la ISR más un margen de 2 ms). */
+#define DS3231_ALIGN_MAX_OFFSET_NS  (2000000U)
+
+/**
+ * @brief Configuración de una alarma (Alarma 1: 0x07..0x0A, Alarma 2: 0x0B..0x0D).
+ */
+typedef struct {
+    uint8_t seconds;  /**< Segundos (solo Alarma 1). */
+    uint8_t minutes;  /**< Minutos. */
+    uint8_t hours;    /**< Horas. */
+    uint8_t day_date; /**< Día de semana (1..7) si dy = true, día del mes (1..31) si no. */
+    bool    dy;       /**< true: compara contra el día de semana. */
+    uint8_t mask;     /**< Bits AxM1..AxM4 (bit0 = AxM1). */
+} DS3231_Alarm;
+
+/**
+ * @brief Alarma del DS3231.
+ */
+typedef enum {
+    DS3231_ALARM_1 = 1,     /**< Alarma 1 (0x07..0x0A), con segundos. */
+    DS3231_ALARM_2 = 2,     /**< Alarma 2 (0x0B..0x0D), evalúa con segundos = 00. */
+} DS3231_AlarmId;
+
+/**
+ * @brief Modos de la Alarma 1 (valor de DS3231_Alarm.mask).
+ */
+typedef enum {
+    DS3231_ALARM1_EVERY_SECOND = 0x0F,  /**< Una vez por segundo. */
+    DS3231_ALARM1_MATCH_S      = 0x0E,  /**< Coinciden los segundos. */
+    DS3231_ALARM1_MATCH_MS     = 0x0C,  /**< Coinciden minutos y segundos. */
+    DS3231_ALARM1_MATCH_HMS    = 0x08,  /**< Coinciden horas, minutos y segundos. */
+    DS3231_ALARM1_MATCH_DHMS   = 0x00,  /**< Además coincide día de semana o fecha (según dy). */
+} DS3231_Alarm1Mode;
+
+/**
+ * @brief Modos de la Alarma 2 (valor de DS3231_Alarm.mask).
+ */
+typedef enum {
+    DS3231_ALARM2_EVERY_MINUTE = 0x0E,  /**< Una vez por minuto (segundos = 00). */
+    DS3231_ALARM2_MATCH_M      = 0x0C,  /**< Coinciden los minutos. */
+    DS3231_ALARM2_MATCH_HM     = 0x08,  /**< Coinciden horas y minutos. */
+    DS3231_ALARM2_MATCH_DHM    = 0x00,  /**< Además coincide día de semana o fecha (según dy). */
+} DS3231_Alarm2Mode;
+
+/**
+ * @brief Formato del registro de horas (bit 6 de 0x02).
+ */
+typedef enum {
+    DS3231_HOURS_24 = 0,    /**< 0..23 */
+    DS3231_HOURS_12 = 1,    /**< 1..12 con bit AM/PM */
+} DS3231_HourMode;
+
+/**
+ * @brief Contenido decodificado del mapa completo de registros (0x00..0x12).
+ */
+typedef struct {
+    DS3231_Time  time;        /**< 0x00..0x06 */
+    DS3231_Alarm alarm1;      /**< 0x07..0x0A */
+    DS3231_Alarm alarm2;      /**< 0x0B..0x0D (seconds = 0, mask bit0 sin uso) */
+    uint8_t      control;     /**< 0x0E */
+    uint8_t      status;      /**< 0x0F */
+    int8_t       aging;       /**< 0x10 */
+    int16_t      temperature_q4; /**< 0x11..0x12, en cuartos de grado */
+#ifndef DS3231_NO_FLOAT
+    float        temperature; /**< 0x11..0x12, en °C */
+#endif
+} DS3231_Snapshot;
+
+/**
+ * @brief Callback de DS3231_ReadTimeAsync.
+ * @param status DS3231_OK si la lectura fue exitosa.
+ * @param time   Hora leída (válida solo durante el callback).
+ * @param ctx    Contexto de usuario.
+ */
+typedef void (*DS3231_TimeCallback)(DS3231_Status status, const DS3231_Time *time, void *ctx);
+
+/**
+ * @brief Callback de DS3231_GetTemperatureAsync.
+ * @param status DS3231_OK si la lectura fue exitosa.
+ * @param temp   Temperatura (ver DS3231_Temp).
+ * @param ctx    Contexto de usuario.
+ */
+typedef void (*DS3231_TempCallback)(DS3231_Status status, DS3231_Temp temp, void *ctx);
+
+/**
+ * @brief Callback de finalización de DS3231_SnapshotDMA_Start.
+ * @param status DS3231_OK si el nuevo snapshot quedó publicado.
+ * @param ctx    Contexto de usuario.
+ */
+typedef void (*DS3231_SnapshotCallback)(DS3231_Status status, void *ctx);
+
+/**
+ * @brief Pérdida de alimentación detectada (OSF en 1). Una hora con year = 0
+ *        es desconocida.
+ */
+typedef struct {
+    DS3231_Time last_good;  /**< Última hora leída en un snapshot con OSF = 0. */
+    DS3231_Time detected;   /**< Hora del chip al detectar OSF; no confiable (tras un corte sin batería cuenta desde 2000-01-01). */
+    uint32_t    count;      /**< Eventos desde DS3231_HandleInit. */
+} DS3231_PowerLoss;
+
+/**
+ * @brief Callback de resincronización tras una pérdida de alimentación.
+ *
+ * Debe escribir la hora desde una fuente confiable (GPS, NTP, RTC del MCU)
+ * y retornar DS3231_OK; cualquier otro valor deja la hora como no válida y
+ * se vuelve a llamar en el próximo DS3231_Supervise().
+ *
+ * @param event Evento en curso.
+ * @param ctx   Contexto de usuario.
+ * @return DS3231_OK si la hora quedó escrita.
+ */
+typedef DS3231_Status (*DS3231_ResyncCallback)(const DS3231_PowerLoss *event, void *ctx);
+
+/**
+ * @brief Contador libre de 32 bits que temporiza la escritura alineada
+ *        (p.ej. DWT->CYCCNT o un timer que también captura el flanco).
+ */
+typedef uint32_t (*DS3231_TickSource)(void);
+
+/**
+ * @brief Resultado de una escritura alineada (DS3231_SetTimeAligned).
+ */
+typedef struct {
+    DS3231_Status status;       /**< Resultado de la escritura. */
+    int32_t       phase_ns;     /**< Reinicio de la cadena de cuenta menos el flanco (positivo = el chip atrasa; 0 si llegó tarde). */
+    uint32_t      latency_ticks;/**< Desde el flanco hasta la entrada a DS3231_SetTimeAligned_OnEdge. */
+    bool          late;         /**< La ISR llegó después del instante programado y no escribió. */
+} DS3231_AlignedResult;
+
+/* -------------------------------------------------------------------------- */
+/* INSTANCIAS                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/** Ningún buffer tomado por el lector (DS3231_SnapshotDMA.held). */
+#define DS3231_SNAP_NONE   (0xFF)
+
+/**
+ * @brief Cache espejo de CONTROL, STATUS y AGING (uso interno).
+ */
+typedef struct {
+    uint8_t control;    /**< Sin DS3231_CTRL_CONV. */
+    uint8_t status;     /**< Solo bits no volátiles (EN32KHZ). */
+    uint8_t aging;
+    uint8_t valid;      /**< Registros válidos (máscara interna). */
+} DS3231_Shadow;
+
+/**
+ * @brief Contexto de una lectura asíncrona (uso interno).
+ */
+typedef struct {
+    uint8_t buf[DS3231_MAX_BLOCK_READ];
+    union {
+        DS3231_TimeCallback time;
+        DS3231_TempCallback temp;
+    } cb;
+    void *ctx;
+} DS3231_AsyncCtx;
+
+/**
+ * @brief Conversión de temperatura forzada en curso (uso interno).
+ */
+typedef struct {
+    DS3231_TempCallback cb;
+    void    *ctx;
+    uint32_t start_ms;  /**< Tick en que se escribió CONV. */
+    uint32_t next_ms;   /**< Próximo tick en que se consulta el chip. */
+    bool     active;
+} DS3231_Conversion;
+
+/**
+ * @brief Supervisión de OSF (uso interno).
+ */
+typedef struct {
+    volatile uint8_t      state;    /**< Hora desconocida, válida o no válida (ver ds3231.c). */
+    bool                  resync;   /**< Evento pendiente de resincronizar. */
+    DS3231_Time           last_good;
+    DS3231_PowerLoss      event;
+    DS3231_ResyncCallback cb;
+    void                 *ctx;
+} DS3231_Supervisor;
+
+/**
+ * @brief Escritura de hora alineada a un flanco (uso interno).
+ */
+typedef struct {
+    uint8_t              buf[DS3231_MAX_BLOCK_WRITE];   /**< Puntero y 0x00..0x06 en BCD, preparados al armar. */
+    volatile uint8_t     state;         /**< Inactiva, armada o terminada (ver ds3231.c). */
+    DS3231_TickSource    ticks;
+    uint32_t             ticks_hz;
+    uint32_t             fire_ticks;    /**< Desde el flanco hasta el START. */
+    DS3231_AlignedResult result;
+} DS3231_AlignedWrite;
+
+/**
+ * @brief Doble buffer del snapshot por DMA (uso interno).
+ */
+typedef struct {
+    uint8_t regs[2][DS3231_REG_MAP_SIZE];
+    volatile uint8_t  front;    /**< Buffer con el último snapshot completo. */
+    volatile uint8_t  held;     /**< Buffer tomado por el lector, o DS3231_SNAP_NONE. */
+    volatile uint32_t seq;      /**< Cantidad de snapshots publicados. */
+    DS3231_SnapshotCallback cb;
+    void *ctx;
+} DS3231_SnapshotDMA;
+
+/**
+ * @brief Instancia de un DS3231. Se inicializa con DS3231_HandleInit.
+ */
+typedef struct {
+    const DS3231_Port  *port;       /**< Puerto en uso (port_cfg, o el por defecto). */
+    DS3231_Port         port_cfg;   /**< Transporte, bus y dirección propios. */
+    DS3231_Shadow       shadow;     /**< Cache de CONTROL/STATUS/AGING. */
+    DS3231_AsyncCtx     async;      /**< Lectura asíncrona en curso. */
+    DS3231_SnapshotDMA  snap;       /**< Snapshot por DMA. */
+    uint8_t             hour_mode;  /**< DS3231_HourMode con que se escriben las horas. */
+    DS3231_Conversion   conv;       /**< Conversión de temperatura forzada. */
+    DS3231_Supervisor   sup;        /**< Supervisión de OSF. */
+    DS3231_AlignedWrite aligned;    /**< Escritura de hora alineada. */
+} DS3231_Handle;
+
 /** @name Helpers BCD
  *  @brief Estas funciones convierten números entre decimal normal y BCD (Binary Coded Decimal), que es el formato que usa el DS3231 para guardar hora y fecha.
  * 
@@ -62,6 +320,14 @@ static inline uint8_t bcd2dec(uint8_t value) {
     return (uint8_t)(((value >> 4) * 10) + (value & 0x0F)); 
 }
 
+/**
+ * @brief Registros 0x11 (entero con signo) y 0x12 (bits 7..6, pasos de 0.25 °C)
+ *        a cuartos de grado: -512..511 (-128.00..127.75 °C).
+ */
+static inline int16_t DS3231_temp_q4(uint8_t msb, uint8_t lsb) {
+    return (int16_t)((int16_t)(int8_t)msb * 4 + (lsb >> 6));
+}
+
 /**
  * @brief Verifica la presencia del DS3231 en el bus de I2C.
  * @param  void.
@@ -71,6 +337,11 @@ DS3231_Status DS3231_Init(void);
 
 /**
  * @brief  Lee la hora actual desde el DS3231.
+ *
+ * El año se arma con el bit de siglo (bit 7 del mes), que el chip invierte
+ * al pasar de 99 a 00: 2099 -> 2100 sin intervención del firmware. Las horas
+ * se devuelven en 24 h aunque el chip esté en 12 h.
+ *
  * @param  time  Estructura Time.
  * @return DS3231_OK si funciono correctamente.
  */
@@ -79,7 +350,11 @@ DS3231_Status DS3231_ReadTime(DS3231_Time *time);
 
 /**
  * @brief  Configura la fecha y hora del RTC.
- * @param  yy   Año (00-99)
+ * Las horas se escriben en el formato del chip visto por última vez
+ * (DS3231_ReadTime, DS3231_ReadSnapshot, DS3231_GetHourMode o
+ * DS3231_SetHourMode); después de DS3231_Init, en 24 h.
+ *
+ * @param  yy   Año completo (2000-2199); 2100..2199 escribe el bit de siglo
  * @param  mm   Mes (1-12)
  * @param  dd   Día del mes (1-31)
  * @param  dow  Día de semana (1-7)
@@ -88,9 +363,103 @@ DS3231_Status DS3231_ReadTime(DS3231_Time *time);
  * @param  ss   Segundos (0-59)
  * @return DS3231_OK si funciono correctamente.
  */
-DS3231_Status DS3231_SetTime(uint8_t year, uint8_t month, uint8_t date,
+DS3231_Status DS3231_SetTime(uint16_t year, uint8_t month, uint8_t date,
                                     uint8_t day, uint8_t hour, uint8_t min, uint8_t sec);
 
+/* -------------------------------------------------------------------------- */
+/* ESCRITURA DE HORA ALINEADA A UN FLANCO                                      */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief Prepara una escritura de hora que se dispara en el próximo flanco de referencia.
+ *
+ * El chip reinicia su cadena de cuenta al escribir los segundos, así que con
+ * DS3231_SetTime el segundo del chip empieza donde cayó la escritura (hasta
+ * 1 s de error de fase). Acá el bloque BCD se arma en el lazo principal y la
+ * ISR del flanco (PPS de un GPS, SQW de otro RTC, un timer) solo espera el
+ * instante programado y lo escribe: el ACK del byte de segundos cae a
+ * offset_ns del flanco, más la latencia que no se pudo absorber.
+ *
+ * La escritura empieza offset_ns - DS3231_ALIGN_LEAD_NS después del flanco.
+ * Si la ISR entra después de ese instante no escribe y el resultado es
+ * DS3231_TIMEOUT con late activo: el offset tiene que superar la peor
+ * latencia de la ISR más DS3231_ALIGN_LEAD_NS. Con eso la fase es
+ * determinística y el error residual queda en el resultado
+ * (DS3231_SetTimeAligned_Result) para corregirlo por otra vía.
+ *
+ * @param time      Hora del segundo que empieza en el flanco (horas en 24 h;
+ *                  se escriben en el formato del chip, como DS3231_SetTime).
+ * @param offset_ns Del flanco al ACK de los segundos (hasta DS3231_ALIGN_MAX_OFFSET_NS).
+ * @param ticks     Contador del que sale el valor capturado en el flanco.
+ * @param ticks_hz  Frecuencia del contador.
+ * @return DS3231_OK si quedó armada (reemplaza a una armada antes);
+ *         DS3231_INVALID_PARAM con offset_ns mayor que DS3231_ALIGN_MAX_OFFSET_NS.
+ */
+DS3231_Status DS3231_SetTimeAligned(const DS3231_Time *time, uint32_t offset_ns,
+                                    DS3231_TickSource ticks, uint32_t ticks_hz);
+
+/**
+ * @brief Dispara la escritura armada. Llamar desde la ISR del flanco de referencia.
+ *
+ * Espera activamente hasta el instante programado (a lo sumo
+ * DS3231_ALIGN_MAX_OFFSET_NS) y escribe los 7 registros en una transacción
+ * bloqueante: la EXTI tiene que poder ser interrumpida por el SysTick
+ * (timeouts de HAL), es decir, prioridad de preempción numéricamente mayor
+ * que TICK_INT_PRIORITY. Si el flanco interrumpe otra transferencia del
+ * bus, asíncrona o bloqueante, no escribe y el resultado es DS3231_BUSY. Sin
+ * escritura armada no hace nada.
+ *
+ * @param edge_ticks Valor del contador capturado en el flanco.
+ */
+void DS3231_SetTimeAligned_OnEdge(uint32_t edge_ticks);
+
+/**
+ * @brief Resultado de la última escritura alineada. No accede al bus.
+ *
+ * @param result Estructura de salida.
+ * @return DS3231_OK si la escritura terminó (su estado está en result->status);
+ *         DS3231_BUSY si sigue armada; DS3231_NOT_READY si no hubo ninguna.
+ */
+DS3231_Status DS3231_SetTimeAligned_Result(DS3231_AlignedResult *result);
+
+/* -------------------------------------------------------------------------- */
+/* AJUSTE DE HORA POR DIFERENCIA                                               */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief Suma @p delta_s a la hora del chip escribiendo solo los registros que cambian.
+ *
+ * Lee 0x00..0x06, aplica el delta con todos los acarreos (minutos, horas,
+ * fecha, mes, año y siglo) y escribe en una transacción, con el
+ * auto-incremento del puntero, el tramo contiguo de registros que difiere.
+ * Ajustar una hora escribe 1 registro en lugar de 7. El día de semana avanza
+ * con los días transcurridos, en la convención que use el chip. Los acarreos
+ * siguen el calendario del chip (2100 es bisiesto), no el gregoriano de
+ * DS3231_TimeToEpoch.
+ *
+ * Un tramo que incluye los segundos reinicia la cadena de cuenta: el segundo
+ * del chip empieza en la escritura y se pierde la fracción transcurrida.
+ * Conviene llamarla justo después del flanco de la SQW; para correcciones
+ * menores a un segundo, ds3231_slew las aplica con AGING sin saltos.
+ *
+ * @param delta_s Segundos a sumar (negativo: atrasar).
+ * @return DS3231_OK si se escribió o no había nada que cambiar;
+ *         DS3231_BUSY si el chip está en :59 (el flanco podría acarrear durante
+ *         la escritura, reintentar después del próximo segundo);
+ *         DS3231_INVALID_PARAM si la hora leída no es válida o el resultado
+ *         queda fuera de 2000..2199.
+ */
+DS3231_Status DS3231_AdjustTime(int32_t delta_s);
+
+/**
+ * @brief Obtiene la temperatura interna del DS3231 sin usar float.
+ *
+ * @param temp_q4 Temperatura en cuartos de grado (p.ej. 101 = 25.25 °C).
+ * @return DS3231_OK si funciono correctamente.
+ */
+DS3231_Status DS3231_GetTemperatureQ4(int16_t *temp_q4);
+
+#ifndef DS3231_NO_FLOAT
  /**
  * @brief Obtiene la temperatura interna del DS3231.
  *
@@ -98,8 +467,180 @@ DS3231_Status DS3231_SetTime(uint8_t year, uint8_t month, uint8_t date,
  * @return DS3231_OK si funciono correctamente.
  */
 DS3231_Status DS3231_GetTemperature(float *temp);
+#endif
+
+/* -------------------------------------------------------------------------- */
+/* CONVERSIÓN DE TEMPERATURA FORZADA                                           */
+/* -------------------------------------------------------------------------- */
+
+#define DS3231_CONV_TIME_MS      (200U)  /**< Duración máxima de una conversión (tCONV). */
+#define DS3231_CONV_POLL_MS      (10U)   /**< Intervalo entre consultas una vez vencido tCONV. */
+#define DS3231_CONV_TIMEOUT_MS   (500U)  /**< Sin CONV = 0 en este tiempo: DS3231_TIMEOUT. */
+
+/**
+ * @brief Fuerza una conversión de temperatura sin esperar a que termine.
+ *
+ * Lee CONTROL..AGING (también refresca la cache) y, si no hay conversión en
+ * curso (CONV = 0 y BSY = 0), escribe CONV. El resultado lo entrega
+ * DS3231_ConvertTemperaturePoll() por @p cb cuando el chip baja CONV.
+ *
+ * @param cb     Callback con el resultado.
+ * @param ctx    Contexto de usuario.
+ * @param now_ms Tick actual en ms (p.ej. HAL_GetTick()).
+ * @return DS3231_OK si la conversión quedó iniciada; DS3231_BUSY si ya hay
+ *         una en curso (forzada o la automática de cada 64 s).
+ */
+DS3231_Status DS3231_ConvertTemperatureAsync(DS3231_TempCallback cb, void *ctx, uint32_t now_ms);
+
+/**
+ * @brief Avanza la conversión forzada; llamar desde el lazo principal.
+ *
+ * No accede al bus hasta que pasa DS3231_CONV_TIME_MS desde el inicio; a
+ * partir de ahí, una lectura de CONTROL..TEMP cada DS3231_CONV_POLL_MS. Al
+ * terminar llama al callback (DS3231_OK con la temperatura nueva,
+ * DS3231_TIMEOUT o DS3231_ERROR) desde este mismo contexto; el callback puede
+ * iniciar otra conversión.
+ *
+ * @param now_ms Tick actual en ms.
+ * @return DS3231_OK si no hay conversión o terminó en esta llamada;
+ *         DS3231_BUSY si sigue en curso.
+ */
+DS3231_Status DS3231_ConvertTemperaturePoll(uint32_t now_ms);
+
+/* -------------------------------------------------------------------------- */
+/* FORMATO 12/24 H                                                             */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief Cambia el formato del registro de horas conservando la hora.
+ *
+ * Lee segundos..horas y reescribe solo el registro de horas (no reinicia la
+ * cadena de división del oscilador). Si ya está en @p mode no escribe. Las
+ * alarmas ya programadas conservan su formato: volver a escribirlas con
+ * DS3231_SetAlarm para que queden en el nuevo.
+ *
+ * @param mode DS3231_HOURS_24 o DS3231_HOURS_12.
+ * @return DS3231_OK si funciono correctamente; DS3231_BUSY si la hora está
+ *         por cambiar (mm:ss = 59:59), para no escribir una hora vieja.
+ */
+DS3231_Status DS3231_SetHourMode(DS3231_HourMode mode);
+
+/**
+ * @brief Lee el formato del registro de horas.
+ *
+ * @param mode Formato actual del chip.
+ * @return DS3231_OK si funciono correctamente.
+ */
+DS3231_Status DS3231_GetHourMode(DS3231_HourMode *mode);
+
+/* -------------------------------------------------------------------------- */
+/* LECTURA DEL MAPA COMPLETO                                                   */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Lee los 19 registros (0x00..0x12) en una sola transacción I2C.
+ *
+ * Reemplaza a ReadTime + GetTemperature + GetStatus + GetControl + GetAging
+ * (cinco transacciones) cuando se necesita más de un dato.
+ *
+ * @param snap Estructura de salida.
+ * @return DS3231_OK si funciono correctamente.
+ */
+DS3231_Status DS3231_ReadSnapshot(DS3231_Snapshot *snap);
+
+/**
+ * @brief  Decodifica un buffer crudo de DS3231_REG_MAP_SIZE bytes.
+ *
+ * Sirve tanto para DS3231_ReadSnapshot como para los buffers entregados por
+ * DS3231_SnapshotDMA_Acquire.
+ *
+ * @param regs Registros 0x00..0x12.
+ * @param snap Estructura de salida.
+ * @return DS3231_OK si funciono correctamente.
+ */
+DS3231_Status DS3231_DecodeSnapshot(const uint8_t *regs, DS3231_Snapshot *snap);
+
+/* -------------------------------------------------------------------------- */
+/* LECTURAS ASINCRONICAS                                                       */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Inicia la lectura de la hora sin bloquear.
+ *
+ * Retorna apenas se inicia la transferencia; el resultado se entrega en
+ * @p cb desde la interrupción de I2C1.
+ *
+ * @param cb  Callback de finalización (obligatorio).
+ * @param ctx Contexto de usuario para el callback.
+ * @return DS3231_OK si la lectura se inició, DS3231_BUSY si hay otra en curso.
+ */
+DS3231_Status DS3231_ReadTimeAsync(DS3231_TimeCallback cb, void *ctx);
+
+/**
+ * @brief  Inicia la lectura de la temperatura sin bloquear.
+ *
+ * @param cb  Callback de finalización (obligatorio).
+ * @param ctx Contexto de usuario para el callback.
+ * @return DS3231_OK si la lectura se inició, DS3231_BUSY si hay otra en curso.
+ */
+DS3231_Status DS3231_GetTemperatureAsync(DS3231_TempCallback cb, void *ctx);
+
+/* -------------------------------------------------------------------------- */
+/* SNAPSHOT DE REGISTROS POR DMA (DOBLE BUFFER)                                */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Inicia la lectura por DMA del mapa completo (0x00..0x12).
+ *
+ * El DMA escribe en el buffer trasero; al finalizar, los buffers se
+ * intercambian y el nuevo snapshot queda como frontal, sin copias.
+ *
+ * @param cb  Callback de finalización (puede ser NULL).
+ * @param ctx Contexto de usuario para el callback.
+ * @return DS3231_OK si la lectura se inició, DS3231_BUSY si el bus está
+ *         ocupado o el buffer trasero todavía está tomado por el lector.
+ */
+DS3231_Status DS3231_SnapshotDMA_Start(DS3231_SnapshotCallback cb, void *ctx);
+
+/**
+ * @brief  Toma el último snapshot completo para decodificarlo.
+ *
+ * Mientras esté tomado, el DMA no lo sobrescribe. Debe liberarse con
+ * DS3231_SnapshotDMA_Release().
+ *
+ * @param seq Número de secuencia del snapshot (puede ser NULL).
+ * @return Puntero a DS3231_REG_MAP_SIZE bytes, o NULL si aún no hay snapshot.
+ */
+const uint8_t *DS3231_SnapshotDMA_Acquire(uint32_t *seq);
+
+/**
+ * @brief  Libera el snapshot tomado con DS3231_SnapshotDMA_Acquire().
+ */
+void DS3231_SnapshotDMA_Release(void);
 
 
+/* -------------------------------------------------------------------------- */
+/* CACHE DE REGISTROS CONTROL / STATUS / AGING                                 */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief Descarta la cache espejo de CONTROL, STATUS y AGING.
+ *
+ * Usar si otro maestro del bus pudo haber modificado esos registros. El
+ * próximo acceso los vuelve a leer del chip.
+ */
+void DS3231_CacheInvalidate(void);
+
+/**
+ * @brief Recarga la cache leyendo 0x0E..0x10 en una sola transacción.
+ *
+ * Los bits volátiles (DS3231_STATUS_VOLATILE y DS3231_CTRL_CONV) no se
+ * cachean; DS3231_GetStatus siempre los lee del chip.
+ *
+ * @return DS3231_OK si funciono correctamente.
+ */
+DS3231_Status DS3231_CacheRefresh(void);
+
 /* -------------------------------------------------------------------------- */
 /* CONTROL DE REGISTRO STATUS                                                  */
 /* -------------------------------------------------------------------------- */
@@ -120,6 +661,53 @@ DS3231_Status DS3231_GetStatus(uint8_t *status);
  */
 DS3231_Status DS3231_ClearStatus(uint8_t mask);
 
+/* -------------------------------------------------------------------------- */
+/* SUPERVISION DE OSF                                                          */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief Fija el callback que resincroniza la hora tras una pérdida de alimentación.
+ *
+ * @param cb  Callback (NULL: la aplicación resincroniza por su cuenta y
+ *            limpia OSF con DS3231_ClearStatus).
+ * @param ctx Contexto de usuario.
+ */
+void DS3231_SetResyncCallback(DS3231_ResyncCallback cb, void *ctx);
+
+/**
+ * @brief Supervisa OSF; llamar al arrancar y desde el lazo principal.
+ *
+ * La primera llamada después de DS3231_Init lee 0x00..0x10 en una
+ * transacción (también carga la cache). Después no accede al bus: OSF se
+ * vigila en cada lectura que incluye STATUS (DS3231_ReadSnapshot, el
+ * snapshot por DMA, DS3231_GetStatus, DS3231_AckAlarms, DS3231_CacheRefresh
+ * y la conversión forzada). Al ver OSF en 1 la hora pasa a no válida y se
+ * registra un DS3231_PowerLoss; la siguiente llamada ejecuta el callback de
+ * resincronización y, si tuvo éxito, limpia OSF con una sola escritura.
+ *
+ * @return DS3231_OK si la hora es válida o no hay nada que hacer; el estado
+ *         del callback o del bus en otro caso.
+ */
+DS3231_Status DS3231_Supervise(void);
+
+/**
+ * @brief Indica si la hora del chip es confiable. No accede al bus.
+ *
+ * Limpiar OSF con DS3231_ClearStatus equivale a declarar válida la hora.
+ *
+ * @return true si se verificó OSF = 0 desde DS3231_Init y no hubo pérdida de
+ *         alimentación sin resolver.
+ */
+bool DS3231_TimeValid(void);
+
+/**
+ * @brief Copia el último evento de pérdida de alimentación. No accede al bus.
+ *
+ * @param event Estructura de salida.
+ * @return DS3231_OK; DS3231_NOT_READY si no hubo ninguno.
+ */
+DS3231_Status DS3231_GetPowerLoss(DS3231_PowerLoss *event);
+
 /* -------------------------------------------------------------------------- */
 /* CONTROL DE REGISTRO CONTROL                                                 */
 /* -------------------------------------------------------------------------- */
@@ -198,11 +786,163 @@ DS3231_Status DS3231_SetAging(int8_t offset);
  */
 DS3231_Status DS3231_GetAging(int8_t *offset);
 
+/* -------------------------------------------------------------------------- */
+/* ALARMAS                                                                     */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief Programa una alarma con una sola escritura en ráfaga.
+ *
+ * @param id    DS3231_ALARM_1 o DS3231_ALARM_2.
+ * @param alarm Campos y modo (DS3231_Alarm1Mode / DS3231_Alarm2Mode en mask).
+ *              Solo se validan los campos que el modo compara.
+ * @return DS3231_OK si funciono correctamente.
+ */
+DS3231_Status DS3231_SetAlarm(DS3231_AlarmId id, const DS3231_Alarm *alarm);
+
+/**
+ * @brief Lee la configuración de una alarma en una sola transacción.
+ *
+ * @param id    DS3231_ALARM_1 o DS3231_ALARM_2.
+ * @param alarm Estructura de salida.
+ * @return DS3231_OK si funciono correctamente.
+ */
+DS3231_Status DS3231_GetAlarm(DS3231_AlarmId id, DS3231_Alarm *alarm);
+
+/**
+ * @brief Programa una alarma, limpia su flag y habilita su interrupción (INTCN = 1).
+ *
+ * Alarma 2: una única ráfaga 0x0B..0x0F. Alarma 1: dos ráfagas (0x07..0x0A
+ * y 0x0E..0x0F), ya que la Alarma 2 queda en el medio.
+ *
+ * @param id    DS3231_ALARM_1 o DS3231_ALARM_2.
+ * @param alarm Campos y modo.
+ * @return DS3231_OK si funciono correctamente.
+ */
+DS3231_Status DS3231_ArmAlarm(DS3231_AlarmId id, const DS3231_Alarm *alarm);
+
+/**
+ * @brief Deshabilita la interrupción de una alarma (AxIE = 0).
+ *
+ * @param id DS3231_ALARM_1 o DS3231_ALARM_2.
+ * @return DS3231_OK si funciono correctamente.
+ */
+DS3231_Status DS3231_DisarmAlarm(DS3231_AlarmId id);
+
+/**
+ * @brief Lee STATUS y limpia los flags de alarma activos (libera INT/SQW).
+ *
+ * Pensada para llamarse al detectar el flanco de INT: una lectura, y una
+ * escritura solo si había algún flag.
+ *
+ * @param fired Flags que estaban activos (DS3231_STATUS_A1F / A2F). Puede ser NULL.
+ * @return DS3231_OK si funciono correctamente.
+ */
+DS3231_Status DS3231_AckAlarms(uint8_t *fired);
+
+
+/* -------------------------------------------------------------------------- */
+/* CONVERSIONES A TIEMPO UNIX                                                  */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief Convierte una hora del DS3231 (UTC) a segundos Unix.
+ *
+ * Tiempo constante: algoritmo de fecha civil sobre eras de 400 años, sin
+ * lazos por año ni por mes. Usa el calendario gregoriano (2100 no es
+ * bisiesto, aunque el chip lo trate como tal). El día de semana no se usa.
+ *
+ * @param time  Hora con year, month, date, hours, minutes, seconds.
+ * @param epoch Segundos desde 1970-01-01 00:00:00.
+ * @return DS3231_OK, o DS3231_INVALID_PARAM si algún campo está fuera de rango.
+ */
+DS3231_Status DS3231_TimeToEpoch(const DS3231_Time *time, int64_t *epoch);
+
+/**
+ * @brief Convierte segundos Unix a hora del DS3231 (UTC), en tiempo constante.
+ *
+ * Completa también el día de semana con la convención ISO (1 = lunes .. 7 = domingo).
+ *
+ * @param epoch Segundos Unix entre DS3231_EPOCH_MIN y DS3231_EPOCH_MAX.
+ * @param time  Estructura de salida.
+ * @return DS3231_OK, o DS3231_INVALID_PARAM si epoch está fuera de rango.
+ */
+DS3231_Status DS3231_EpochToTime(int64_t epoch, DS3231_Time *time);
+
+/* -------------------------------------------------------------------------- */
+/* API POR HANDLE                                                              */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Inicializa un handle con su propio transporte (no accede al bus).
+ * @param  dev        Handle a inicializar.
+ * @param  transport  Operaciones del backend (NULL = transporte por defecto).
+ * @param  bus        Contexto del backend (p.ej. I2C_HandleTypeDef * o DS3231_Sim *).
+ * @param  address    Dirección 7-bit (normalmente DS3231_ADDRESS).
+ * @return DS3231_OK si funciono correctamente.
+ */
+DS3231_Status DS3231_HandleInit(DS3231_Handle *dev, const DS3231_Transport *transport,
+                                void *bus, uint8_t address);
+
+/**
+ * @brief  Devuelve la instancia usada por las funciones sin handle.
+ */
+DS3231_Handle *DS3231_DefaultHandle(void);
+
+/** @name Variantes por handle
+ *  @brief Mismo comportamiento que la función sin prefijo Dev_, sobre @p dev.
+ *         Retornan DS3231_INVALID_PARAM si @p dev es NULL.
+ *  @{
+ */
+DS3231_Status DS3231_Dev_Init(DS3231_Handle *dev);
+DS3231_Status DS3231_Dev_ReadTime(DS3231_Handle *dev, DS3231_Time *time);
+DS3231_Status DS3231_Dev_SetTime(DS3231_Handle *dev, uint16_t year, uint8_t month, uint8_t date,
+                                 uint8_t day, uint8_t hour, uint8_t min, uint8_t sec);
+DS3231_Status DS3231_Dev_SetTimeAligned(DS3231_Handle *dev, const DS3231_Time *time, uint32_t offset_ns,
+                                        DS3231_TickSource ticks, uint32_t ticks_hz);
+void          DS3231_Dev_SetTimeAligned_OnEdge(DS3231_Handle *dev, uint32_t edge_ticks);
+DS3231_Status DS3231_Dev_SetTimeAligned_Result(const DS3231_Handle *dev, DS3231_AlignedResult *result);
+DS3231_Status DS3231_Dev_AdjustTime(DS3231_Handle *dev, int32_t delta_s);
+DS3231_Status DS3231_Dev_GetTemperatureQ4(DS3231_Handle *dev, int16_t *temp_q4);
+#ifndef DS3231_NO_FLOAT
+DS3231_Status DS3231_Dev_GetTemperature(DS3231_Handle *dev, float *temp);
+#endif
+DS3231_Status DS3231_Dev_ConvertTemperatureAsync(DS3231_Handle *dev, DS3231_TempCallback cb, void *ctx, uint32_t now_ms);
+DS3231_Status DS3231_Dev_ConvertTemperaturePoll(DS3231_Handle *dev, uint32_t now_ms);
+DS3231_Status DS3231_Dev_SetHourMode(DS3231_Handle *dev, DS3231_HourMode mode);
+DS3231_Status DS3231_Dev_GetHourMode(DS3231_Handle *dev, DS3231_HourMode *mode);
+DS3231_Status DS3231_Dev_ReadSnapshot(DS3231_Handle *dev, DS3231_Snapshot *snap);
+DS3231_Status DS3231_Dev_ReadTimeAsync(DS3231_Handle *dev, DS3231_TimeCallback cb, void *ctx);
+DS3231_Status DS3231_Dev_GetTemperatureAsync(DS3231_Handle *dev, DS3231_TempCallback cb, void *ctx);
+DS3231_Status DS3231_Dev_SnapshotDMA_Start(DS3231_Handle *dev, DS3231_SnapshotCallback cb, void *ctx);
+const uint8_t *DS3231_Dev_SnapshotDMA_Acquire(DS3231_Handle *dev, uint32_t *seq);
+void          DS3231_Dev_SnapshotDMA_Release(DS3231_Handle *dev);
+void          DS3231_Dev_CacheInvalidate(DS3231_Handle *dev);
+DS3231_Status DS3231_Dev_CacheRefresh(DS3231_Handle *dev);
+DS3231_Status DS3231_Dev_GetStatus(DS3231_Handle *dev, uint8_t *status);
+DS3231_Status DS3231_Dev_ClearStatus(DS3231_Handle *dev, uint8_t mask);
+void          DS3231_Dev_SetResyncCallback(DS3231_Handle *dev, DS3231_ResyncCallback cb, void *ctx);
+DS3231_Status DS3231_Dev_Supervise(DS3231_Handle *dev);
+bool          DS3231_Dev_TimeValid(const DS3231_Handle *dev);
+DS3231_Status DS3231_Dev_GetPowerLoss(const DS3231_Handle *dev, DS3231_PowerLoss *event);
+DS3231_Status DS3231_Dev_GetControl(DS3231_Handle *dev, uint8_t *control);
+DS3231_Status DS3231_Dev_UpdateControl(DS3231_Handle *dev, uint8_t mask);
+DS3231_Status DS3231_Dev_ClearControl(DS3231_Handle *dev, uint8_t mask);
+DS3231_Status DS3231_Dev_Enable32KHz(DS3231_Handle *dev, bool enable);
+DS3231_Status DS3231_Dev_SetSQWFreq(DS3231_Handle *dev, uint8_t rs_bits);
+DS3231_Status DS3231_Dev_SetAging(DS3231_Handle *dev, int8_t offset);
+DS3231_Status DS3231_Dev_GetAging(DS3231_Handle *dev, int8_t *offset);
+DS3231_Status DS3231_Dev_SetAlarm(DS3231_Handle *dev, DS3231_AlarmId id, const DS3231_Alarm *alarm);
+DS3231_Status DS3231_Dev_GetAlarm(DS3231_Handle *dev, DS3231_AlarmId id, DS3231_Alarm *alarm);
+DS3231_Status DS3231_Dev_ArmAlarm(DS3231_Handle *dev, DS3231_AlarmId id, const DS3231_Alarm *alarm);
+DS3231_Status DS3231_Dev_DisarmAlarm(DS3231_Handle *dev, DS3231_AlarmId id);
+DS3231_Status DS3231_Dev_AckAlarms(DS3231_Handle *dev, uint8_t *fired);
+/** @} */
 
 /** @example
  *  @code
  *  if (DS3231_Init() == DS3231_OK) {
- *      (void)DS3231_SetTime(25, 9, 24, 3, 16, 20, 30); // 2025-09-24 16:20:30
+ *      (void)DS3231_SetTime(2025, 9, 24, 3, 16, 20, 30); // 2025-09-24 16:20:30
  *      DS3231_Time now;
  *      if (DS3231_ReadTime(&now) == DS3231_OK) {
  *          uint8_t hh = now.hours;
@@ -210,6 +950,14 @@ DS3231_Status DS3231_GetAging(int8_t *offset);
  *          uint8_t ss = now.seconds;
  *      }
  *  }
+ *
+ *  // Dos RTC en buses distintos, sin estado compartido:
+ *  DS3231_Handle rtc_a, rtc_b;
+ *  DS3231_HandleInit(&rtc_a, &DS3231_Transport_HAL, &hi2c1, DS3231_ADDRESS);
+ *  DS3231_HandleInit(&rtc_b, &DS3231_Transport_HAL, &hi2c2, DS3231_ADDRESS);
+ *  DS3231_Time ta, tb;
+ *  DS3231_Dev_ReadTime(&rtc_a, &ta);
+ *  DS3231_Dev_ReadTime(&rtc_b, &tb);
  *  @endcode
  */
 
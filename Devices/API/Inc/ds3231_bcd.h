@@ -0,0 +1,233 @@
+/**
+ * @file    ds3231_bcd.h
+ * @brief   Codificación BCD del bloque de tiempo (0x00..0x06) del DS3231.
+ * @details
+ *  Tres implementaciones equivalentes del decodificador y del codificador,
+ *  elegidas en compilación con DS3231_BCD_IMPL:
+ *  - DS3231_BCD_SCALAR: bcd2dec()/dec2bcd() campo por campo (multiplicación
+ *    o división por 10 en cada uno).
+ *  - DS3231_BCD_SWAR:   el bloque se procesa como dos palabras de 32 bits.
+ *    Para decodificar, cada byte vale 16*d + u y se le resta 6*d (d = nibble
+ *    alto de los cuatro bytes a la vez). Para codificar, el cociente por 10
+ *    se obtiene como (x * 103) >> 10 en carriles de 16 bits y se suma 6*q.
+ *  - DS3231_BCD_TABLE:  tablas constantes en flash (256 entradas para
+ *    decodificar, 100 para codificar), un acceso por campo.
+ *
+ *  Todas devuelven lo mismo que la versión escalar para cualquier entrada
+ *  (incluidos nibbles fuera de rango). El benchmark de host compara las tres.
+ *
+ *  El registro de horas puede estar en 12 h (bit 6, con AM/PM en el bit 5).
+ *  Las variantes SWAR y tabla lo normalizan a 24 h con una tabla de 128
+ *  entradas indexada por los bits 6..0, sin saltos; la escalar es la
+ *  referencia con saltos.
+ *
+ * @note
+ *  - La variante SWAR supone little-endian (Cortex-M4 y hosts x86/ARM).
+ *  - DS3231_Time tiene los campos en el mismo orden que los registros
+ *    0x00..0x05 y el año completo en los bytes 6..7, lo que permite escribirlo
+ *    en dos palabras. El año sale del registro 0x06 y del bit de siglo.
+ */
+
+#ifndef DS3231_BCD_H
+#define DS3231_BCD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "ds3231.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup DS3231_BCD Codificación BCD del tiempo
+ *  @{
+ */
+
+#define DS3231_BCD_SCALAR   (0)     /**< bcd2dec()/dec2bcd() por campo. */
+#define DS3231_BCD_SWAR     (1)     /**< Aritmética de nibbles en palabras de 32 bits. */
+#define DS3231_BCD_TABLE    (2)     /**< Tablas constantes en flash. */
+
+#ifndef DS3231_BCD_IMPL
+#define DS3231_BCD_IMPL     DS3231_BCD_SWAR   /**< Implementación usada por el driver. */
+#endif
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+#error "ds3231_bcd: la variante SWAR supone little-endian"
+#endif
+
+#ifdef __cplusplus
+static_assert(sizeof(DS3231_Time) == 8 && offsetof(DS3231_Time, year) == 6,
+              "DS3231_Time debe ser 6 registros + año de 16 bits");
+#else
+_Static_assert(sizeof(DS3231_Time) == 8 && offsetof(DS3231_Time, year) == 6,
+               "DS3231_Time debe ser 6 registros + año de 16 bits");
+#endif
+
+/* Máscaras de los bits válidos de 0x00..0x03 y 0x04..0x06 (little-endian). */
+#define DS3231_BCD_MASK_LO  (0x07007F7FUL)  /**< seconds, minutes, day (hours sale de la tabla) */
+#define DS3231_BCD_MASK_HI  (0x00FF1F3FUL)  /**< date, month (sin siglo), year */
+
+extern const uint8_t DS3231_bcd2dec_lut[256];   /**< bcd2dec() de cada byte. */
+extern const uint8_t DS3231_dec2bcd_lut[100];   /**< dec2bcd() de 0..99. */
+extern const uint8_t DS3231_hours24_lut[128];   /**< Registro de horas (bits 6..0) -> 0..23. */
+extern const uint8_t DS3231_hours12_lut[24];    /**< 0..23 -> registro de horas en 12 h. */
+
+/* Registro de horas -> 0..23 (referencia). En 12 h, 12 AM = 0 y 12 PM = 12. */
+static inline uint8_t DS3231_bcd_hours24(uint8_t reg)
+{
+    if (reg & DS3231_HOURS_12H) {
+        uint8_t h = (uint8_t)(bcd2dec(reg & 0x1F) % 12U);
+        return (uint8_t)(h + ((reg & DS3231_HOURS_PM) ? 12U : 0U));
+    }
+    return bcd2dec(reg & 0x3F);
+}
+
+/* 0..23 -> registro de horas en el formato pedido (fuera de rango se codifica 0). */
+static inline uint8_t DS3231_bcd_hours_reg(uint8_t hours, DS3231_HourMode mode)
+{
+    if (hours > 23U) hours = 0;     // No leer fuera de la tabla ni pisar el bit 12/24.
+    return (mode == DS3231_HOURS_12) ? DS3231_hours12_lut[hours] : dec2bcd(hours);
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Decodificación: 7 registros -> DS3231_Time                                */
+/* -------------------------------------------------------------------------- */
+
+static inline void DS3231_bcd_decode_time_scalar(const uint8_t *buf, DS3231_Time *time)
+{
+    time->seconds = bcd2dec(buf[0] & 0x7F);
+    time->minutes = bcd2dec(buf[1] & 0x7F);
+    time->hours   = DS3231_bcd_hours24(buf[2]);
+    time->day     = (uint8_t)(buf[3] & 0x07);
+    time->date    = bcd2dec(buf[4] & 0x3F);
+    time->month   = bcd2dec(buf[5] & 0x1F);
+    time->year    = (uint16_t)(DS3231_YEAR_MIN + ((buf[5] & DS3231_MONTH_CENTURY) ? 100U : 0U) + bcd2dec(buf[6]));
+}
+
+static inline uint32_t DS3231_bcd_swar_to_dec(uint32_t w)
+{
+    uint32_t tens = (w >> 4) & 0x0F0F0F0FUL;
+    return w - (tens << 2) - (tens << 1);       // 16*d + u - 6*d, sin acarreo entre bytes
+}
+
+static inline void DS3231_bcd_decode_time_swar(const uint8_t *buf, DS3231_Time *time)
+{
+    uint32_t w[2];
+
+    memcpy(&w[0], &buf[0], 4);
+    w[1] = (uint32_t)buf[4] | ((uint32_t)buf[5] << 8) | ((uint32_t)buf[6] << 16);
+
+    w[0] = DS3231_bcd_swar_to_dec(w[0] & DS3231_BCD_MASK_LO) | ((uint32_t)DS3231_hours24_lut[buf[2] & 0x7F] << 16);
+    w[1] = DS3231_bcd_swar_to_dec(w[1] & DS3231_BCD_MASK_HI);
+    // Bytes 6..7: año completo = 2000 + 100 * siglo + año del registro.
+    w[1] = (w[1] & 0xFFFFUL) | ((DS3231_YEAR_MIN + (uint32_t)(buf[5] >> 7) * 100U + (w[1] >> 16)) << 16);
+    memcpy(time, w, sizeof(*time));
+}
+
+static inline void DS3231_bcd_decode_time_table(const uint8_t *buf, DS3231_Time *time)
+{
+    time->seconds = DS3231_bcd2dec_lut[buf[0] & 0x7F];
+    time->minutes = DS3231_bcd2dec_lut[buf[1] & 0x7F];
+    time->hours   = DS3231_hours24_lut[buf[2] & 0x7F];
+    time->day     = (uint8_t)(buf[3] & 0x07);
+    time->date    = DS3231_bcd2dec_lut[buf[4] & 0x3F];
+    time->month   = DS3231_bcd2dec_lut[buf[5] & 0x1F];
+    time->year    = (uint16_t)(DS3231_YEAR_MIN + (uint32_t)(buf[5] >> 7) * 100U + DS3231_bcd2dec_lut[buf[6]]);
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Codificación: DS3231_Time (validado, año 2000..2199) -> 7 registros       */
+/*  Las horas quedan en 24 h; ver DS3231_bcd_hours_reg() para 12 h.           */
+/* -------------------------------------------------------------------------- */
+
+/* Año del registro 0x06 (0..99) y bit de siglo. */
+static inline uint8_t DS3231_bcd_year_reg(uint16_t year, uint8_t *century)
+{
+    uint32_t yy = (uint32_t)year - DS3231_YEAR_MIN;
+    uint32_t c  = (yy >= 100U);
+
+    *century = (uint8_t)(c << 7);
+    return (uint8_t)(yy - c * 100U);
+}
+
+static inline void DS3231_bcd_encode_time_scalar(const DS3231_Time *time, uint8_t *buf)
+{
+    uint8_t century;
+    uint8_t yy = DS3231_bcd_year_reg(time->year, &century);
+
+    buf[0] = dec2bcd(time->seconds);
+    buf[1] = dec2bcd(time->minutes);
+    buf[2] = dec2bcd(time->hours);
+    buf[3] = (uint8_t)(time->day & 0x07);
+    buf[4] = dec2bcd(time->date);
+    buf[5] = (uint8_t)(dec2bcd(time->month) | century);
+    buf[6] = dec2bcd(yy);
+}
+
+/* Carriles de 16 bits: x * 103 <= 10197 no invade el carril vecino. */
+static inline uint32_t DS3231_bcd_swar_lanes_to_bcd(uint32_t lanes)
+{
+    uint32_t q = ((lanes * 103U) >> 10) & 0x000F000FUL;
+    return lanes + (q << 2) + (q << 1);
+}
+
+static inline uint32_t DS3231_bcd_swar_to_bcd(uint32_t w)
+{
+    uint32_t even = DS3231_bcd_swar_lanes_to_bcd(w & 0x00FF00FFUL);
+    uint32_t odd  = DS3231_bcd_swar_lanes_to_bcd((w >> 8) & 0x00FF00FFUL);
+    return even | (odd << 8);
+}
+
+static inline void DS3231_bcd_encode_time_swar(const DS3231_Time *time, uint8_t *buf)
+{
+    uint32_t w[2];
+    uint8_t century;
+    uint8_t yy = DS3231_bcd_year_reg(time->year, &century);
+
+    memcpy(w, time, sizeof(*time));
+    w[0] = DS3231_bcd_swar_to_bcd(w[0] & 0x00FFFFFFUL) | ((uint32_t)(time->day & 0x07) << 24);
+    w[1] = DS3231_bcd_swar_to_bcd((w[1] & 0xFFFFUL) | ((uint32_t)yy << 16)) | ((uint32_t)century << 8);
+
+    memcpy(&buf[0], &w[0], 4);
+    buf[4] = (uint8_t)w[1];
+    buf[5] = (uint8_t)(w[1] >> 8);
+    buf[6] = (uint8_t)(w[1] >> 16);
+}
+
+static inline void DS3231_bcd_encode_time_table(const DS3231_Time *time, uint8_t *buf)
+{
+    uint8_t century;
+    uint8_t yy = DS3231_bcd_year_reg(time->year, &century);
+
+    buf[0] = DS3231_dec2bcd_lut[time->seconds];
+    buf[1] = DS3231_dec2bcd_lut[time->minutes];
+    buf[2] = DS3231_dec2bcd_lut[time->hours];
+    buf[3] = (uint8_t)(time->day & 0x07);
+    buf[4] = DS3231_dec2bcd_lut[time->date];
+    buf[5] = (uint8_t)(DS3231_dec2bcd_lut[time->month] | century);
+    buf[6] = DS3231_dec2bcd_lut[yy];
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Selección                                                                 */
+/* -------------------------------------------------------------------------- */
+
+#if DS3231_BCD_IMPL == DS3231_BCD_SWAR
+#define DS3231_bcd_decode_time   DS3231_bcd_decode_time_swar
+#define DS3231_bcd_encode_time   DS3231_bcd_encode_time_swar
+#elif DS3231_BCD_IMPL == DS3231_BCD_TABLE
+#define DS3231_bcd_decode_time   DS3231_bcd_decode_time_table
+#define DS3231_bcd_encode_time   DS3231_bcd_encode_time_table
+#else
+#define DS3231_bcd_decode_time   DS3231_bcd_decode_time_scalar
+#define DS3231_bcd_encode_time   DS3231_bcd_encode_time_scalar
+#endif
+
+/** @} */ // end group DS3231_BCD
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DS3231_BCD_H */
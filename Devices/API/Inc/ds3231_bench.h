@@ -0,0 +1,494 @@
+/**
+ * @file    ds3231_bench.h
+ * @brief   Benchmark de costo de bus de la API del DS3231.
+ * @details
+ *  Ejecuta cada función pública de ds3231.h contra un DS3231_Sim y reporta,
+ *  por llamada: transacciones, START/STOP, bytes en el bus, tiempo de bus
+ *  modelado a 400 kHz y tiempo de CPU del host. Los resultados se comparan
+ *  contra una línea base para detectar aumentos de costo de bus.
+ *
+ *  En host, compilando con -DI2CM_HOST_SIM -DDS3231_BENCH_MAIN (y -pthread) se
+ *  obtiene un ejecutable:
+ *  @code
+ *  ds3231_bench [-o actual.csv] [-b ds3231_bench_baseline.csv] [-e]
+ *  @endcode
+ *  que escribe el CSV de resultados y retorna 1 si alguna llamada cuesta más
+ *  bus que en la línea base o si falla la verificación de las conversiones a
+ *  tiempo Unix (-e: todos los segundos de 2000..2199), del cambio de siglo, del
+ *  formato 12/24 h, de la cache de CONTROL/STATUS/AGING, de las lecturas
+ *  asíncronas y el snapshot por DMA, del seqlock del reloj con hilos, de la
+ *  supervisión de OSF, de la conversión forzada, de la calibración de AGING,
+ *  del modelo de deriva por temperatura, de la temperatura en punto fijo o de
+ *  los codificadores BCD. Compilando además con -DDS3231_NO_FLOAT se mide la
+ *  variante del driver sin float.
+ *
+ *  DS3231_Bench_Timestamp() mide además el error de DS3231_Clock_Timestamp()
+ *  contra el tiempo real, con flancos de SQW con jitter y un contador de
+ *  ciclos con error de frecuencia.
+ *
+ * @note Solo para host: ds3231_bench.c, como ds3231_sim.c, está excluido del
+ *       build del firmware.
+ */
+
+#ifndef DS3231_BENCH_H
+#define DS3231_BENCH_H
+
+#include <stdint.h>
+#include "ds3231.h"
+#include "ds3231_sim.h"
+#include "ds3231_clock.h"
+#include "ds3231_cal.h"
+#include "ds3231_drift.h"
+#include "ds3231_slew.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup DS3231_BENCH Benchmark de bus
+ *  @{
+ */
+
+#define DS3231_BENCH_NAME_LEN     (32)    /**< Largo máximo del nombre de un caso. */
+#define DS3231_BENCH_CPU_ITERS    (1000)  /**< Repeticiones para promediar el tiempo de CPU. */
+
+#define DS3231_BENCH_TS_CPU_HZ    (84000000U) /**< Frecuencia nominal de la CPU (SystemClock_Config). */
+#define DS3231_BENCH_TS_WARMUP_S  (32U)       /**< Segundos descartados mientras converge el filtro. */
+#define DS3231_BENCH_TS_QUERIES   (16U)       /**< Consultas por segundo simulado. */
+
+#define DS3231_BENCH_EPOCH_STRIDE (997U)      /**< Paso por defecto (s) del barrido de conversiones. */
+#define DS3231_BENCH_EPOCH_SET    (4096U)     /**< Epochs distintos usados para medir CPU. */
+
+#define DS3231_BENCH_BCD_SET      (1024U)     /**< Bloques de tiempo usados en DS3231_Bench_Bcd. */
+#define DS3231_BENCH_BCD_IMPLS    (3U)        /**< Variantes de ds3231_bcd.h (índice = DS3231_BCD_*). */
+
+#define DS3231_BENCH_ALIGN_ISR_US    (5U)       /**< Latencia modelada de la ISR del flanco de referencia. */
+#define DS3231_BENCH_ALIGN_OFFSET_NS (100000U)  /**< Offset de la escritura alineada (> latencia + DS3231_ALIGN_LEAD_NS). */
+
+/**
+ * @brief Reloj del host en nanosegundos (NULL: no se mide CPU).
+ */
+typedef uint64_t (*DS3231_BenchClock)(void);
+
+/**
+ * @brief Resultado de un caso del benchmark.
+ */
+typedef struct {
+    char     name[DS3231_BENCH_NAME_LEN]; /**< Nombre del caso (p.ej. "ReadTime"). */
+    uint32_t transactions;                /**< Transacciones START..STOP. */
+    uint32_t starts;                      /**< START + repeated START. */
+    uint32_t stops;                       /**< STOP. */
+    uint32_t bytes;                       /**< Bytes en el bus. */
+    uint32_t bus_ns_400k;                 /**< Tiempo de bus modelado a 400 kHz. */
+    uint32_t cpu_ns;                      /**< Tiempo de CPU promedio por llamada. */
+} DS3231_BenchResult;
+
+/**
+ * @brief Error de los timestamps respecto del tiempo real.
+ */
+typedef struct {
+    uint32_t samples;     /**< Consultas medidas (sin el warm-up). */
+    int32_t  mean_ns;     /**< Error medio. */
+    uint32_t rms_ns;      /**< Error cuadrático medio. */
+    uint32_t max_abs_ns;  /**< Máximo error absoluto. */
+    uint32_t outliers;    /**< Flancos que reiniciaron la fase del filtro. */
+} DS3231_BenchTsError;
+
+/**
+ * @brief Resultado del barrido de DS3231_TimeToEpoch / DS3231_EpochToTime.
+ */
+typedef struct {
+    uint64_t checked;       /**< Segundos verificados. */
+    uint64_t mismatches;    /**< Difieren de la referencia o no vuelven al mismo epoch. */
+    uint32_t to_time_ps;    /**< CPU por DS3231_EpochToTime, en picosegundos. */
+    uint32_t to_epoch_ps;   /**< CPU por DS3231_TimeToEpoch, en picosegundos. */
+} DS3231_BenchEpoch;
+
+/**
+ * @brief Resultado de una verificación contra el simulador (DS3231_Bench_Century, DS3231_Bench_HourMode,
+ *        DS3231_Bench_PowerLoss).
+ */
+typedef struct {
+    uint32_t checked;       /**< Lecturas verificadas. */
+    uint32_t mismatches;    /**< Lecturas distintas de la referencia. */
+} DS3231_BenchCheck;
+
+/**
+ * @brief Resultado de DS3231_Bench_Conversion.
+ */
+typedef struct {
+    DS3231_BenchCheck check;        /**< Verificaciones (resultado, guardas, errores). */
+    uint32_t          latency_ms;   /**< Desde el inicio hasta el callback. */
+    uint32_t          transactions; /**< Transacciones de inicio + consultas. */
+    uint32_t          bytes;        /**< Bytes en el bus de inicio + consultas. */
+} DS3231_BenchConv;
+
+/**
+ * @brief Resultado de DS3231_Bench_Aligned.
+ */
+typedef struct {
+    DS3231_BenchCheck check;        /**< Verificaciones (fase, hora escrita, transacciones). */
+    int32_t           phase_ns;     /**< Fase informada por la escritura alineada. */
+    int32_t           measured_ns;  /**< Fase medida en la SQW del modelo. */
+    int32_t           naive_ns;     /**< Fase medida con DS3231_SetTime desde el lazo principal. */
+} DS3231_BenchAligned;
+
+/**
+ * @brief Resultado de DS3231_Bench_Adjust.
+ */
+typedef struct {
+    DS3231_BenchCheck check;        /**< Verificaciones (hora, tramo escrito, cadena de cuenta, guardas). */
+    uint32_t          adjusts;      /**< Ajustes que escribieron algo. */
+    uint32_t          bytes;        /**< Bytes en el bus de esos ajustes (lectura + tramo). */
+    uint32_t          full_bytes;   /**< Bytes con lectura + DS3231_SetTime para los mismos ajustes. */
+} DS3231_BenchAdjust;
+
+/**
+ * @brief Resultado de DS3231_Bench_Slew.
+ */
+typedef struct {
+    DS3231_BenchCheck check;        /**< Verificaciones (corrección lograda, AGING restaurado, sin saltos). */
+    int32_t           achieved_ns;  /**< Cambio de fase del chip respecto del tiempo real. */
+    uint32_t          duration_s;   /**< Desde el inicio hasta DS3231_SLEW_DONE. */
+    int8_t            base_aging;   /**< AGING antes y después. */
+    int8_t            slew_aging;   /**< AGING durante el slew. */
+    uint32_t          transactions; /**< Transacciones I2C del slew completo. */
+} DS3231_BenchSlew;
+
+/**
+ * @brief Resultado de DS3231_Bench_Calibration.
+ */
+typedef struct {
+    DS3231_BenchCheck check;        /**< Verificaciones (convergencia, residual, persistencia). */
+    int32_t           ppb_initial;  /**< Error efectivo del modelo al empezar. */
+    int32_t           ppb_residual; /**< Error efectivo del modelo al terminar. */
+    int32_t           ppb_measured; /**< Último error medido por la calibración. */
+    int8_t            aging;        /**< AGING calibrado. */
+    uint16_t          steps;        /**< Ventanas medidas. */
+    uint16_t          sens_ppb;     /**< Sensibilidad de AGING estimada. */
+    uint32_t          duration_s;   /**< Tiempo hasta converger. */
+    uint32_t          transactions; /**< Transacciones I2C de toda la calibración. */
+} DS3231_BenchCal;
+
+/**
+ * @brief Resultado de DS3231_Bench_Drift.
+ *
+ * Los errores de frecuencia y de hora corresponden al día sin referencia,
+ * con la tabla aprendida y con un AGING fijo calibrado a 25 °C.
+ */
+typedef struct {
+    DS3231_BenchCheck check;        /**< Verificaciones (aprendizaje, persistencia, error residual). */
+    uint32_t          learned;      /**< Ventanas aprendidas con referencia. */
+    uint16_t          bins;         /**< Celdas de la tabla con dato. */
+    uint32_t          updates;      /**< Escrituras de AGING en el día sin referencia. */
+    uint32_t          transactions; /**< Transacciones I2C en el día sin referencia. */
+    int32_t           rms_ppb;      /**< Error de frecuencia con la tabla, rms. */
+    int32_t           max_ppb;      /**< Error de frecuencia con la tabla, máximo absoluto. */
+    int32_t           time_us;      /**< Error de hora acumulado con la tabla. */
+    int32_t           fixed_rms_ppb;/**< Error de frecuencia con AGING fijo, rms. */
+    int32_t           fixed_max_ppb;/**< Error de frecuencia con AGING fijo, máximo absoluto. */
+    int32_t           fixed_time_us;/**< Error de hora acumulado con AGING fijo. */
+} DS3231_BenchDrift;
+
+/**
+ * @brief Resultado de DS3231_Bench_Bcd, indexado por DS3231_BCD_SCALAR/SWAR/TABLE.
+ */
+typedef struct {
+    uint32_t mismatches;                        /**< Bloques en que una variante difiere de la escalar. */
+    uint32_t decode_ps[DS3231_BENCH_BCD_IMPLS]; /**< Tiempo por decodificación, en milésimas de unidad del reloj. */
+    uint32_t encode_ps[DS3231_BENCH_BCD_IMPLS]; /**< Tiempo por codificación, ídem. */
+} DS3231_BenchBcd;
+
+/**
+ * @brief Resultado de DS3231_Bench_Temperature.
+ */
+typedef struct {
+    uint32_t mismatches;    /**< Lecturas en que alguna conversión difiere de la referencia. */
+    uint32_t q4_ps;         /**< Tiempo por DS3231_temp_q4(), en milésimas de unidad del reloj. */
+    uint32_t float_ps;      /**< Tiempo por la conversión a float (0 con DS3231_NO_FLOAT). */
+} DS3231_BenchTemp;
+
+/**
+ * @brief Cantidad de casos del benchmark.
+ */
+uint16_t DS3231_Bench_Count(void);
+
+/**
+ * @brief Ejecuta todos los casos sobre @p sim.
+ *
+ * Selecciona temporalmente DS3231_Transport_Sim y restaura el transporte por
+ * defecto al finalizar.
+ *
+ * @param sim     Simulador a usar (se reinicializa).
+ * @param clock   Reloj para medir CPU (puede ser NULL).
+ * @param results Arreglo de salida.
+ * @param max     Capacidad de @p results.
+ * @return Cantidad de casos ejecutados.
+ */
+uint16_t DS3231_Bench_Run(DS3231_Sim *sim, DS3231_BenchClock clock,
+                          DS3231_BenchResult *results, uint16_t max);
+
+/**
+ * @brief Compara resultados contra una línea base.
+ *
+ * Un caso regresa si aumenta transacciones, START, STOP o bytes. El tiempo
+ * de CPU no se compara (depende del host).
+ *
+ * @param results  Resultados actuales.
+ * @param count    Cantidad de resultados.
+ * @param baseline Línea base.
+ * @param n_base   Cantidad de entradas de la línea base.
+ * @param report   Si no es NULL, se llama por cada caso que regresa.
+ * @return Cantidad de casos con regresión.
+ */
+uint16_t DS3231_Bench_Compare(const DS3231_BenchResult *results, uint16_t count,
+                              const DS3231_BenchResult *baseline, uint16_t n_base,
+                              void (*report)(const DS3231_BenchResult *cur, const DS3231_BenchResult *base));
+
+/**
+ * @brief Presupuesto de error de DS3231_Clock_Timestamp().
+ *
+ * Sincroniza un DS3231_Clock con @p sim y genera los flancos de SQW en los
+ * segundos exactos más un jitter uniforme; el contador de ciclos corre a
+ * DS3231_BENCH_TS_CPU_HZ con un error de @p cpu_ppm. En cada segundo se
+ * consulta el timestamp en DS3231_BENCH_TS_QUERIES instantes y se compara
+ * con el tiempo real.
+ *
+ * @param sim       Simulador a usar (se reinicializa).
+ * @param seconds   Segundos a simular (máximo 28 días).
+ * @param jitter_ns Jitter máximo de cada flanco (±).
+ * @param cpu_ppm   Error de frecuencia del reloj de la CPU.
+ * @param result    Estadísticas de salida.
+ */
+void DS3231_Bench_Timestamp(DS3231_Sim *sim, uint32_t seconds, uint32_t jitter_ns, int32_t cpu_ppm,
+                            DS3231_BenchTsError *result);
+
+/**
+ * @brief Verifica y mide las conversiones a tiempo Unix en 2000..2199.
+ *
+ * Recorre los días con un calendario gregoriano incremental de referencia y,
+ * en cada día, los segundos con paso @p stride_s (desplazado día a día para
+ * cubrir todos los segundos del día). Cada epoch se convierte a hora, se
+ * compara con la referencia (incluido el día de semana) y se convierte de
+ * vuelta. Con stride_s = 1 el barrido es exhaustivo.
+ *
+ * @param stride_s Paso en segundos (>= 1).
+ * @param clock    Reloj para medir CPU (puede ser NULL).
+ * @param result   Resultado.
+ */
+void DS3231_Bench_Epoch(uint32_t stride_s, DS3231_BenchClock clock, DS3231_BenchEpoch *result);
+
+/**
+ * @brief Verifica el año de 16 bits y el cambio de siglo contra @p sim.
+ *
+ * Para cada mes de 2000..2199 escribe el último segundo del mes, lo relee
+ * (incluido el bit de siglo en el registro) y avanza un segundo: la lectura
+ * del chip y la de un DS3231_Clock alimentado por la SQW deben dar el primer
+ * segundo del mes siguiente, con la regla de bisiesto del chip (2100 lo es)
+ * y 2199 -> 2000. Además recorre segundo a segundo 2099-12-31 y 2100-01-01,
+ * comparando cada lectura con el epoch esperado.
+ *
+ * @param sim    Simulador a usar (se reinicializa).
+ * @param result Resultado.
+ */
+void DS3231_Bench_Century(DS3231_Sim *sim, DS3231_BenchCheck *result);
+
+/**
+ * @brief Verifica el registro de horas en 12 h y 24 h contra @p sim.
+ *
+ * En cada formato y para cada hora del día: escribe hh:59:59 y verifica el
+ * formato del registro y la lectura en 24 h; cambia al otro formato y vuelve
+ * (la hora no debe cambiar); avanza un segundo a la hora siguiente; escribe
+ * y relee una alarma a esa hora. Una alarma con los campos enmascarados
+ * fuera de rango se escribe con esos campos en 0.
+ *
+ * @param sim    Simulador a usar (se reinicializa).
+ * @param result Resultado.
+ */
+void DS3231_Bench_HourMode(DS3231_Sim *sim, DS3231_BenchCheck *result);
+
+/**
+ * @brief Verifica el costo exacto en bus de la cache de CONTROL, STATUS y AGING.
+ *
+ * Con la cache inválida (después de DS3231_Init), GetControl y GetAging
+ * cuestan una ráfaga y Update/ClearControl y ClearStatus una ráfaga más la
+ * escritura; con la cache válida, las lecturas no usan el bus y las
+ * modificaciones solo escriben. SetAging escribe sin leer. Verifica además
+ * los valores escritos en @p sim, que un cambio externo se vea recién al
+ * invalidar y que una escritura fallida fuerce la próxima lectura.
+ *
+ * @param sim    Simulador a usar (se reinicializa).
+ * @param result Resultado.
+ */
+void DS3231_Bench_Cache(DS3231_Sim *sim, DS3231_BenchCheck *result);
+
+/**
+ * @brief Verifica la finalización simulada de dev_i2cm con lecturas asíncronas del DS3231.
+ *
+ * Usa DS3231_Transport_HAL, cuyas transferencias quedan pendientes hasta que
+ * el bench las termina con I2CM_Async_Complete(), como la ISR de I2C. Con una
+ * lectura en curso verifica que otro pedido del mismo chip sea DS3231_BUSY y
+ * que el pedido encolado de un segundo dispositivo arranque al terminar la
+ * primera, antes de su callback; con el segundo en vuelo, que una lectura del
+ * DS3231 espere su turno aunque el segundo falle. Compara la hora entregada
+ * con la de @p sim y el orden de los callbacks.
+ *
+ * @param sim    Simulador a usar (se reinicializa).
+ * @param result Resultado.
+ */
+void DS3231_Bench_Async(DS3231_Sim *sim, DS3231_BenchCheck *result);
+
+/**
+ * @brief Verifica el doble buffer de DS3231_SnapshotDMA_Start / _Acquire / _Release.
+ *
+ * Sobre el mismo camino de DS3231_Bench_Async: el DMA escribe siempre el
+ * buffer trasero; un snapshot que termina con el frontal tomado se publica
+ * sin modificar el tomado; con el único buffer libre tomado, el inicio es
+ * DS3231_BUSY sin acceder al bus; al liberar, Acquire entrega el nuevo.
+ *
+ * @param sim    Simulador a usar (se reinicializa).
+ * @param result Resultado.
+ */
+void DS3231_Bench_SnapshotDMA(DS3231_Sim *sim, DS3231_BenchCheck *result);
+
+/**
+ * @brief Conversión de temperatura forzada contra el modelo de ~200 ms de @p sim.
+ *
+ * Inicia una conversión con una temperatura nueva en el modelo y llama a
+ * DS3231_ConvertTemperaturePoll() cada 1 ms simulado hasta el callback.
+ * Verifica la temperatura entregada, la latencia, que un segundo inicio y
+ * un inicio durante la conversión automática devuelvan DS3231_BUSY, y que un
+ * error de bus durante la espera llegue al callback.
+ *
+ * @param sim    Simulador a usar (se reinicializa).
+ * @param result Resultado.
+ */
+void DS3231_Bench_Conversion(DS3231_Sim *sim, DS3231_BenchConv *result);
+
+/**
+ * @brief Verifica la supervisión de OSF contra los cortes de alimentación de @p sim.
+ *
+ * Arranque con OSF (resincronización fallida y luego exitosa), corte sin
+ * batería detectado por DS3231_ReadSnapshot y por el snapshot por DMA, y
+ * corte con batería (sin evento). En cada caso verifica el evento registrado,
+ * DS3231_TimeValid() sin accesos al bus y que OSF se limpie con una sola
+ * escritura además de la del callback.
+ *
+ * @param sim    Simulador a usar (se reinicializa).
+ * @param result Resultado.
+ */
+void DS3231_Bench_PowerLoss(DS3231_Sim *sim, DS3231_BenchCheck *result);
+
+/**
+ * @brief Escritura de hora alineada contra el tiempo de bus modelado de @p sim.
+ *
+ * Con el bus a 400 kHz en el reloj virtual, genera flancos de referencia
+ * desfasados del segundo del chip y dispara DS3231_SetTimeAligned_OnEdge con
+ * DS3231_BENCH_ALIGN_ISR_US de latencia, usando como contador el tiempo
+ * virtual (cada lectura consume 1 µs). La fase real es el primer flanco de
+ * la SQW menos el de referencia, menos 1 s. Verifica que coincida con la
+ * informada, la hora escrita y una sola transacción; que con la ISR tarde
+ * no se espere ni se escriba (DS3231_TIMEOUT); que un offset mayor que
+ * DS3231_ALIGN_MAX_OFFSET_NS se rechace y que un flanco sin escritura armada no use el bus.
+ *
+ * @param sim    Simulador a usar (se reinicializa).
+ * @param result Resultado.
+ */
+void DS3231_Bench_Aligned(DS3231_Sim *sim, DS3231_BenchAligned *result);
+
+/**
+ * @brief Verifica DS3231_AdjustTime contra @p sim.
+ *
+ * Para varias horas de partida (fin de año, de siglo, 29 de febrero, febrero
+ * de 2100) y deltas de ±1 s a un año, en 24 h y 12 h: verifica la hora
+ * resultante contra el calendario del chip (con el día de semana en la
+ * convención escrita), que los bytes en el bus sean la
+ * lectura más exactamente el tramo de registros que cambió en el modelo y
+ * que un tramo sin segundos no reinicie la cadena de cuenta. Además, el
+ * rechazo en :59 y fuera de 2000..2199 sin escrituras.
+ *
+ * @param sim    Simulador a usar (se reinicializa).
+ * @param result Resultado.
+ */
+void DS3231_Bench_Adjust(DS3231_Sim *sim, DS3231_BenchAdjust *result);
+
+/**
+ * @brief Corrección de fase por AGING contra el modelo de frecuencia de @p sim.
+ *
+ * Parte de un chip calibrado (AGING = 7, error efectivo 0), aplica @p offset_us con DS3231_Slew_Poll() cada 10 ms y
+ * mide el cambio de fase del chip contra el tiempo real del simulador.
+ * Verifica que coincida con lo pedido (±1 µs), que AGING vuelva al valor
+ * original y que la hora no salte.
+ *
+ * @param sim       Simulador a usar (se reinicializa).
+ * @param offset_us Corrección a aplicar.
+ * @param lsb       Desvío de AGING (0 = DS3231_SLEW_LSB).
+ * @param result    Resultado.
+ */
+void DS3231_Bench_Slew(DS3231_Sim *sim, int32_t offset_us, uint8_t lsb, DS3231_BenchSlew *result);
+
+/**
+ * @brief Calibración de AGING contra el modelo de error de frecuencia de @p sim.
+ *
+ * Usa como referencia un contador ideal de DS3231_BENCH_TS_CPU_HZ derivado del
+ * tiempo real del simulador y llama a DS3231_Cal_Poll() cada 10 ms hasta que
+ * la calibración termina. Verifica que converja, que el error residual del
+ * modelo quede en medio LSB y que el registro guardado se pueda restaurar (y
+ * uno corrupto no).
+ *
+ * @param sim       Simulador a usar (se reinicializa).
+ * @param source    Salida del chip usada como evento.
+ * @param ppb       Error del cristal a simular.
+ * @param aging_ppb Sensibilidad de AGING del modelo (ppb por LSB).
+ * @param result    Resultado.
+ */
+void DS3231_Bench_Calibration(DS3231_Sim *sim, DS3231_CalSource source, int32_t ppb, int16_t aging_ppb,
+                              DS3231_BenchCal *result);
+
+/**
+ * @brief Modelo de deriva contra un oscilador con residuo de temperatura.
+ *
+ * Simula un cristal de +1.5 ppm con una curvatura de 4 ppb/°C². Durante
+ * 48 h aprende con la SQW y una referencia ideal mientras la temperatura
+ * recorre 5..35 °C en un ciclo de 24 h; después guarda la tabla, reinicia el
+ * modelo sin referencia, la restaura y simula un día de 8..32 °C en ciclos de
+ * 6 h, comparando el error contra un AGING fijo calibrado a 25 °C.
+ *
+ * @param sim    Simulador a usar (se reinicializa).
+ * @param result Resultado.
+ */
+void DS3231_Bench_Drift(DS3231_Sim *sim, DS3231_BenchDrift *result);
+
+/**
+ * @brief Verifica y mide las tres variantes de ds3231_bcd.h.
+ *
+ * Decodifica DS3231_BENCH_BCD_SET bloques de registros arbitrarios y codifica
+ * otras tantas horas válidas con cada variante, comparando contra la escalar.
+ * Con un reloj en nanosegundos los tiempos quedan en picosegundos; en un
+ * build de prueba del target que agregue ds3231_bench.c y ds3231_sim.c, con
+ * un reloj que devuelva DWT->CYCCNT, quedan en milésimas de ciclo.
+ *
+ * @param clock  Reloj para medir CPU (puede ser NULL: solo verifica).
+ * @param result Resultado.
+ */
+void DS3231_Bench_Bcd(DS3231_BenchClock clock, DS3231_BenchBcd *result);
+
+/**
+ * @brief Verifica y mide la conversión de temperatura en punto fijo y en float.
+ *
+ * Recorre las 1024 lecturas posibles de 0x11..0x12 comparando
+ * DS3231_temp_q4() con el complemento a 2 de 10 bits y, sin DS3231_NO_FLOAT,
+ * su versión en °C con la conversión float original.
+ *
+ * @param clock  Reloj para medir CPU (puede ser NULL: solo verifica).
+ * @param result Resultado.
+ */
+void DS3231_Bench_Temperature(DS3231_BenchClock clock, DS3231_BenchTemp *result);
+
+/** @} */ // end group DS3231_BENCH
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DS3231_BENCH_H */
@@ -0,0 +1,275 @@
+/**
+ * @file    ds3231_cal.h
+ * @brief   Calibración automática del registro AGING del DS3231.
+ * @details
+ *  Mide el error de frecuencia del RTC contra una referencia externa y
+ *  ajusta AGING en pasos sucesivos hasta que el error residual queda por
+ *  debajo de medio LSB.
+ *
+ *  Cada evento del RTC es un segundo nominal:
+ *  - DS3231_CAL_SRC_SQW:   flanco de la SQW de 1 Hz (INT/SQW a una entrada de
+ *    captura o EXTI).
+ *  - DS3231_CAL_SRC_32KHZ: 32768 ciclos de la salida de 32 kHz, contados por
+ *    un timer en modo reloj externo cuyo evento de update dispara la captura.
+ *
+ *  En cada evento, la ISR llama a DS3231_Cal_OnEvent() con el valor de un
+ *  contador libre de 32 bits derivado de la referencia (p.ej. TIM2/TIM5 con
+ *  el HSE, en captura de entrada). La ISR solo acumula las sumas de un ajuste
+ *  por mínimos cuadrados del tiempo de referencia contra el número de evento;
+ *  la pendiente es el período real del RTC y su desvío respecto de ref_hz es
+ *  el error en ppb. Un ajuste sobre toda la ventana promedia el jitter de
+ *  captura mucho mejor que la diferencia entre el primer y el último evento.
+ *
+ *  DS3231_Cal_Poll(), desde el lazo principal, toma la ventana completa,
+ *  escribe el nuevo AGING y fuerza una conversión de temperatura (el chip
+ *  recién aplica AGING al terminar una conversión). La sensibilidad de AGING
+ *  (~0.1 ppm por LSB a 25 °C, varía con la temperatura) se reestima con cada
+ *  paso a partir del cambio de error medido.
+ *
+ *  Al converger, el resultado queda en un DS3231_CalRecord que se entrega a un
+ *  callback de almacenamiento (flash, backup SRAM, EEPROM). AGING se conserva
+ *  con VBAT, pero un corte sin batería lo vuelve a 0: DS3231_Cal_Restore()
+ *  lo recarga desde el registro guardado.
+ *
+ * @note
+ *  - La referencia debe ser bastante mejor que el RTC (HSE con TCXO, GPS
+ *    disciplinado): su error se suma al estimado.
+ *  - Los eventos perdidos o con ruido (fuera de ref_hz / 2^DS3231_CAL_TOL_SHIFT)
+ *    reinician la ventana en curso.
+ *  - Con DS3231_CAL_SRC_SQW la SQW queda en 1 Hz con INTCN = 0, igual que con
+ *    ds3231_clock: ambos pueden compartir la misma ISR.
+ */
+
+#ifndef DS3231_CAL_H
+#define DS3231_CAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ds3231.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup DS3231_CAL Calibración de AGING
+ *  @{
+ */
+
+#define DS3231_CAL_WINDOW           (64U)       /**< Eventos (s) por ajuste; acota las sumas a 64 bits. */
+#define DS3231_CAL_TOL_SHIFT        (12U)       /**< Tolerancia de un evento: ref_hz / 4096 (~244 ppm). */
+#define DS3231_CAL_MAX_STEPS        (8U)        /**< Pasos antes de abandonar. */
+#define DS3231_CAL_SENS_PPB         (100)       /**< Sensibilidad inicial de AGING (ppb por LSB). */
+#define DS3231_CAL_SENS_MIN_PPB     (25)        /**< Sensibilidad medida mínima aceptada. */
+#define DS3231_CAL_SENS_MAX_PPB     (400)       /**< Sensibilidad medida máxima aceptada. */
+#define DS3231_CAL_RECORD_MAGIC     (0x4C414344UL)  /**< "DCAL". */
+
+/**
+ * @brief Salida del DS3231 usada como evento de 1 s.
+ */
+typedef enum {
+    DS3231_CAL_SRC_SQW = 0,     /**< SQW de 1 Hz. */
+    DS3231_CAL_SRC_32KHZ,       /**< 32 kHz dividida por 32768 en un timer. */
+} DS3231_CalSource;
+
+/**
+ * @brief Estado de la calibración.
+ */
+typedef enum {
+    DS3231_CAL_IDLE = 0,        /**< Sin iniciar. */
+    DS3231_CAL_APPLYING,        /**< Esperando la conversión que aplica AGING. */
+    DS3231_CAL_MEASURING,       /**< Acumulando una ventana. */
+    DS3231_CAL_CONVERGED,       /**< Error residual < medio LSB; resultado en record. */
+    DS3231_CAL_FAILED,          /**< AGING saturado o DS3231_CAL_MAX_STEPS agotados. */
+} DS3231_CalState;
+
+/**
+ * @brief Resultado persistente de una calibración (24 bytes, sin padding).
+ */
+typedef struct {
+    uint32_t magic;             /**< DS3231_CAL_RECORD_MAGIC. */
+    int32_t  ppb;               /**< Error residual medido con el AGING final. */
+    uint32_t duration_s;        /**< Segundos desde el inicio hasta converger. */
+    uint16_t steps;             /**< Ajustes medidos. */
+    uint16_t sens_ppb;          /**< Sensibilidad de AGING estimada (ppb por LSB). */
+    int8_t   aging;             /**< Valor de AGING calibrado. */
+    uint8_t  reserved[3];
+    uint32_t check;             /**< FNV-1a de los bytes anteriores. */
+} DS3231_CalRecord;
+
+/**
+ * @brief Callback de almacenamiento del resultado.
+ * @param rec Registro a guardar (válido solo durante el callback).
+ * @param ctx Contexto de usuario.
+ */
+typedef void (*DS3231_CalStore)(const DS3231_CalRecord *rec, void *ctx);
+
+/**
+ * @brief Ventana de medición: ajuste por mínimos cuadrados de eventos de 1 s
+ *        contra el contador de referencia.
+ *
+ * La escribe la ISR (DS3231_CalMeter_OnEvent) hasta que ready = true; a partir
+ * de ahí la lee el lazo principal, que la vacía con DS3231_CalMeter_Reset().
+ */
+typedef struct {
+    uint32_t         ref_hz;        /**< Ticks de referencia por segundo nominal. */
+    uint32_t         last_ticks;    /**< Captura del evento anterior. */
+    uint32_t         samples;       /**< Eventos en la ventana (k = 0..samples-1). */
+    int32_t          offset;        /**< Desvío acumulado t'(k) = t(k) - t(0) - k * ref_hz. */
+    int64_t          sum_t;         /**< Suma de t'(k). */
+    int64_t          sum_kt;        /**< Suma de k * t'(k). */
+    volatile bool    ready;         /**< Ventana completa (DS3231_CAL_WINDOW eventos). */
+    uint32_t         outliers;      /**< Eventos fuera de tolerancia (ventana reiniciada). */
+} DS3231_CalMeter;
+
+/**
+ * @brief Conversión forzada que aplica un AGING recién escrito (compartida
+ *        por DS3231_Cal, DS3231_Drift y DS3231_Slew).
+ *
+ * El chip recién usa el AGING escrito al terminar una conversión de
+ * temperatura. DS3231_CalApply_Poll() la fuerza y la sigue hasta el callback;
+ * si hay una automática en curso espera a que termine y lo marca en deferred.
+ */
+typedef struct {
+    DS3231_TempCallback done;       /**< Fin de la conversión (puede ser NULL). */
+    void            *ctx;           /**< Contexto de done. */
+    uint32_t         conv_ms;       /**< Inicio de la conversión que aplica AGING. */
+    volatile bool    converting;    /**< Conversión forzada en curso. */
+    bool             deferred;      /**< La conversión forzada esperó a una automática. */
+} DS3231_CalApply;
+
+/**
+ * @brief Estado de la calibración.
+ */
+typedef struct {
+    DS3231_Handle   *dev;           /**< Instancia del DS3231. */
+    DS3231_CalSource source;        /**< Salida usada como evento. */
+    DS3231_CalMeter  meter;         /**< Ventana en curso (ISR mientras state == MEASURING). */
+    volatile uint32_t events;       /**< Eventos desde el inicio. */
+
+    volatile DS3231_CalState state; /**< Estado actual. */
+    int8_t           aging;         /**< AGING escrito en el chip. */
+    int8_t           prev_aging;    /**< AGING de la medición anterior. */
+    int32_t          ppb;           /**< Último error medido (positivo = el RTC adelanta). */
+    int32_t          prev_ppb;      /**< Error de la medición anterior. */
+    int32_t          sens_ppb;      /**< Sensibilidad de AGING estimada. */
+    uint16_t         steps;         /**< Ventanas medidas. */
+    DS3231_CalApply  apply;         /**< Conversión que aplica AGING (APPLYING). */
+
+    DS3231_CalStore  store;         /**< Almacenamiento del resultado (puede ser NULL). */
+    void            *store_ctx;     /**< Contexto de store. */
+    DS3231_CalRecord record;        /**< Resultado (válido en DS3231_CAL_CONVERGED). */
+} DS3231_Cal;
+
+/**
+ * @brief Vacía la ventana; el próximo evento es k = 0.
+ * @param meter  Ventana.
+ * @param ref_hz Ticks de referencia por segundo nominal.
+ */
+void DS3231_CalMeter_Reset(DS3231_CalMeter *meter, uint32_t ref_hz);
+
+/**
+ * @brief Agrega un evento a la ventana. Llamar desde la ISR de captura.
+ * @param meter     Ventana.
+ * @param ref_ticks Valor del contador de referencia capturado en el evento.
+ * @return true si la ventana quedó completa (los eventos siguientes se ignoran).
+ */
+bool DS3231_CalMeter_OnEvent(DS3231_CalMeter *meter, uint32_t ref_ticks);
+
+/**
+ * @brief Error de frecuencia del RTC según la ventana (al menos 2 eventos).
+ * @param meter Ventana.
+ * @return Error en ppb (positivo = el RTC adelanta).
+ */
+int32_t DS3231_CalMeter_Ppb(const DS3231_CalMeter *meter);
+
+/**
+ * @brief División entera redondeada al más cercano (mitades alejándose de 0).
+ * @param num Dividendo.
+ * @param den Divisor (> 0).
+ */
+static inline int64_t DS3231_Cal_DivRound(int64_t num, int64_t den)
+{
+    return (num >= 0) ? (num + den / 2) / den : -((-num + den / 2) / den);
+}
+
+/**
+ * @brief Prepara la conversión que aplica AGING.
+ * @param apply Estado a inicializar.
+ * @param done  Callback al terminar la conversión, con su resultado.
+ * @param ctx   Contexto de usuario.
+ */
+void DS3231_CalApply_Init(DS3231_CalApply *apply, DS3231_TempCallback done, void *ctx);
+
+/**
+ * @brief Fuerza la conversión que aplica AGING, o la sigue si ya está en curso.
+ *
+ * Llamar después de escribir AGING y en cada Poll hasta que llegue done. Con
+ * una conversión automática en curso no inicia nada (devuelve DS3231_OK) y
+ * se reintenta en la llamada siguiente.
+ *
+ * @param apply  Estado.
+ * @param dev    Instancia del DS3231.
+ * @param now_ms Tick actual en ms.
+ * @return DS3231_OK si la conversión sigue o terminó; el error de bus si no.
+ */
+DS3231_Status DS3231_CalApply_Poll(DS3231_CalApply *apply, DS3231_Handle *dev, uint32_t now_ms);
+
+/**
+ * @brief Habilita la salida elegida y arranca la calibración desde el AGING actual.
+ *
+ * @param cal    Calibración a inicializar.
+ * @param dev    Instancia del DS3231.
+ * @param source Salida usada como evento de 1 s.
+ * @param ref_hz Frecuencia del contador de referencia (p.ej. 84000000).
+ * @return DS3231_OK si funciono correctamente.
+ */
+DS3231_Status DS3231_Cal_Start(DS3231_Cal *cal, DS3231_Handle *dev, DS3231_CalSource source, uint32_t ref_hz);
+
+/**
+ * @brief Fija el callback que guarda el resultado al converger.
+ *
+ * Llamar después de DS3231_Cal_Start().
+ *
+ * @param cal   Calibración.
+ * @param store Callback (NULL: no se guarda).
+ * @param ctx   Contexto de usuario.
+ */
+void DS3231_Cal_SetStore(DS3231_Cal *cal, DS3231_CalStore store, void *ctx);
+
+/**
+ * @brief Registra un evento del RTC. Llamar desde la ISR de captura.
+ * @param cal       Calibración.
+ * @param ref_ticks Valor del contador de referencia capturado en el evento.
+ */
+void DS3231_Cal_OnEvent(DS3231_Cal *cal, uint32_t ref_ticks);
+
+/**
+ * @brief Procesa una ventana completa; llamar desde el lazo principal.
+ *
+ * Solo accede al bus al terminar una ventana (escritura de AGING y
+ * conversión forzada) y mientras espera esa conversión.
+ *
+ * @param cal    Calibración.
+ * @param now_ms Tick actual en ms (para DS3231_ConvertTemperaturePoll).
+ * @return DS3231_OK mientras avanza o al converger; DS3231_ERROR si falló
+ *         (state == DS3231_CAL_FAILED) o hubo un error de bus.
+ */
+DS3231_Status DS3231_Cal_Poll(DS3231_Cal *cal, uint32_t now_ms);
+
+/**
+ * @brief Escribe en el chip el AGING de un registro guardado.
+ *
+ * @param dev Instancia del DS3231.
+ * @param rec Registro leído del almacenamiento.
+ * @return DS3231_OK si el registro es válido y se escribió;
+ *         DS3231_INVALID_PARAM si la marca o el chequeo no coinciden.
+ */
+DS3231_Status DS3231_Cal_Restore(DS3231_Handle *dev, const DS3231_CalRecord *rec);
+
+/** @} */ // end group DS3231_CAL
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DS3231_CAL_H */
@@ -0,0 +1,195 @@
+/**
+ * @file    ds3231_clock.h
+ * @brief   Reloj por software sincronizado con la SQW de 1 Hz del DS3231.
+ * @details
+ *  Lee la hora del chip una sola vez (al arrancar y en cada resincronización)
+ *  y a partir de ahí avanza un calendario local en la ISR del flanco de la
+ *  SQW. DS3231_Clock_Now() copia ese calendario sin tocar el bus I2C.
+ *
+ *  Conexión en placa: INT/SQW del DS3231 (open drain, pull-up) a una entrada
+ *  EXTI en flanco descendente; el callback de la EXTI llama a
+ *  DS3231_Clock_OnEdge(). El flanco descendente de la SQW coincide con el
+ *  incremento del registro de segundos.
+ *
+ *  Cada check_period_s flancos, DS3231_Clock_Poll() relee el chip y compara;
+ *  si difiere (flanco perdido, ruido en la línea) corrige el calendario.
+ *
+ *  Para resolución sub-segundo, la ISR también captura el contador de ciclos
+ *  (DWT->CYCCNT) en cada flanco. Un filtro alfa-beta estima la fase del
+ *  flanco y los ciclos de CPU por segundo del RTC, y DS3231_Clock_Timestamp()
+ *  interpola los nanosegundos desde el último flanco.
+ *
+ *  Lo que escribe la ISR se publica en un DS3231_ClockSnapshot protegido por
+ *  un seqlock: la ISR incrementa la secuencia antes y después de escribir, y
+ *  los lectores copian el snapshot y reintentan si la secuencia cambió o era
+ *  impar. Los lectores nunca deshabilitan interrupciones, así que la latencia
+ *  de la ISR no depende de cuántos consumidores piden la hora.
+ *
+ * @note
+ *  - En host el flanco lo genera DS3231_Sim (on_edge, DS3231_SIM_EDGE_SQW).
+ *  - La SQW queda en 1 Hz con INTCN = 0: no se puede usar junto con las
+ *    interrupciones de alarma en el mismo pin.
+ *  - Un lector no puede interrumpir a un escritor (esperaría para siempre):
+ *    no leer la hora desde ISR de mayor prioridad que la EXTI de la SQW. Las
+ *    escrituras desde el lazo principal (resincronización) se hacen con las
+ *    interrupciones deshabilitadas por la misma razón.
+ */
+
+#ifndef DS3231_CLOCK_H
+#define DS3231_CLOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ds3231.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup DS3231_CLOCK Reloj por SQW
+ *  @{
+ */
+
+#define DS3231_CLOCK_CHECK_PERIOD_S   (3600U)   /**< Período por defecto del chequeo contra el chip. */
+#define DS3231_CLOCK_SYNC_RETRIES     (3U)      /**< Lecturas a intentar si un flanco cae durante la lectura. */
+
+#define DS3231_CLOCK_PHASE_SHIFT      (2U)      /**< Ganancia de fase del filtro: 1/4 del error por flanco. */
+#define DS3231_CLOCK_FREQ_SHIFT       (5U)      /**< Ganancia de frecuencia del filtro: 1/32 del error por flanco. */
+#define DS3231_CLOCK_TOL_SHIFT        (5U)      /**< Tolerancia de un flanco: período / 32 (~3 %). */
+
+/**
+ * @brief Fuente del contador de ciclos de CPU (por defecto DWT->CYCCNT).
+ */
+typedef uint32_t (*DS3231_ClockCycles)(void);
+
+/**
+ * @brief Hora con resolución sub-segundo.
+ */
+typedef struct {
+    DS3231_Time time;   /**< Segundo actual del RTC. */
+    uint32_t    ns;     /**< Nanosegundos desde el flanco de ese segundo (0..999999999). */
+} DS3231_Timestamp;
+
+/**
+ * @brief Estado publicado por la ISR, leído con DS3231_Clock_Snapshot().
+ */
+typedef struct {
+    DS3231_Time time;               /**< Calendario local. */
+    uint32_t    edges;              /**< Flancos recibidos. */
+    uint32_t    edge_cycles;        /**< Fase filtrada del último flanco, en ciclos. */
+    uint64_t    ns_per_cycle_q32;   /**< 1e9 / ciclos por segundo (Q32), para interpolar sin dividir. */
+    bool        valid;              /**< true una vez sincronizado con el chip. */
+    bool        phase;              /**< true si edge_cycles corresponde al último flanco. */
+} DS3231_ClockSnapshot;
+
+/**
+ * @brief Estado del reloj por software.
+ */
+typedef struct {
+    DS3231_Handle     *dev;             /**< Instancia del DS3231. */
+    volatile uint32_t  seq;             /**< Secuencia del seqlock (impar: escritura en curso). */
+    DS3231_ClockSnapshot snap;          /**< Estado publicado (leer con DS3231_Clock_Snapshot). */
+
+    uint32_t           check_period_s;  /**< Flancos entre chequeos (0 = sin chequeo). */
+    uint32_t           next_check;      /**< Valor de edges del próximo chequeo. */
+    uint32_t           resyncs;         /**< Lecturas del chip que cargaron el calendario. */
+    uint32_t           mismatches;      /**< Chequeos en que el calendario difería del chip. */
+
+    DS3231_ClockCycles cycles;          /**< Fuente de ciclos (NULL: sin timestamps). */
+    uint32_t           period_q4;       /**< Ciclos de CPU por segundo del RTC (Q4). */
+    uint8_t            lock;            /**< 0: sin fase, 1: fase del último flanco, 2: además período medido. */
+    uint32_t           outliers;        /**< Flancos fuera de tolerancia (fase reiniciada). */
+} DS3231_Clock;
+
+/**
+ * @brief Configura la SQW en 1 Hz y sincroniza el calendario con el chip.
+ *
+ * @param clk            Reloj a inicializar.
+ * @param dev            Instancia del DS3231 (p.ej. DS3231_DefaultHandle()).
+ * @param check_period_s Segundos entre chequeos contra el chip (0 = nunca).
+ * @return DS3231_OK si funciono correctamente.
+ */
+DS3231_Status DS3231_Clock_Start(DS3231_Clock *clk, DS3231_Handle *dev, uint32_t check_period_s);
+
+/**
+ * @brief Relee la hora del chip y recarga el calendario.
+ *
+ * Si un flanco cae durante la lectura no se sabe si el chip ya había
+ * incrementado los segundos, así que se vuelve a leer (el próximo flanco
+ * está a un segundo).
+ *
+ * @param clk Reloj.
+ * @return DS3231_OK si funciono correctamente; DS3231_BUSY si no hubo una
+ *         lectura limpia en DS3231_CLOCK_SYNC_RETRIES intentos.
+ */
+DS3231_Status DS3231_Clock_Resync(DS3231_Clock *clk);
+
+/**
+ * @brief Avanza el calendario un segundo. Llamar desde la ISR del flanco.
+ * @param clk Reloj.
+ */
+void DS3231_Clock_OnEdge(DS3231_Clock *clk);
+
+/**
+ * @brief Copia consistente del estado publicado por la ISR (seqlock, sin locks).
+ *
+ * @param clk  Reloj.
+ * @param snap Estructura de salida.
+ * @return DS3231_OK, o DS3231_NOT_READY si todavía no se sincronizó.
+ */
+DS3231_Status DS3231_Clock_Snapshot(const DS3231_Clock *clk, DS3231_ClockSnapshot *snap);
+
+/**
+ * @brief Copia la hora actual sin acceder al bus.
+ *
+ * Seguro frente a la ISR: si un flanco interrumpe la copia, se repite.
+ *
+ * @param clk  Reloj.
+ * @param time Estructura de salida.
+ * @return DS3231_OK, o DS3231_NOT_READY si todavía no se sincronizó.
+ */
+DS3231_Status DS3231_Clock_Now(const DS3231_Clock *clk, DS3231_Time *time);
+
+/**
+ * @brief Reemplaza la fuente de ciclos usada para los timestamps.
+ *
+ * DS3231_Clock_Start() deja DWT->CYCCNT a SystemCoreClock en el target y
+ * ninguna fuente en host. Llamar después de DS3231_Clock_Start().
+ *
+ * @param clk        Reloj.
+ * @param source     Contador de ciclos libre de 32 bits (NULL deshabilita los timestamps).
+ * @param nominal_hz Frecuencia nominal del contador (estimación inicial del filtro).
+ * @return DS3231_OK si funciono correctamente.
+ */
+DS3231_Status DS3231_Clock_SetCycleSource(DS3231_Clock *clk, DS3231_ClockCycles source, uint32_t nominal_hz);
+
+/**
+ * @brief Hora con resolución de nanosegundos, sin acceso al bus y sin locks.
+ *
+ * Interpola con el contador de ciclos desde el último flanco. Si el próximo
+ * flanco se demora, los nanosegundos se saturan en 999999999.
+ *
+ * @param clk Reloj.
+ * @param ts  Estructura de salida.
+ * @return DS3231_OK, o DS3231_NOT_READY si no hay hora o fase del flanco.
+ */
+DS3231_Status DS3231_Clock_Timestamp(const DS3231_Clock *clk, DS3231_Timestamp *ts);
+
+/**
+ * @brief Chequeo periódico contra el chip; llamar desde el lazo principal.
+ *
+ * No accede al bus salvo que haya vencido el período de chequeo o el reloj
+ * no esté sincronizado.
+ *
+ * @param clk Reloj.
+ * @return DS3231_OK si funciono correctamente (haya corregido o no).
+ */
+DS3231_Status DS3231_Clock_Poll(DS3231_Clock *clk);
+
+/** @} */ // end group DS3231_CLOCK
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DS3231_CLOCK_H */
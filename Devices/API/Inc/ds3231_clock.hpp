@@ -0,0 +1,69 @@
+/**
+ * @file    ds3231_clock.hpp
+ * @brief   Envoltorio C++ del reloj por SQW (ds3231_clock.h).
+ * @details
+ *  Devuelve el snapshot, la hora y el timestamp por valor. No agrega estado:
+ *  cada llamada es una lectura por seqlock del DS3231_Clock envuelto, así que
+ *  puede haber tantas instancias como consumidores.
+ *
+ *  @code
+ *  ds3231::Clock clock(rtc_clock);
+ *  ds3231::Snapshot s = clock.snapshot();
+ *  if (s.valid) { ... s.time.seconds ... }
+ *  @endcode
+ */
+
+#ifndef DS3231_CLOCK_HPP
+#define DS3231_CLOCK_HPP
+
+#include "ds3231_clock.h"
+
+namespace ds3231 {
+
+/** Estado publicado por la ISR (ver DS3231_ClockSnapshot). */
+using Snapshot = DS3231_ClockSnapshot;
+
+/** Hora con nanosegundos (ver DS3231_Timestamp). */
+using Timestamp = DS3231_Timestamp;
+
+/**
+ * @brief Vista de solo lectura sobre un DS3231_Clock.
+ */
+class Clock {
+public:
+    explicit Clock(const DS3231_Clock &clk) : clk_(clk) {}
+
+    /** Copia consistente del estado; valid = false si no está sincronizado. */
+    Snapshot snapshot() const
+    {
+        Snapshot s;
+        (void)DS3231_Clock_Snapshot(&clk_, &s);
+        return s;
+    }
+
+    /** Hora actual, sin acceso al bus. */
+    DS3231_Time now() const
+    {
+        DS3231_Time t;
+        (void)DS3231_Clock_Now(&clk_, &t);
+        return t;
+    }
+
+    /** Hora con nanosegundos; ns = 0 si todavía no hay fase del flanco. */
+    Timestamp timestamp() const
+    {
+        Timestamp ts;
+        (void)DS3231_Clock_Timestamp(&clk_, &ts);
+        return ts;
+    }
+
+    /** true una vez sincronizado con el chip. */
+    bool valid() const { return snapshot().valid; }
+
+private:
+    const DS3231_Clock &clk_;
+};
+
+} // namespace ds3231
+
+#endif /* DS3231_CLOCK_HPP */
@@ -0,0 +1,148 @@
+/**
+ * @file    ds3231_drift.h
+ * @brief   Modelo de deriva del DS3231 indexado por temperatura.
+ * @details
+ *  El TCXO del DS3231 deja un residuo que depende de la temperatura (unas
+ *  decenas a cientos de ppb en el rango industrial) y que un AGING fijo,
+ *  calibrado a una sola temperatura, no corrige. Este módulo aprende ese
+ *  residuo por cuartos de °C mientras hay una referencia disponible y, con o
+ *  sin referencia, reescribe AGING cada vez que cambia la temperatura para
+ *  cancelarlo.
+ *
+ *  La tabla guarda la deriva del cristal con AGING = 0 (ppb, int16 por
+ *  cuarto de grado). Con referencia, cada ventana de DS3231_CalMeter mide el
+ *  error con el AGING vigente y la deriva es ppb + aging * sens_ppb; se
+ *  promedia exponencialmente en la celda de la temperatura media de la
+ *  ventana. Las celdas sin aprender se interpolan entre las vecinas.
+ *
+ *  DS3231_Drift_Poll(), desde el lazo principal, lee la temperatura cada
+ *  DS3231_DRIFT_PERIOD_MS (el período de la conversión automática del chip) y
+ *  al cerrar cada ventana. Si el AGING que corresponde a esa temperatura
+ *  difiere del vigente, lo escribe y fuerza una conversión para que el chip
+ *  lo aplique, igual que DS3231_Cal_Poll().
+ *
+ * @note
+ *  - La tabla vive en RAM (DS3231_DRIFT_BINS * 2 bytes, ~1 KB con el rango por
+ *    defecto). Para conservarla entre reinicios, la aplicación guarda
+ *    drift->table y la vuelve a copiar después de DS3231_Drift_Start().
+ *  - Fuera del rango aprendido la deriva se extiende constante desde la
+ *    última celda conocida; conviene aprender en todo el rango de operación.
+ *  - sens_ppb debe venir de una calibración (DS3231_CalRecord::sens_ppb):
+ *    la tabla queda expresada en ppb y no depende de ella, pero el AGING
+ *    calculado sí.
+ */
+
+#ifndef DS3231_DRIFT_H
+#define DS3231_DRIFT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ds3231.h"
+#include "ds3231_cal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup DS3231_DRIFT Modelo de deriva por temperatura
+ *  @{
+ */
+
+#ifndef DS3231_DRIFT_T_MIN_Q4
+#define DS3231_DRIFT_T_MIN_Q4       (-40 * 4)   /**< Celda más baja, en cuartos de °C. */
+#endif
+#ifndef DS3231_DRIFT_T_MAX_Q4
+#define DS3231_DRIFT_T_MAX_Q4       (85 * 4)    /**< Celda más alta, en cuartos de °C. */
+#endif
+#define DS3231_DRIFT_BINS           (DS3231_DRIFT_T_MAX_Q4 - DS3231_DRIFT_T_MIN_Q4 + 1)
+#define DS3231_DRIFT_EMPTY          (INT16_MIN) /**< Celda sin aprender. */
+#define DS3231_DRIFT_PERIOD_MS      (64000U)    /**< Lectura de temperatura sin referencia. */
+#define DS3231_DRIFT_LEARN_SHIFT    (2U)        /**< Promedio exponencial: peso 1/4 de cada ventana. */
+#define DS3231_DRIFT_LEARN_MAX_DQ4  (2)         /**< Variación máxima en una ventana para aprender (0.5 °C). */
+
+/**
+ * @brief Estado del modelo de deriva.
+ */
+typedef struct {
+    DS3231_Handle   *dev;           /**< Instancia del DS3231. */
+    int16_t          table[DS3231_DRIFT_BINS]; /**< Deriva con AGING = 0, en ppb (DS3231_DRIFT_EMPTY = sin dato). */
+    int32_t          sens_ppb;      /**< Sensibilidad de AGING (ppb por LSB). */
+
+    /* La ISR escribe meter solo mientras measuring == true. */
+    DS3231_CalMeter  meter;         /**< Ventana en curso (ref_hz = 0: sin referencia). */
+    volatile bool    measuring;     /**< Ventana abierta (no hay AGING pendiente de aplicar). */
+    bool             applying;      /**< AGING escrito, falta la conversión que lo aplica. */
+    DS3231_CalApply  apply;         /**< Conversión que aplica AGING. */
+
+    int16_t          temp_q4;       /**< Última temperatura leída. */
+    int16_t          window_temp_q4;/**< Temperatura al abrir la ventana. */
+    bool             temp_valid;    /**< temp_q4 leída al menos una vez (la primera abre la ventana). */
+    uint32_t         last_read_ms;  /**< Tick de la última lectura. */
+
+    int8_t           aging;         /**< AGING escrito en el chip. */
+    uint32_t         learned;       /**< Ventanas incorporadas a la tabla. */
+    uint32_t         updates;       /**< Escrituras de AGING por cambio de temperatura. */
+} DS3231_Drift;
+
+/**
+ * @brief Arranca el modelo con la tabla vacía.
+ *
+ * Lee el AGING actual y, con ref_hz != 0, habilita la salida elegida; la
+ * primera ventana se abre con la primera lectura de temperatura, en
+ * DS3231_Drift_Poll(). Con ref_hz = 0 solo compensa con la tabla, que la
+ * aplicación carga después de esta llamada.
+ *
+ * @param drift    Modelo a inicializar.
+ * @param dev      Instancia del DS3231.
+ * @param source   Salida usada como evento de 1 s (ignorada con ref_hz = 0).
+ * @param ref_hz   Frecuencia del contador de referencia, 0 = sin referencia.
+ * @param sens_ppb Sensibilidad de AGING en ppb por LSB (0 = DS3231_CAL_SENS_PPB).
+ * @return DS3231_OK si funciono correctamente.
+ */
+DS3231_Status DS3231_Drift_Start(DS3231_Drift *drift, DS3231_Handle *dev, DS3231_CalSource source,
+                                 uint32_t ref_hz, int32_t sens_ppb);
+
+/**
+ * @brief Incorpora una medición a la tabla.
+ * @param drift   Modelo.
+ * @param temp_q4 Temperatura de la medición, en cuartos de °C.
+ * @param ppb     Error medido (positivo = el RTC adelanta).
+ * @param aging   AGING vigente durante la medición.
+ */
+void DS3231_Drift_Learn(DS3231_Drift *drift, int16_t temp_q4, int32_t ppb, int8_t aging);
+
+/**
+ * @brief Deriva estimada a una temperatura.
+ * @param drift   Modelo.
+ * @param temp_q4 Temperatura en cuartos de °C (se satura al rango de la tabla).
+ * @param ppb     Deriva con AGING = 0, interpolada entre las celdas aprendidas.
+ * @return DS3231_OK; DS3231_NOT_READY si la tabla está vacía.
+ */
+DS3231_Status DS3231_Drift_Lookup(const DS3231_Drift *drift, int16_t temp_q4, int32_t *ppb);
+
+/**
+ * @brief Registra un evento del RTC. Llamar desde la ISR de captura.
+ * @param drift     Modelo.
+ * @param ref_ticks Valor del contador de referencia capturado en el evento.
+ */
+void DS3231_Drift_OnEvent(DS3231_Drift *drift, uint32_t ref_ticks);
+
+/**
+ * @brief Aprende, lee la temperatura y corrige AGING; llamar desde el lazo principal.
+ *
+ * Solo accede al bus al cerrar una ventana, cada DS3231_DRIFT_PERIOD_MS y
+ * mientras espera la conversión que aplica un AGING nuevo.
+ *
+ * @param drift  Modelo.
+ * @param now_ms Tick actual en ms.
+ * @return DS3231_OK mientras avanza; el error de bus en otro caso.
+ */
+DS3231_Status DS3231_Drift_Poll(DS3231_Drift *drift, uint32_t now_ms);
+
+/** @} */ // end group DS3231_DRIFT
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DS3231_DRIFT_H */
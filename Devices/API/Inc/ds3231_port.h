@@ -2,13 +2,25 @@
  * @file    ds3231_port.h
  * @brief   Driver del RTC DS3231 utilizando dev_i2cm.
  * @details
- *  API utilizada para leer y escribir registros del RTC DS3231.
+ *  API utilizada para leer y escribir registros del RTC DS3231. El acceso al
+ *  bus se hace a través de un DS3231_Transport intercambiable:
+ *  - DS3231_Transport_HAL: dev_i2cm (HAL, con variantes IT/DMA). Por defecto
+ *    en el target; en host (I2CM_HOST_SIM) el por defecto es el simulador.
+ *    El DS3231 se registra en dev_i2cm al primer acceso y sus lecturas
+ *    asíncronas comparten el planificador con el resto de los dispositivos.
+ *  - DS3231_Transport_LL:  dev_i2cm_ll (polling sobre LL, sin async).
+ *  - DS3231_Transport_Sim: DS3231 simulado en memoria (ds3231_sim.h).
+ *
+ *  Un DS3231_Port agrupa transporte, bus y dirección de un chip; las funciones
+ *  DS3231_port_* reciben el puerto y las DS3231_register_* usan el puerto por
+ *  defecto (DS3231_port_set_transport).
  */
 
 #ifndef DS3231_PORT_H
 #define DS3231_PORT_H
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "dev_i2cm.h"
 
 #ifdef __cplusplus
@@ -25,6 +37,151 @@ extern "C" {
 /**< Cantidad de reintentos en I2CM_IsDeviceReady */
 #define DS3231_RETRY_COUNT      (3)     
 
+/** Velocidad de SCL con la que se registra el DS3231 en dev_i2cm (Fast-mode) */
+#define DS3231_I2C_SPEED_HZ     (400000)
+
+/**
+ * @brief Operaciones de transporte usadas por el driver.
+ *
+ * @p bus es el contexto propio del backend (periférico, instancia simulada,
+ * etc.). Las operaciones asíncronas son opcionales: NULL si el backend no
+ * las soporta, en cuyo caso el driver retorna error al usarlas.
+ */
+typedef struct {
+    /** Escribe @p len bytes (el primero es la dirección del registro). */
+    HAL_StatusTypeDef (*write)(void *bus, uint8_t address, uint8_t *data, uint16_t len);
+    /** Lee @p len bytes a partir del registro @p reg (repeated start). */
+    HAL_StatusTypeDef (*read_reg)(void *bus, uint8_t address, uint8_t reg, uint8_t *data, uint16_t len);
+    /** Verifica que el esclavo responda al address. */
+    HAL_StatusTypeDef (*is_ready)(void *bus, uint8_t address, uint32_t trials);
+    /** Opcional: lectura no bloqueante por interrupción. */
+    HAL_StatusTypeDef (*read_reg_async)(void *bus, uint8_t address, uint8_t reg, uint8_t *data, uint16_t len,
+                                        I2CM_Callback cb, void *ctx);
+    /** Opcional: lectura no bloqueante por DMA. */
+    HAL_StatusTypeDef (*read_reg_dma)(void *bus, uint8_t address, uint8_t reg, uint8_t *data, uint16_t len,
+                                      I2CM_Callback cb, void *ctx);
+    /** Opcional: true mientras haya una transferencia asíncrona en curso hacia @p address. */
+    bool (*async_busy)(void *bus, uint8_t address);
+} DS3231_Transport;
+
+/**
+ * @brief Puerto de acceso a un DS3231: transporte, contexto del bus y dirección.
+ */
+typedef struct {
+    const DS3231_Transport *transport;  /**< Operaciones del backend. */
+    void    *bus;                       /**< Contexto del backend. */
+    uint8_t  address;                   /**< Dirección 7-bit del esclavo. */
+} DS3231_Port;
+
+extern const DS3231_Transport DS3231_Transport_HAL;   /**< dev_i2cm; bus = I2C_HandleTypeDef * (NULL = hi2c1). */
+#ifndef I2CM_HOST_SIM
+extern const DS3231_Transport DS3231_Transport_LL;    /**< dev_i2cm_ll sobre I2C1. */
+#endif
+
+/**
+ * @brief  Inicializa un puerto.
+ * @param  port       Puerto a inicializar.
+ * @param  transport  Operaciones del backend (NULL = transporte por defecto).
+ * @param  bus        Contexto del backend.
+ * @param  address    Dirección 7-bit (normalmente DS3231_ADDRESS).
+ */
+void DS3231_port_init(DS3231_Port *port, const DS3231_Transport *transport, void *bus, uint8_t address);
+
+/**
+ * @brief  Devuelve el puerto que usan las funciones sin puerto explícito.
+ */
+const DS3231_Port *DS3231_port_default(void);
+
+/**
+ * @brief  Indica si hay una lectura asíncrona en curso en el puerto.
+ */
+bool DS3231_port_busy(const DS3231_Port *port);
+
+/**
+ * @brief  Verifica la presencia del DS3231 en el puerto.
+ * @return HAL_OK si responde al address.
+ */
+HAL_StatusTypeDef DS3231_port_is_ready(const DS3231_Port *port);
+
+/**
+ * @brief  Escribe un registro del DS3231.
+ * @param  port  Puerto.
+ * @param  reg   Dirección del registro.
+ * @param  data  Dato a escribir.
+ * @return HAL_OK si funciono correctamente.
+ */
+HAL_StatusTypeDef DS3231_port_write(const DS3231_Port *port, uint8_t reg, uint8_t data);
+
+/**
+ * @brief  Escribe un bloque (el primer byte es la dirección del registro).
+ * @param  port  Puerto.
+ * @param  data  Puntero al bloque de datos a escribir.
+ * @param  len   Longitud del bloque de datos.
+ * @return HAL_OK si funciono correctamente.
+ */
+HAL_StatusTypeDef DS3231_port_block_write(const DS3231_Port *port, uint8_t *data, uint16_t len);
+
+/**
+ * @brief  Lee un registro del DS3231.
+ * @param  port  Puerto.
+ * @param  reg   Dirección del registro.
+ * @param  data  Puntero de salida (1 byte).
+ * @return HAL_OK si funciono correctamente.
+ */
+HAL_StatusTypeDef DS3231_port_read(const DS3231_Port *port, uint8_t reg, uint8_t *data);
+
+/**
+ * @brief  Lee un bloque de registros.
+ * @param  port  Puerto.
+ * @param  reg   Dirección del registro donde se comienza a leer.
+ * @param  data  Puntero de salida.
+ * @param  len   Cantidad de registros a leer.
+ * @return HAL_OK si funciono correctamente.
+ */
+HAL_StatusTypeDef DS3231_port_block_read(const DS3231_Port *port, uint8_t reg, uint8_t *data, uint16_t len);
+
+/**
+ * @brief  Lee un bloque de registros sin bloquear.
+ * @param  port  Puerto.
+ * @param  reg   Dirección del registro donde se comienza a leer.
+ * @param  data  Puntero de salida, debe permanecer válido hasta el callback.
+ * @param  len   Cantidad de registros a leer.
+ * @param  cb    Callback de finalización (contexto de interrupción).
+ * @param  ctx   Contexto de usuario para el callback.
+ * @return HAL_OK si la transferencia se inició.
+ */
+HAL_StatusTypeDef DS3231_port_block_read_async(const DS3231_Port *port, uint8_t reg, uint8_t *data, uint16_t len,
+                                               I2CM_Callback cb, void *ctx);
+
+/**
+ * @brief  Lee un bloque de registros por DMA.
+ * @param  port  Puerto.
+ * @param  reg   Dirección del registro donde se comienza a leer.
+ * @param  data  Puntero de salida, debe permanecer válido hasta el callback.
+ * @param  len   Cantidad de registros a leer.
+ * @param  cb    Callback de finalización (contexto de interrupción).
+ * @param  ctx   Contexto de usuario para el callback.
+ * @return HAL_OK si la transferencia se inició.
+ */
+HAL_StatusTypeDef DS3231_port_block_read_dma(const DS3231_Port *port, uint8_t reg, uint8_t *data, uint16_t len,
+                                             I2CM_Callback cb, void *ctx);
+
+/* -------------------------------------------------------------------------- */
+/* Puerto por defecto                                                          */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Selecciona el transporte del puerto por defecto.
+ * @param  transport  Operaciones del backend (NULL restaura el de por defecto).
+ * @param  bus        Contexto del backend.
+ */
+void DS3231_port_set_transport(const DS3231_Transport *transport, void *bus);
+
+/**
+ * @brief  Indica si hay una lectura asíncrona en curso en el puerto por defecto.
+ */
+bool DS3231_port_async_busy(void);
+
 /**
  * @brief  Verifica la presencia del RTC DS3231 en el bus I2C.
  * @return Retorna HAL_OK si responde al address 0x68.
@@ -64,10 +221,34 @@ HAL_StatusTypeDef DS3231_register_read(uint8_t reg, uint8_t *data);
  */
 HAL_StatusTypeDef DS3231_register_block_read(uint8_t reg, uint8_t *data, uint16_t len);
 
+/**
+ * @brief  Lee un bloque de registros del DS3231 sin bloquear.
+ * @param  reg   Dirección del registro donde se comienza a leer.
+ * @param  data  Puntero de salida, debe permanecer válido hasta el callback.
+ * @param  len   Cantidad de registros a leer.
+ * @param  cb    Callback de finalización (contexto de interrupción).
+ * @param  ctx   Contexto de usuario para el callback.
+ * @return HAL_OK si la transferencia se inició.
+ */
+HAL_StatusTypeDef DS3231_register_block_read_async(uint8_t reg, uint8_t *data, uint16_t len,
+                                                   I2CM_Callback cb, void *ctx);
+
+/**
+ * @brief  Lee un bloque de registros del DS3231 por DMA.
+ * @param  reg   Dirección del registro donde se comienza a leer.
+ * @param  data  Puntero de salida, debe permanecer válido hasta el callback.
+ * @param  len   Cantidad de registros a leer.
+ * @param  cb    Callback de finalización (contexto de interrupción).
+ * @param  ctx   Contexto de usuario para el callback.
+ * @return HAL_OK si la transferencia se inició.
+ */
+HAL_StatusTypeDef DS3231_register_block_read_dma(uint8_t reg, uint8_t *data, uint16_t len,
+                                                 I2CM_Callback cb, void *ctx);
+
 /** @} */ // end group DS3231_PORT
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif /* DS3231_PORT_H */
\ No newline at end of file
+#endif /* DS3231_PORT_H */
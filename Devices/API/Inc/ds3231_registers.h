@@ -23,6 +23,7 @@ extern "C" {
 #define DS3231_ALARM1_BUF_SIZE   (4)
 #define DS3231_ALARM2_BUF_SIZE   (3)
 #define DS3231_TEMP_BUF_SIZE     (2)
+#define DS3231_REG_MAP_SIZE      (19)   /**< Mapa completo: 0x00 (SECONDS) .. 0x12 (TEMP_LSB) */
 
 /* -------------------------------------------------------------------------- */
 /* Direcciones de Registros del DS3231                                        */
@@ -45,6 +46,19 @@ extern "C" {
 #define DS3231_REG_TEMP_MSB      (0x11)  /**< Temperatura MSB */
 #define DS3231_REG_TEMP_LSB      (0x12)  /**< Temperatura LSB */
 
+/* -------------------------------------------------------------------------- */
+/* Bits de los registros de tiempo (0x00..0x06)                               */
+/* -------------------------------------------------------------------------- */
+#define DS3231_HOURS_12H         (1 << 6)  /**< Horas: 1 = formato 12 h, 0 = 24 h */
+#define DS3231_HOURS_PM          (1 << 5)  /**< Horas en 12 h: 1 = PM (en 24 h es el bit de decena 20) */
+#define DS3231_MONTH_CENTURY     (1 << 7)  /**< Siglo: se invierte al pasar el año de 99 a 00 */
+
+/* -------------------------------------------------------------------------- */
+/* Bits de los registros de Alarma (0x07..0x0D)                               */
+/* -------------------------------------------------------------------------- */
+#define DS3231_ALARM_AXM         (1 << 7)  /**< AxMn: 1 = el campo no se compara */
+#define DS3231_ALARM_DYDT        (1 << 6)  /**< Registro día/fecha: 1 = día de semana, 0 = fecha */
+
 /* -------------------------------------------------------------------------- */
 /* Bit Map del Registro de Control (0x0E)                                     */
 /* -------------------------------------------------------------------------- */
@@ -72,6 +86,9 @@ extern "C" {
 #define DS3231_STATUS_A2F        (1 << 1)  /**< Flag de la Alarma 2. */
 #define DS3231_STATUS_A1F        (1 << 0)  /**< Flag de la Alarma 1. */
 
+/** Bits de STATUS que modifica el propio hardware (nunca se cachean). */
+#define DS3231_STATUS_VOLATILE   (DS3231_STATUS_OSF | DS3231_STATUS_BSY | DS3231_STATUS_A2F | DS3231_STATUS_A1F)
+
 /** @} */ // end of group DS3231_Registers
 
 #ifdef __cplusplus
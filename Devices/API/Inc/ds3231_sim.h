@@ -0,0 +1,215 @@
+/**
+ * @file    ds3231_sim.h
+ * @brief   DS3231 simulado en memoria, para builds de host.
+ * @details
+ *  Implementa un DS3231_Transport sobre un modelo del mapa de registros, de
+ *  modo que el driver completo (ds3231.c) pueda ejecutarse y medirse sin
+ *  hardware. El modelo reproduce:
+ *  - Puntero de registro con auto-incremento y vuelta de 0x12 a 0x00.
+ *  - Calendario BCD que avanza con un reloj virtual (12/24 h, bisiestos cada
+ *    4 años como el chip, bit de siglo en DS3231_REG_MONTH).
+ *  - Reinicio de la cadena de cuenta al escribir DS3231_REG_SECONDS.
+ *  - Conversión de temperatura (BSY/CONV, ~200 ms, automática cada 64 s).
+ *  - OSF tras una pérdida de alimentación, flags de alarma con sus máscaras.
+ *  - Semántica de escritura de STATUS (BSY solo lectura, flags solo a 0).
+ *  - Error de frecuencia del oscilador: el segundo del chip dura
+ *    1 s / (1 + ppb·1e-9) de tiempo real. El registro AGING lo corrige a
+ *    razón de aging_ppb por LSB (valor positivo = más lento) y, como en el
+ *    chip, recién se aplica al terminar la siguiente conversión. Opcionalmente,
+ *    un residuo parabólico de la compensación de temperatura (tc_ppb).
+ *  Cuenta transacciones, START/STOP y bytes para modelar el tiempo de bus.
+ *  Opcionalmente (DS3231_Sim_SetBusSpeed) cada transacción también consume
+ *  ese tiempo en el reloj virtual y cada registro se escribe en el ACK de su
+ *  byte, como en el chip.
+ *
+ *  El reloj virtual solo avanza con DS3231_Sim_Advance(), lo que permite
+ *  simular un año de operación en segundos de CPU.
+ *
+ * @note Solo para host: ds3231_sim.c está excluido del build del firmware.
+ */
+
+#ifndef DS3231_SIM_H
+#define DS3231_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ds3231_registers.h"
+#include "ds3231_port.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup DS3231_SIM DS3231 simulado
+ *  @{
+ */
+
+#define DS3231_SIM_CONV_US        (200000U)     /**< Duración de una conversión de temperatura. */
+#define DS3231_SIM_TCXO_PERIOD_S  (64U)         /**< Período de la conversión automática. */
+#define DS3231_SIM_AGING_PPB      (100)         /**< Efecto típico de 1 LSB de AGING a 25 °C (0.1 ppm). */
+
+#define DS3231_SIM_SCL_100KHZ     (100000U)     /**< Standard mode. */
+#define DS3231_SIM_SCL_400KHZ     (400000U)     /**< Fast mode. */
+#define DS3231_SIM_SCL_1MHZ       (1000000U)    /**< Fast mode plus (referencia). */
+
+/**
+ * @brief Eventos de salida del pin INT/SQW.
+ */
+typedef enum {
+    DS3231_SIM_EDGE_SQW = 0,    /**< Flanco de segundo de la SQW de 1 Hz (INTCN = 0). */
+    DS3231_SIM_EDGE_INT,        /**< Interrupción de alarma (INTCN = 1 y AxIE). */
+    DS3231_SIM_EDGE_32KHZ,      /**< 32768 ciclos de la salida de 32 kHz (EN32KHZ = 1), como los cuenta un timer. */
+} DS3231_SimEdge;
+
+/**
+ * @brief Callback de eventos del pin INT/SQW.
+ * @param edge Tipo de evento.
+ * @param ctx  Contexto de usuario.
+ */
+typedef void (*DS3231_SimEdgeCallback)(DS3231_SimEdge edge, void *ctx);
+
+/**
+ * @brief Contadores de uso del bus.
+ */
+typedef struct {
+    uint32_t transactions;  /**< Transacciones START..STOP. */
+    uint32_t starts;        /**< Condiciones START y repeated START. */
+    uint32_t stops;         /**< Condiciones STOP. */
+    uint32_t bytes;         /**< Bytes en el bus, incluidas las direcciones. */
+} DS3231_SimStats;
+
+/**
+ * @brief Estado de un DS3231 simulado.
+ */
+typedef struct {
+    uint8_t  regs[DS3231_REG_MAP_SIZE]; /**< Mapa de registros 0x00..0x12. */
+    uint8_t  ptr;                       /**< Puntero interno de registro. */
+    bool     present;                   /**< false: no responde (NACK). */
+    DS3231_SimStats stats;              /**< Contadores de bus. */
+
+    uint64_t now_us;                    /**< Tiempo virtual total. */
+    uint32_t subsec_us;                 /**< Posición dentro del segundo actual. */
+    uint32_t conv_left_us;              /**< Tiempo restante de conversión (0 = inactiva). */
+    uint32_t tcxo_left_s;               /**< Segundos hasta la conversión automática. */
+    int16_t  temp_q2;                   /**< Temperatura del modelo, en cuartos de °C. */
+
+    int32_t  ppb;                       /**< Error del cristal sin corregir (positivo = adelanta). */
+    int16_t  aging_ppb;                 /**< Corrección por LSB de AGING (DS3231_SIM_AGING_PPB). */
+    int16_t  tc_ppb;                    /**< Curvatura residual del TCXO (ppb/°C², vértice en 25 °C). */
+    int8_t   aging_applied;             /**< AGING vigente (latcheado en cada conversión). */
+    uint32_t frac;                      /**< Resto de tiempo del chip, en 1e-9 µs. */
+    uint32_t scl_hz;                    /**< Tiempo de bus en el reloj virtual (0 = transacciones instantáneas). */
+    uint32_t bus_ns;                    /**< Resto de tiempo de bus menor a 1 µs. */
+
+    DS3231_SimEdgeCallback on_edge;     /**< Eventos INT/SQW (puede ser NULL). */
+    void    *edge_ctx;                  /**< Contexto de on_edge. */
+} DS3231_Sim;
+
+/** Transporte que opera sobre un DS3231_Sim (bus = DS3231_Sim *, NULL = instancia por defecto). */
+extern const DS3231_Transport DS3231_Transport_Sim;
+
+/**
+ * @brief Inicializa el simulador con los valores de power-on del DS3231.
+ * @param sim Instancia a inicializar.
+ */
+void DS3231_Sim_Init(DS3231_Sim *sim);
+
+/**
+ * @brief Pone en cero los contadores de bus.
+ * @param sim Instancia.
+ */
+void DS3231_Sim_ResetCounters(DS3231_Sim *sim);
+
+/**
+ * @brief Instancia usada cuando el transporte se selecciona con bus = NULL.
+ */
+DS3231_Sim *DS3231_Sim_Default(void);
+
+/**
+ * @brief Avanza el reloj virtual.
+ *
+ * Procesa cada cambio de segundo (calendario, alarmas, SQW) y el avance de
+ * las conversiones de temperatura.
+ *
+ * @param sim Instancia.
+ * @param us  Microsegundos a avanzar.
+ */
+void DS3231_Sim_Advance(DS3231_Sim *sim, uint64_t us);
+
+/**
+ * @brief Simula un corte de alimentación principal.
+ *
+ * Con batería y EOSC = 0 el oscilador sigue contando. Con EOSC = 1 el
+ * oscilador se detiene y se activa OSF. Sin batería se pierde el contenido
+ * de los registros (valores de power-on, OSF = 1).
+ *
+ * @param sim       Instancia.
+ * @param outage_us Duración del corte.
+ * @param battery   true si VBAT está presente.
+ */
+void DS3231_Sim_PowerLoss(DS3231_Sim *sim, uint64_t outage_us, bool battery);
+
+/**
+ * @brief Fija la temperatura que medirá la próxima conversión.
+ * @param sim     Instancia.
+ * @param temp_q2 Temperatura en cuartos de °C.
+ */
+void DS3231_Sim_SetTemperature(DS3231_Sim *sim, int16_t temp_q2);
+
+/**
+ * @brief Fija el error de frecuencia del cristal, antes de la corrección de AGING.
+ * @param sim Instancia.
+ * @param ppb Error en partes por mil millones (positivo = el chip adelanta).
+ */
+void DS3231_Sim_SetFrequencyError(DS3231_Sim *sim, int32_t ppb);
+
+/**
+ * @brief Fija el residuo de temperatura del oscilador.
+ *
+ * El error del cristal pasa a ser ppb - tc_ppb * (T - 25 °C)^2, con T la
+ * temperatura del modelo en cada instante (no la última convertida).
+ *
+ * @param sim    Instancia.
+ * @param tc_ppb Curvatura en ppb/°C² (0 = sin dependencia de temperatura).
+ */
+void DS3231_Sim_SetTempCoefficient(DS3231_Sim *sim, int16_t tc_ppb);
+
+/**
+ * @brief Hace que las transacciones consuman tiempo del reloj virtual.
+ *
+ * Cada byte ocupa 9 ciclos de SCL y cada START o STOP uno (igual que
+ * DS3231_Sim_BusTimeNs). En una escritura, cada registro toma su valor en el
+ * ACK de su byte; en una lectura, los registros se copian al START, como el
+ * buffer secundario del chip. Los callbacks de flancos pueden ejecutarse
+ * dentro de una transacción.
+ *
+ * @param sim    Instancia.
+ * @param scl_hz Frecuencia de SCL (0 = transacciones instantáneas, por defecto).
+ */
+void DS3231_Sim_SetBusSpeed(DS3231_Sim *sim, uint32_t scl_hz);
+
+/**
+ * @brief Error de frecuencia efectivo: cristal menos la corrección de AGING vigente.
+ * @param sim Instancia.
+ * @return Error en ppb (positivo = el chip adelanta).
+ */
+int32_t DS3231_Sim_FrequencyError(const DS3231_Sim *sim);
+
+/**
+ * @brief Tiempo de bus modelado para los contadores actuales.
+ *
+ * Cada byte ocupa 9 ciclos de SCL (8 bits + ACK) y cada START o STOP uno.
+ *
+ * @param sim    Instancia.
+ * @param scl_hz Frecuencia de SCL (p.ej. DS3231_SIM_SCL_400KHZ).
+ * @return Tiempo de bus en nanosegundos.
+ */
+uint64_t DS3231_Sim_BusTimeNs(const DS3231_Sim *sim, uint32_t scl_hz);
+
+/** @} */ // end group DS3231_SIM
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DS3231_SIM_H */
@@ -0,0 +1,118 @@
+/**
+ * @file    ds3231_slew.h
+ * @brief   Corrección de fase sub-segundo del DS3231 por AGING (slew).
+ * @details
+ *  Escribir la hora (DS3231_SetTime, DS3231_AdjustTime con segundos) reinicia
+ *  la cadena de cuenta del chip: la fase salta y se pierde la fracción del
+ *  segundo en curso. Para correcciones menores a un segundo, este módulo
+ *  desvía AGING en @p lsb pasos durante el tiempo justo para que el oscilador
+ *  acumule la corrección pedida, y después lo restaura. La hora nunca salta:
+ *  los flancos de la SQW solo se adelantan o atrasan gradualmente.
+ *
+ *  Con la sensibilidad típica (~0.1 ppm por LSB) y el desvío por defecto
+ *  (DS3231_SLEW_LSB = 64, ~6.4 ppm), 1 ms se corrige en unos 156 s.
+ *
+ *  El chip recién aplica AGING al terminar una conversión de temperatura, así
+ *  que cada cambio fuerza una (DS3231_ConvertTemperatureAsync). La espera se
+ *  cuenta desde que la primera terminó, y el AGING original se escribe antes
+ *  de tiempo por la latencia medida de esa conversión, de modo que la segunda
+ *  termine cuando vence el slew.
+ *
+ * @note
+ *  - No usar junto con ds3231_cal o ds3231_drift en el mismo chip: los tres
+ *    escriben AGING.
+ *  - Si al escribir AGING hay una conversión automática en curso, es ella la
+ *    que lo aplica: al arrancar se cuenta desde su fin (visto en el Poll
+ *    siguiente); al restaurar, el slew termina antes de tiempo. El error es a
+ *    lo sumo el desvío por la duración de una conversión (~1.3 µs con 6.4 ppm
+ *    y 200 ms), y solo si la escritura cae en una de cada ~320 ventanas.
+ */
+
+#ifndef DS3231_SLEW_H
+#define DS3231_SLEW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ds3231.h"
+#include "ds3231_cal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup DS3231_SLEW Corrección de fase por AGING
+ *  @{
+ */
+
+#define DS3231_SLEW_LSB             (64U)       /**< Desvío de AGING por defecto (~6.4 ppm). */
+#define DS3231_SLEW_MAX_US          (999999)    /**< Corrección máxima; los segundos enteros van por DS3231_AdjustTime. */
+
+/**
+ * @brief Estado del slew.
+ */
+typedef enum {
+    DS3231_SLEW_IDLE = 0,       /**< Sin iniciar. */
+    DS3231_SLEW_APPLYING,       /**< AGING desviado escrito, falta la conversión que lo aplica. */
+    DS3231_SLEW_RUNNING,        /**< Oscilador desviado hasta restore_ms. */
+    DS3231_SLEW_RESTORING,      /**< AGING original escrito, falta la conversión que lo aplica. */
+    DS3231_SLEW_DONE,           /**< Corrección aplicada. */
+} DS3231_SlewState;
+
+/**
+ * @brief Estado de una corrección por slew.
+ */
+typedef struct {
+    DS3231_Handle   *dev;           /**< Instancia del DS3231. */
+    DS3231_SlewState state;         /**< Estado actual. */
+    int8_t           base_aging;    /**< AGING a restaurar. */
+    int8_t           slew_aging;    /**< AGING durante el slew. */
+    int32_t          offset_us;     /**< Corrección pedida (positivo = adelantar el chip). */
+    int32_t          rate_ppb;      /**< Desvío de frecuencia durante el slew (mismo signo que offset_us). */
+    uint32_t         duration_ms;   /**< Tiempo con el oscilador desviado. */
+    uint32_t         restore_ms;    /**< Tick en que se escribe el AGING original. */
+    DS3231_CalApply  apply;         /**< Conversión que aplica AGING (conv_ms: inicio efectivo). */
+    bool             applied;       /**< La conversión en curso terminó bien (lo procesa Poll). */
+} DS3231_Slew;
+
+/**
+ * @brief Inicia una corrección de fase por AGING.
+ *
+ * Lee el AGING actual, escribe el desviado y fuerza la conversión que lo
+ * aplica. Con offset_us = 0 no accede al bus y termina en el acto.
+ *
+ * @param slew      Estado a inicializar.
+ * @param dev       Instancia del DS3231.
+ * @param offset_us Corrección en µs (positivo = el chip atrasa y debe adelantar),
+ *                  |offset_us| <= DS3231_SLEW_MAX_US.
+ * @param sens_ppb  Sensibilidad de AGING en ppb por LSB (0 = DS3231_CAL_SENS_PPB;
+ *                  conviene la de DS3231_CalRecord::sens_ppb).
+ * @param lsb       Desvío de AGING (1..127, 0 = DS3231_SLEW_LSB); se recorta si
+ *                  el AGING actual no deja margen.
+ * @param now_ms    Tick actual en ms.
+ * @return DS3231_OK si arrancó; DS3231_INVALID_PARAM si la corrección excede
+ *         DS3231_SLEW_MAX_US o AGING no tiene margen en ese sentido.
+ */
+DS3231_Status DS3231_Slew_Start(DS3231_Slew *slew, DS3231_Handle *dev, int32_t offset_us,
+                                int32_t sens_ppb, uint8_t lsb, uint32_t now_ms);
+
+/**
+ * @brief Avanza la corrección; llamar desde el lazo principal.
+ *
+ * Solo accede al bus mientras espera una conversión y al restaurar AGING.
+ * La resolución es la del período de llamada por el desvío (1 ms con
+ * 6.4 ppm: 6.4 ns).
+ *
+ * @param slew   Estado.
+ * @param now_ms Tick actual en ms.
+ * @return DS3231_OK mientras avanza o al terminar (state == DS3231_SLEW_DONE);
+ *         el error de bus en otro caso (se reintenta en la próxima llamada).
+ */
+DS3231_Status DS3231_Slew_Poll(DS3231_Slew *slew, uint32_t now_ms);
+
+/** @} */ // end group DS3231_SLEW
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DS3231_SLEW_H */
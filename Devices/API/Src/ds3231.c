@@ -4,6 +4,9 @@
  */
 
 #include "ds3231.h"
+#include "ds3231_bcd.h"
+#include "dev_prof.h"
+#include <string.h>
 
 /* -------------------------------------------------------------------------- */
 /*  API pública                                                               */
@@ -21,133 +24,991 @@ static DS3231_Status DS3231_parse_hal_status(HAL_StatusTypeDef hal_status)
     }
 }
 
+/* Decodifica el bloque de 7 registros de tiempo (0x00..0x06), ver ds3231_bcd.h. */
+static void DS3231_decode_time(const uint8_t *buf, DS3231_Time *time)
+{
+    DS3231_bcd_decode_time(buf, time);
+}
+
+/** - Conversion de valores a grados celsius.
+*   El MSB contiene la parte entera con signo.
+*   Los 2 bits altos del LSB contienen la fracción en pasos de 0.25°C.
+*   Con DS3231_NO_FLOAT se entregan los cuartos de grado sin escalar.
+*/
+static DS3231_Temp DS3231_decode_temp(const uint8_t *buf)
+{
+#ifdef DS3231_NO_FLOAT
+    return DS3231_temp_q4(buf[0], buf[1]);
+#else
+    return DS3231_temp_q4(buf[0], buf[1]) * 0.25f;
+#endif
+}
+
+/* Decodifica una alarma. La Alarma 2 no tiene registro de segundos. */
+static void DS3231_decode_alarm(const uint8_t *buf, bool has_seconds, DS3231_Alarm *alarm)
+{
+    uint8_t i = 0;
+
+    alarm->mask    = 0;
+    alarm->seconds = 0;
+    if (has_seconds) {
+        alarm->seconds = bcd2dec(buf[i] & 0x7F);
+        alarm->mask   |= (buf[i] >> 7) & 0x01;
+        i++;
+    }
+    alarm->minutes = bcd2dec(buf[i] & 0x7F);
+    alarm->mask   |= ((buf[i] >> 7) & 0x01) << 1;
+    i++;
+    alarm->hours   = DS3231_hours24_lut[buf[i] & 0x7F];
+    alarm->mask   |= ((buf[i] >> 7) & 0x01) << 2;
+    i++;
+    alarm->dy       = (buf[i] & 0x40) != 0;
+    alarm->day_date = alarm->dy ? (uint8_t)(buf[i] & 0x07) : bcd2dec(buf[i] & 0x3F);
+    alarm->mask    |= ((buf[i] >> 7) & 0x01) << 3;
+}
+
+/*
+ * Codifica una alarma (inversa de DS3231_decode_alarm), con las horas en @p mode.
+ * DS3231_alarm_valid no acota los campos enmascarados: se escriben en 0.
+ */
+static void DS3231_encode_alarm(const DS3231_Alarm *alarm, bool has_seconds, DS3231_HourMode mode, uint8_t *buf)
+{
+    uint8_t seconds  = (alarm->mask & 0x01) ? 0 : alarm->seconds;
+    uint8_t minutes  = (alarm->mask & 0x02) ? 0 : alarm->minutes;
+    uint8_t hours    = (alarm->mask & 0x04) ? 0 : alarm->hours;
+    uint8_t day_date = (alarm->mask & 0x08) ? 0 : alarm->day_date;
+    uint8_t i = 0;
+
+    if (has_seconds) {
+        buf[i++] = (uint8_t)(dec2bcd(seconds) | ((alarm->mask & 0x01) ? DS3231_ALARM_AXM : 0));
+    }
+    buf[i++] = (uint8_t)(dec2bcd(minutes) | ((alarm->mask & 0x02) ? DS3231_ALARM_AXM : 0));
+    buf[i++] = (uint8_t)(DS3231_bcd_hours_reg(hours, mode) | ((alarm->mask & 0x04) ? DS3231_ALARM_AXM : 0));
+    buf[i]   = alarm->dy ? (uint8_t)(DS3231_ALARM_DYDT | (day_date & 0x07)) : dec2bcd(day_date);
+    buf[i]  |= (alarm->mask & 0x08) ? DS3231_ALARM_AXM : 0;
+}
+
+/*
+ * Valida el modo y los campos que el modo compara. Los modos válidos enmascaran
+ * siempre los campos menos significativos primero: AxM4..AxM1 = 1111, 1110,
+ * 1100, 1000, 0000 (en la Alarma 2 AxM1 no existe).
+ */
+static bool DS3231_alarm_valid(const DS3231_Alarm *alarm, bool has_seconds)
+{
+    uint8_t cmp  = (uint8_t)(~alarm->mask & 0x0F);  // Campos que se comparan.
+    uint8_t bits = has_seconds ? cmp : (uint8_t)(cmp >> 1);
+
+    if (!has_seconds) cmp &= 0x0E;
+    if (bits & (bits + 1)) return false;
+
+    if ((cmp & 0x01) && alarm->seconds > 59) return false;
+    if ((cmp & 0x02) && alarm->minutes > 59) return false;
+    if ((cmp & 0x04) && alarm->hours > 23)   return false;
+    if (cmp & 0x08) {
+        if (alarm->dy  && (alarm->day_date < 1 || alarm->day_date > 7))  return false;
+        if (!alarm->dy && (alarm->day_date < 1 || alarm->day_date > 31)) return false;
+    }
+    return true;
+}
+
+/** -------------------------------------------------------------------------- 
+* Instancias: cada handle tiene su puerto, su cache y sus buffers asincronicos.
+* La instancia por defecto usa el puerto por defecto de ds3231_port, de modo
+* que DS3231_port_set_transport sigue aplicando a la API sin handle.
+* ---------------------------------------------------------------------------- 
+*/
+static DS3231_Handle ds3231_default = { .snap = { .held = DS3231_SNAP_NONE } };
+
+DS3231_Status DS3231_HandleInit(DS3231_Handle *dev, const DS3231_Transport *transport,
+                                void *bus, uint8_t address)
+{
+    if (!dev) return DS3231_INVALID_PARAM;
+
+    memset(dev, 0, sizeof(*dev));
+    DS3231_port_init(&dev->port_cfg, transport, bus, address);
+    dev->port      = &dev->port_cfg;
+    dev->snap.held = DS3231_SNAP_NONE;
+    return DS3231_OK;
+}
+
+DS3231_Handle *DS3231_DefaultHandle(void)
+{
+    if (!ds3231_default.port) {
+        ds3231_default.port = DS3231_port_default();
+    }
+    return &ds3231_default;
+}
+
+/** -------------------------------------------------------------------------- 
+* Cache espejo (write-through) de CONTROL, STATUS y AGING. Las operaciones de
+* read-modify-write parten del valor cacheado y cuestan una sola escritura.
+* Los bits que cambia el propio hardware (DS3231_STATUS_VOLATILE y CONV) no
+* se cachean: se escriben de forma que no alteren su valor actual.
+* ---------------------------------------------------------------------------- 
+*/
+#define DS3231_CACHE_CONTROL   (1 << 0)
+#define DS3231_CACHE_STATUS    (1 << 1)
+#define DS3231_CACHE_AGING     (1 << 2)
+#define DS3231_CACHE_ALL       (DS3231_CACHE_CONTROL | DS3231_CACHE_STATUS | DS3231_CACHE_AGING)
+
+/* Actualiza la cache a partir de los registros 0x0E..0x10 leidos del chip. */
+static void DS3231_shadow_store(DS3231_Handle *dev, const uint8_t *regs)
+{
+    dev->shadow.control = regs[0] & (uint8_t)~DS3231_CTRL_CONV;
+    dev->shadow.status  = regs[1] & (uint8_t)~DS3231_STATUS_VOLATILE;
+    dev->shadow.aging   = regs[2];
+    dev->shadow.valid   = DS3231_CACHE_ALL;
+}
+
+/* Garantiza que los registros pedidos esten en cache (una rafaga si falta alguno). */
+static DS3231_Status DS3231_shadow_load(DS3231_Handle *dev, uint8_t which)
+{
+    if ((dev->shadow.valid & which) == which) return DS3231_OK;
+    return DS3231_Dev_CacheRefresh(dev);
+}
+
+/* Escritura write-through: si falla, el valor del chip es incierto y se invalida. */
+static DS3231_Status DS3231_shadow_write(DS3231_Handle *dev, uint8_t reg, uint8_t value, uint8_t which)
+{
+    if (DS3231_parse_hal_status(DS3231_port_write(dev->port, reg, value)) != DS3231_OK) {
+        dev->shadow.valid &= (uint8_t)~which;
+        return DS3231_ERROR;
+    }
+    switch (which) {
+        case DS3231_CACHE_CONTROL: dev->shadow.control = value & (uint8_t)~DS3231_CTRL_CONV;      break;
+        case DS3231_CACHE_STATUS:  dev->shadow.status  = value & (uint8_t)~DS3231_STATUS_VOLATILE; break;
+        default:                   dev->shadow.aging   = value;                                   break;
+    }
+    dev->shadow.valid |= which;
+    return DS3231_OK;
+}
+
+/* Valor a escribir en STATUS que conserva los flags volatiles salvo los de la mascara.
+ * OSF/A1F/A2F solo pueden escribirse a 0: escribir 1 los deja como estan. BSY es solo lectura. */
+static uint8_t DS3231_status_write_value(const DS3231_Handle *dev, uint8_t clear_mask)
+{
+    uint8_t flags = (DS3231_STATUS_OSF | DS3231_STATUS_A2F | DS3231_STATUS_A1F) & (uint8_t)~clear_mask;
+    return (uint8_t)((dev->shadow.status & (uint8_t)~clear_mask) | flags);
+}
+
+/** -------------------------------------------------------------------------- 
+* Supervision de OSF: cada lectura que trae STATUS actualiza el estado de la
+* hora sin accesos extra al bus. El paso a no valida se registra una sola vez
+* por evento; vuelve a valida solo cuando se limpia OSF desde este driver.
+* Puede ejecutarse desde la ISR del snapshot por DMA.
+* ---------------------------------------------------------------------------- 
+*/
+#define DS3231_TIME_UNKNOWN    (0U)     // Sin lectura de STATUS desde DS3231_Init.
+#define DS3231_TIME_VALID      (1U)
+#define DS3231_TIME_INVALID    (2U)
+
+/* time_regs: registros 0x00..0x06 de la misma lectura, o NULL si no se leyeron. */
+static void DS3231_osf_observe(DS3231_Handle *dev, uint8_t status, const uint8_t *time_regs)
+{
+    DS3231_Supervisor *sup = &dev->sup;
+
+    if (status & DS3231_STATUS_OSF) {
+        if (sup->state == DS3231_TIME_INVALID) return;
+
+        sup->event.last_good = sup->last_good;
+        memset(&sup->event.detected, 0, sizeof(sup->event.detected));
+        if (time_regs) DS3231_decode_time(time_regs, &sup->event.detected);
+
+        // Publicación: el lazo principal ve el evento completo antes que count, resync y state.
+        __atomic_store_n(&sup->event.count, sup->event.count + 1U, __ATOMIC_RELEASE);
+        __atomic_store_n(&sup->resync, true, __ATOMIC_RELEASE);
+        __atomic_store_n(&sup->state, DS3231_TIME_INVALID, __ATOMIC_RELEASE);
+    } else if (sup->state != DS3231_TIME_INVALID) {
+        if (time_regs) DS3231_decode_time(time_regs, &sup->last_good);
+        __atomic_store_n(&sup->state, DS3231_TIME_VALID, __ATOMIC_RELEASE);
+    }
+}
+
+void DS3231_Dev_CacheInvalidate(DS3231_Handle *dev)
+{
+    if (dev) dev->shadow.valid = 0;
+}
+
+DS3231_Status DS3231_Dev_CacheRefresh(DS3231_Handle *dev)
+{
+    PROF_SCOPE(PROF_ID_DS3231_CACHE_REFRESH, 0, NULL);
+
+    if (!dev) return DS3231_INVALID_PARAM;
+
+    uint8_t regs[3];
+
+    if (DS3231_parse_hal_status(DS3231_port_block_read(dev->port, DS3231_REG_CONTROL, regs, sizeof(regs))) != DS3231_OK) {
+        dev->shadow.valid = 0;
+        return DS3231_ERROR;
+    }
+    DS3231_shadow_store(dev, regs);
+    DS3231_osf_observe(dev, regs[1], NULL);
+    return DS3231_OK;
+}
+
 /** -------------------------------------------------------------------------- 
 * Funciones de inicializacion, solo verifica la presencia del device en el Bus de I²C.                                  
 * ---------------------------------------------------------------------------- 
 */
-DS3231_Status DS3231_Init(void)
+DS3231_Status DS3231_Dev_Init(DS3231_Handle *dev)
 {
-    return DS3231_parse_hal_status(DS3231_is_ready());
+    PROF_SCOPE(PROF_ID_DS3231_INIT, 0, NULL);
+
+    if (!dev) return DS3231_INVALID_PARAM;
+
+    // Otro firmware pudo haber configurado el chip: descarto la cache. El
+    // formato de horas vuelve al de power-on hasta la próxima lectura de la hora.
+    DS3231_Dev_CacheInvalidate(dev);
+    dev->hour_mode   = DS3231_HOURS_24;
+    dev->conv.active = false;   // Una conversión forzada pendiente se abandona sin callback.
+    dev->sup.state   = DS3231_TIME_UNKNOWN;
+    dev->sup.resync  = false;
+    return DS3231_parse_hal_status(DS3231_port_is_ready(dev->port));
 }
 
 /** -------------------------------------------------------------------------- 
 * Funciones de lectura y escritura de tiempo                                        
 * ---------------------------------------------------------------------------- 
 */
-DS3231_Status DS3231_ReadTime(DS3231_Time *time)
+DS3231_Status DS3231_Dev_ReadTime(DS3231_Handle *dev, DS3231_Time *time)
 {
-    if (!time) return DS3231_INVALID_PARAM;
+    PROF_SCOPE(PROF_ID_DS3231_READ_TIME, 0, NULL);
+
+    if (!dev || !time) return DS3231_INVALID_PARAM;
 
     DS3231_Status status = DS3231_OK;
     uint8_t buf[DS3231_MAX_BLOCK_READ];
 
-    status = DS3231_parse_hal_status(DS3231_register_block_read(DS3231_REG_SECONDS, buf,  sizeof(buf)));
+    status = DS3231_parse_hal_status(DS3231_port_block_read(dev->port, DS3231_REG_SECONDS, buf,  sizeof(buf)));
+    if (status != DS3231_OK) return status;
+
+    DS3231_decode_time(buf, time);
+    dev->hour_mode = (buf[DS3231_REG_HOURS] & DS3231_HOURS_12H) ? DS3231_HOURS_12 : DS3231_HOURS_24;
+
+    return status;
+}
+
+static bool DS3231_time_valid(const DS3231_Time *time)
+{
+    return !((time->seconds > 59 || time->minutes > 59 || time->hours > 23) ||
+             (time->day < 1  || time->day > 7) ||
+             (time->date < 1 || time->date > 31) ||
+             (time->month < 1 || time->month > 12) ||
+             (time->year < DS3231_YEAR_MIN || time->year > DS3231_YEAR_MAX));
+}
+
+/* Arma el bloque de escritura (puntero + 0x00..0x06); time en decimal, ya validado. Horas en el formato del handle. */
+static void DS3231_stage_time(const DS3231_Handle *dev, const DS3231_Time *time, uint8_t *buf)
+{
+    buf[0] = DS3231_REG_SECONDS;
+    DS3231_bcd_encode_time(time, &buf[1]);
+    buf[1 + DS3231_REG_HOURS] = DS3231_bcd_hours_reg(time->hours, (DS3231_HourMode)dev->hour_mode);
+}
+
+static DS3231_Status DS3231_write_time(DS3231_Handle *dev, const DS3231_Time *time)
+{
+    uint8_t buf[DS3231_MAX_BLOCK_WRITE];
+
+    DS3231_stage_time(dev, time, buf);
+    return DS3231_parse_hal_status(DS3231_port_block_write(dev->port, buf,  sizeof(buf)));
+}
+
+DS3231_Status DS3231_Dev_SetTime(DS3231_Handle *dev, uint16_t year, uint8_t month, uint8_t date,
+                                    uint8_t day, uint8_t hour, uint8_t min, uint8_t sec)
+{
+    PROF_SCOPE(PROF_ID_DS3231_SET_TIME, 0, NULL);
+
+    if (!dev) return DS3231_INVALID_PARAM;
+
+    DS3231_Time time;
+    time.seconds = sec;
+    time.minutes = min;
+    time.hours   = hour;
+    time.day     = day;
+    time.date    = date;
+    time.month   = month;
+    time.year    = year;
+    if (!DS3231_time_valid(&time)) return DS3231_INVALID_PARAM;
+
+    return DS3231_write_time(dev, &time);
+}
+
+/** -------------------------------------------------------------------------- 
+* Escritura alineada: el bloque BCD se arma en el lazo principal y la ISR del
+* flanco de referencia solo espera el instante programado y lo escribe. El
+* chip reinicia la cadena de cuenta en el ACK del byte de segundos, que llega
+* DS3231_ALIGN_LEAD_NS despues del START.
+* ---------------------------------------------------------------------------- 
+*/
+#define DS3231_ALIGN_IDLE      (0U)     // Nunca armada.
+#define DS3231_ALIGN_ARMED     (1U)
+#define DS3231_ALIGN_DONE      (2U)
+
+static uint32_t DS3231_ticks_from_ns(uint32_t ns, uint32_t hz)
+{
+    return (uint32_t)(((uint64_t)ns * hz + 999999999ULL) / 1000000000ULL);
+}
+
+DS3231_Status DS3231_Dev_SetTimeAligned(DS3231_Handle *dev, const DS3231_Time *time, uint32_t offset_ns,
+                                        DS3231_TickSource ticks, uint32_t ticks_hz)
+{
+    if (!dev || !time || !ticks || ticks_hz == 0) return DS3231_INVALID_PARAM;
+    if (!DS3231_time_valid(time) || offset_ns > DS3231_ALIGN_MAX_OFFSET_NS) return DS3231_INVALID_PARAM;
+
+    DS3231_AlignedWrite *aw = &dev->aligned;
+
+    // Desarmo mientras cambia el bloque: un flanco en el medio no escribe nada.
+    __atomic_store_n(&aw->state, DS3231_ALIGN_DONE, __ATOMIC_RELEASE);
+    DS3231_stage_time(dev, time, aw->buf);
+    aw->ticks      = ticks;
+    aw->ticks_hz   = ticks_hz;
+    aw->fire_ticks = (offset_ns > DS3231_ALIGN_LEAD_NS) ? DS3231_ticks_from_ns(offset_ns - DS3231_ALIGN_LEAD_NS, ticks_hz) : 0;
+    __atomic_store_n(&aw->state, DS3231_ALIGN_ARMED, __ATOMIC_RELEASE);
+    return DS3231_OK;
+}
+
+void DS3231_Dev_SetTimeAligned_OnEdge(DS3231_Handle *dev, uint32_t edge_ticks)
+{
+    if (!dev || __atomic_load_n(&dev->aligned.state, __ATOMIC_ACQUIRE) != DS3231_ALIGN_ARMED) return;
+
+    PROF_SCOPE(PROF_ID_DS3231_SET_TIME_ALIGNED, 0, NULL);
+
+    DS3231_AlignedWrite  *aw  = &dev->aligned;
+    DS3231_AlignedResult *res = &aw->result;
+    uint32_t now = aw->ticks();
+
+    res->latency_ticks = now - edge_ticks;
+    res->late          = res->latency_ticks > aw->fire_ticks;
+    res->phase_ns      = 0;
+
+    // Tarde la fase ya no es la pedida: no escribo y queda para el próximo armado.
+    if (res->late) {
+        res->status = DS3231_TIMEOUT;
+        __atomic_store_n(&aw->state, DS3231_ALIGN_DONE, __ATOMIC_RELEASE);
+        return;
+    }
+    while ((uint32_t)(now - edge_ticks) < aw->fire_ticks) now = aw->ticks();
+
+    if (DS3231_port_busy(dev->port)) {
+        res->status = DS3231_BUSY;
+    } else {
+        res->status = DS3231_parse_hal_status(DS3231_port_block_write(dev->port, aw->buf, sizeof(aw->buf)));
+    }
+    res->phase_ns = (int32_t)((uint64_t)(now - edge_ticks) * 1000000000ULL / aw->ticks_hz) + (int32_t)DS3231_ALIGN_LEAD_NS;
+    __atomic_store_n(&aw->state, DS3231_ALIGN_DONE, __ATOMIC_RELEASE);
+}
+
+DS3231_Status DS3231_Dev_SetTimeAligned_Result(const DS3231_Handle *dev, DS3231_AlignedResult *result)
+{
+    if (!dev || !result) return DS3231_INVALID_PARAM;
+
+    switch (__atomic_load_n(&dev->aligned.state, __ATOMIC_ACQUIRE)) {
+        case DS3231_ALIGN_IDLE:  return DS3231_NOT_READY;
+        case DS3231_ALIGN_ARMED: return DS3231_BUSY;
+        default:                 break;
+    }
+    *result = dev->aligned.result;
+    return DS3231_OK;
+}
+
+/** -------------------------------------------------------------------------- 
+* Conversion a tiempo Unix (algoritmos days_from_civil / civil_from_days de
+* H. Hinnant). Trabajan con años que empiezan en marzo, de modo que el 29 de
+* febrero queda al final y el día del año sale de una formula lineal por mes.
+* En 2000..2199 todo es positivo y entra en 32 bits, salvo los segundos.
+* ---------------------------------------------------------------------------- 
+*/
+#define DS3231_DAYS_1970_TO_0000_03_01   (719468U)
+#define DS3231_DAYS_PER_ERA              (146097U)  // 400 años gregorianos
+
+static uint8_t DS3231_days_in_month(uint8_t month, uint16_t year)
+{
+    static const uint8_t days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    bool leap = ((year % 4) == 0 && (year % 100) != 0) || (year % 400) == 0;
+
+    return (month == 2 && leap) ? 29 : days[month - 1];
+}
+
+DS3231_Status DS3231_TimeToEpoch(const DS3231_Time *time, int64_t *epoch)
+{
+    if (!time || !epoch) return DS3231_INVALID_PARAM;
+
+    uint16_t y = time->year;
+    uint32_t m = time->month;
+
+    if (y < DS3231_YEAR_MIN || y > DS3231_YEAR_MAX || m < 1 || m > 12 ||
+        time->date < 1 || time->date > DS3231_days_in_month((uint8_t)m, y) ||
+        time->hours > 23 || time->minutes > 59 || time->seconds > 59)
+        return DS3231_INVALID_PARAM;
+
+    y -= (m <= 2);
+    uint32_t era  = y / 400U;
+    uint32_t yoe  = y - era * 400U;                                     // [0, 399]
+    uint32_t doy  = (153U * (m > 2 ? m - 3U : m + 9U) + 2U) / 5U + time->date - 1U;
+    uint32_t doe  = yoe * 365U + yoe / 4U - yoe / 100U + doy;           // [0, 146096]
+    uint32_t days = era * DS3231_DAYS_PER_ERA + doe - DS3231_DAYS_1970_TO_0000_03_01;
+
+    *epoch = (int64_t)days * 86400 + (int32_t)(time->hours * 3600U + time->minutes * 60U + time->seconds);
+    return DS3231_OK;
+}
+
+DS3231_Status DS3231_EpochToTime(int64_t epoch, DS3231_Time *time)
+{
+    if (!time || epoch < DS3231_EPOCH_MIN || epoch > DS3231_EPOCH_MAX) return DS3231_INVALID_PARAM;
+
+    // 86400 = 2^7 * 675: el desplazamiento deja el cociente en 32 bits y evita la división de 64.
+    uint64_t t    = (uint64_t)epoch;
+    uint32_t days = (uint32_t)(t >> 7) / 675U;
+    uint32_t sod  = (uint32_t)(t - (uint64_t)days * 86400U);
+
+    uint32_t z    = days + DS3231_DAYS_1970_TO_0000_03_01;
+    uint32_t era  = z / DS3231_DAYS_PER_ERA;
+    uint32_t doe  = z - era * DS3231_DAYS_PER_ERA;
+    uint32_t yoe  = (doe - doe / 1460U + doe / 36524U - doe / 146096U) / 365U;
+    uint32_t doy  = doe - (365U * yoe + yoe / 4U - yoe / 100U);
+    uint32_t mp   = (5U * doy + 2U) / 153U;                             // 0 = marzo
+    uint32_t m    = mp < 10U ? mp + 3U : mp - 9U;
+    uint32_t y    = yoe + era * 400U + (m <= 2U);
+
+    time->seconds = (uint8_t)(sod % 60U);
+    time->minutes = (uint8_t)((sod / 60U) % 60U);
+    time->hours   = (uint8_t)(sod / 3600U);
+    time->date    = (uint8_t)(doy - (153U * mp + 2U) / 5U + 1U);
+    time->month   = (uint8_t)m;
+    time->year    = (uint16_t)y;
+    time->day     = (uint8_t)((days + 3U) % 7U + 1U);                   // 1970-01-01 fue jueves
+    return DS3231_OK;
+}
+
+/** -------------------------------------------------------------------------- 
+* Ajuste de hora por diferencia: lee 0x00..0x06, suma delta (con todos los
+* acarreos, en el calendario del chip) y escribe solo el tramo contiguo de
+* registros que cambia. Un tramo sin segundos no reinicia la cadena de cuenta.
+* El dia de semana avanza con los dias transcurridos, respetando la
+* convencion del chip.
+*
+* El chip toma como bisiesto todo año multiplo de 4, tambien 2100 (igual que
+* el simulador y ds3231_clock): el ajuste no pasa por DS3231_TimeToEpoch,
+* que es gregoriano, sino por segundos desde 2000-01-01 en ese calendario.
+* ---------------------------------------------------------------------------- 
+*/
+#define DS3231_CHIP_DAYS_PER_4Y   (1461U)   // 3 * 365 + 366
+#define DS3231_CHIP_DAYS_MAX      (50U * DS3231_CHIP_DAYS_PER_4Y)   // 2000..2199
+
+static const uint16_t DS3231_chip_days_before[12] = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+
+static uint8_t DS3231_chip_days_in_month(uint8_t month, uint16_t year)
+{
+    if (month == 2 && (year % 4) == 0) return 29;
+    return (uint8_t)((month == 12 ? 365U : DS3231_chip_days_before[month]) - DS3231_chip_days_before[month - 1]);
+}
+
+/* Hora del chip -> segundos desde 2000-01-01 00:00:00 en el calendario del chip. */
+static bool DS3231_chip_to_seconds(const DS3231_Time *time, int64_t *seconds)
+{
+    if (time->year < DS3231_YEAR_MIN || time->year > DS3231_YEAR_MAX || time->month < 1 || time->month > 12 ||
+        time->date < 1 || time->date > DS3231_chip_days_in_month(time->month, time->year) ||
+        time->hours > 23 || time->minutes > 59 || time->seconds > 59)
+        return false;
+
+    uint32_t y    = time->year - DS3231_YEAR_MIN;
+    uint32_t days = y * 365U + (y + 3U) / 4U + DS3231_chip_days_before[time->month - 1] + time->date - 1U;
+
+    if (time->month > 2 && (y % 4U) == 0) days++;
+    *seconds = (int64_t)days * 86400 + (int32_t)(time->hours * 3600U + time->minutes * 60U + time->seconds);
+    return true;
+}
+
+/* Inversa de DS3231_chip_to_seconds. No toca el día de semana. */
+static bool DS3231_chip_from_seconds(int64_t seconds, DS3231_Time *time)
+{
+    if (seconds < 0 || seconds >= (int64_t)DS3231_CHIP_DAYS_MAX * 86400) return false;
+
+    // Mismo atajo que DS3231_EpochToTime: 86400 = 2^7 * 675.
+    uint32_t days = (uint32_t)((uint64_t)seconds >> 7) / 675U;
+    uint32_t sod  = (uint32_t)((uint64_t)seconds - (uint64_t)days * 86400U);
+    uint32_t y    = days / DS3231_CHIP_DAYS_PER_4Y * 4U;
+    uint32_t doy  = days % DS3231_CHIP_DAYS_PER_4Y;
+    uint8_t  m    = 1;
+
+    if (doy >= 366U) {
+        doy -= 366U;
+        y   += 1U + doy / 365U;
+        doy %= 365U;
+    }
+    time->year = (uint16_t)(DS3231_YEAR_MIN + y);
+    while (doy >= DS3231_chip_days_in_month(m, time->year)) doy -= DS3231_chip_days_in_month(m++, time->year);
+
+    time->month   = m;
+    time->date    = (uint8_t)(doy + 1U);
+    time->hours   = (uint8_t)(sod / 3600U);
+    time->minutes = (uint8_t)((sod / 60U) % 60U);
+    time->seconds = (uint8_t)(sod % 60U);
+    return true;
+}
+
+DS3231_Status DS3231_Dev_AdjustTime(DS3231_Handle *dev, int32_t delta_s)
+{
+    PROF_SCOPE(PROF_ID_DS3231_ADJUST_TIME, 0, NULL);
+
+    if (!dev) return DS3231_INVALID_PARAM;
+
+    uint8_t regs[DS3231_MAX_BLOCK_READ];
+    uint8_t buf[DS3231_MAX_BLOCK_WRITE];
+    DS3231_Time now, next;
+    int64_t seconds;
+
+    DS3231_Status status = DS3231_parse_hal_status(DS3231_port_block_read(dev->port, DS3231_REG_SECONDS, regs, sizeof(regs)));
     if (status != DS3231_OK) return status;
 
-    time->seconds = (uint8_t)bcd2dec(buf[0] & 0x7F);
-    time->minutes = (uint8_t)bcd2dec(buf[1] & 0x7F);
-    time->hours   = (uint8_t)bcd2dec(buf[2] & 0x3F);
-    time->day     = (uint8_t)(buf[3] & 0x07); // El dia no hace falta convertirlo, porque es el dia semanal (1...7)
-    time->date    = (uint8_t)bcd2dec(buf[4] & 0x3F);
-    time->month   = bcd2dec(buf[5] & 0x1F); // Enmascaro ya qque el bit7 es el centenario.
-    time->year    = bcd2dec(buf[6]);
+    DS3231_decode_time(regs, &now);
+    dev->hour_mode = (regs[DS3231_REG_HOURS] & DS3231_HOURS_12H) ? DS3231_HOURS_12 : DS3231_HOURS_24;
+
+    // En :59 el próximo flanco acarrea hacia registros que quizás no se escriben.
+    if (now.seconds == 59) return DS3231_BUSY;
+
+    if (!DS3231_chip_to_seconds(&now, &seconds)) return DS3231_INVALID_PARAM;
+    if (!DS3231_chip_from_seconds(seconds + delta_s, &next)) return DS3231_INVALID_PARAM;
+
+    int32_t days = (int32_t)((seconds + delta_s) / 86400 - seconds / 86400);
+    next.day = (uint8_t)((now.day - 1 + days % 7 + 7) % 7 + 1);
+    DS3231_stage_time(dev, &next, buf);
+
+    uint8_t first = 0, last = DS3231_MAX_BLOCK_READ;
+    while (first < DS3231_MAX_BLOCK_READ && buf[1 + first] == regs[first]) first++;
+    if (first == DS3231_MAX_BLOCK_READ) return DS3231_OK;
+    while (buf[last] == regs[last - 1]) last--;
+
+    // El byte anterior al tramo pasa a ser la dirección del primer registro.
+    buf[first] = first;
+    return DS3231_parse_hal_status(DS3231_port_block_write(dev->port, &buf[first], (uint16_t)(last - first + 1)));
+}
+
+/** -------------------------------------------------------------------------- 
+* Funcion de lectura de la temperatura                                       
+* ---------------------------------------------------------------------------- 
+*/
+static DS3231_Status DS3231_read_temp_q4(DS3231_Handle *dev, int16_t *temp_q4)
+{
+    uint8_t buf[DS3231_TEMP_BUF_SIZE];
+
+    if (DS3231_parse_hal_status(DS3231_port_block_read(dev->port, DS3231_REG_TEMP_MSB, buf, sizeof(buf))) != DS3231_OK)
+        return DS3231_ERROR;
+
+    *temp_q4 = DS3231_temp_q4(buf[0], buf[1]);
+
+    return DS3231_OK;
+}
+
+DS3231_Status DS3231_Dev_GetTemperatureQ4(DS3231_Handle *dev, int16_t *temp_q4)
+{
+    PROF_SCOPE(PROF_ID_DS3231_GET_TEMPERATURE_Q4, 0, NULL);
+
+    if (!dev || !temp_q4)
+        return DS3231_INVALID_PARAM;
+
+    return DS3231_read_temp_q4(dev, temp_q4);
+}
+
+#ifndef DS3231_NO_FLOAT
+DS3231_Status DS3231_Dev_GetTemperature(DS3231_Handle *dev, float *temp)
+{
+    PROF_SCOPE(PROF_ID_DS3231_GET_TEMPERATURE, 0, NULL);
+
+    if (!dev || !temp)
+        return DS3231_INVALID_PARAM;
+
+    int16_t temp_q4;
+    DS3231_Status status = DS3231_read_temp_q4(dev, &temp_q4);
+
+    if (status == DS3231_OK)
+        *temp = temp_q4 * 0.25f;
 
     return status;
 }
+#endif
+
+/** -------------------------------------------------------------------------- 
+* Conversion de temperatura forzada. CONV queda en 1 hasta que el chip termina
+* (BSY cubre tambien la conversion automatica); en lugar de esperar activamente,
+* el lazo principal consulta el chip recien vencido tCONV.
+* ---------------------------------------------------------------------------- 
+*/
+DS3231_Status DS3231_Dev_ConvertTemperatureAsync(DS3231_Handle *dev, DS3231_TempCallback cb, void *ctx, uint32_t now_ms)
+{
+    PROF_SCOPE(PROF_ID_DS3231_CONVERT_START, 0, NULL);
+
+    if (!dev || !cb) return DS3231_INVALID_PARAM;
+    if (dev->conv.active) return DS3231_BUSY;
+
+    uint8_t regs[3];    // CONTROL, STATUS, AGING
+
+    if (DS3231_parse_hal_status(DS3231_port_block_read(dev->port, DS3231_REG_CONTROL, regs, sizeof(regs))) != DS3231_OK) {
+        dev->shadow.valid = 0;
+        return DS3231_ERROR;
+    }
+    DS3231_shadow_store(dev, regs);
+    DS3231_osf_observe(dev, regs[1], NULL);
+
+    if ((regs[0] & DS3231_CTRL_CONV) || (regs[1] & DS3231_STATUS_BSY)) return DS3231_BUSY;
+
+    DS3231_Status status = DS3231_shadow_write(dev, DS3231_REG_CONTROL, dev->shadow.control | DS3231_CTRL_CONV,
+                                               DS3231_CACHE_CONTROL);
+    if (status != DS3231_OK) return status;
+
+    dev->conv.cb       = cb;
+    dev->conv.ctx      = ctx;
+    dev->conv.start_ms = now_ms;
+    dev->conv.next_ms  = now_ms + DS3231_CONV_TIME_MS;
+    dev->conv.active   = true;
+    return DS3231_OK;
+}
+
+/* Termina la conversion y entrega el resultado; el callback puede iniciar otra. */
+static void DS3231_conv_finish(DS3231_Handle *dev, DS3231_Status status, DS3231_Temp temp)
+{
+    dev->conv.active = false;
+    dev->conv.cb(status, temp, dev->conv.ctx);
+}
+
+DS3231_Status DS3231_Dev_ConvertTemperaturePoll(DS3231_Handle *dev, uint32_t now_ms)
+{
+    if (!dev) return DS3231_INVALID_PARAM;
+    if (!dev->conv.active) return DS3231_OK;
+    if ((int32_t)(now_ms - dev->conv.next_ms) < 0) return DS3231_BUSY;
+
+    PROF_SCOPE(PROF_ID_DS3231_CONVERT_POLL, 0, NULL);
+
+    uint8_t regs[5];    // CONTROL, STATUS, AGING, TEMP_MSB, TEMP_LSB
+
+    if (DS3231_parse_hal_status(DS3231_port_block_read(dev->port, DS3231_REG_CONTROL, regs, sizeof(regs))) != DS3231_OK) {
+        dev->shadow.valid = 0;
+        DS3231_conv_finish(dev, DS3231_ERROR, 0);
+        return DS3231_OK;
+    }
+    DS3231_shadow_store(dev, regs);
+    DS3231_osf_observe(dev, regs[1], NULL);
+
+    if ((regs[0] & DS3231_CTRL_CONV) || (regs[1] & DS3231_STATUS_BSY)) {
+        if (now_ms - dev->conv.start_ms >= DS3231_CONV_TIMEOUT_MS) {
+            DS3231_conv_finish(dev, DS3231_TIMEOUT, 0);
+            return DS3231_OK;
+        }
+        dev->conv.next_ms = now_ms + DS3231_CONV_POLL_MS;
+        return DS3231_BUSY;
+    }
+
+    DS3231_conv_finish(dev, DS3231_OK, DS3231_decode_temp(&regs[3]));
+    return DS3231_OK;
+}
+
+/** -------------------------------------------------------------------------- 
+* Formato 12/24 h del registro de horas
+* ---------------------------------------------------------------------------- 
+*/
+DS3231_Status DS3231_Dev_SetHourMode(DS3231_Handle *dev, DS3231_HourMode mode)
+{
+    PROF_SCOPE(PROF_ID_DS3231_SET_HOUR_MODE, 0, NULL);
+
+    if (!dev || (mode != DS3231_HOURS_24 && mode != DS3231_HOURS_12)) return DS3231_INVALID_PARAM;
+
+    uint8_t regs[3];    // segundos, minutos, horas
+
+    if (DS3231_parse_hal_status(DS3231_port_block_read(dev->port, DS3231_REG_SECONDS, regs, sizeof(regs))) != DS3231_OK)
+        return DS3231_ERROR;
+
+    DS3231_HourMode current = (regs[DS3231_REG_HOURS] & DS3231_HOURS_12H) ? DS3231_HOURS_12 : DS3231_HOURS_24;
+    if (current != mode) {
+        // Con 59:59 la hora cambia antes de que llegue la escritura.
+        if ((regs[DS3231_REG_MINUTES] & 0x7F) == 0x59 && (regs[DS3231_REG_SECONDS] & 0x7F) == 0x59)
+            return DS3231_BUSY;
+
+        uint8_t buf[2] = { DS3231_REG_HOURS, DS3231_bcd_hours_reg(DS3231_hours24_lut[regs[DS3231_REG_HOURS] & 0x7F], mode) };
+        DS3231_Status status = DS3231_parse_hal_status(DS3231_port_block_write(dev->port, buf, sizeof(buf)));
+        if (status != DS3231_OK) return status;
+    }
+
+    dev->hour_mode = (uint8_t)mode;
+    return DS3231_OK;
+}
+
+DS3231_Status DS3231_Dev_GetHourMode(DS3231_Handle *dev, DS3231_HourMode *mode)
+{
+    PROF_SCOPE(PROF_ID_DS3231_GET_HOUR_MODE, 0, NULL);
+
+    if (!dev || !mode) return DS3231_INVALID_PARAM;
+
+    uint8_t reg;
+
+    if (DS3231_parse_hal_status(DS3231_port_read(dev->port, DS3231_REG_HOURS, &reg)) != DS3231_OK)
+        return DS3231_ERROR;
+
+    *mode = (reg & DS3231_HOURS_12H) ? DS3231_HOURS_12 : DS3231_HOURS_24;
+    dev->hour_mode = (uint8_t)*mode;
+    return DS3231_OK;
+}
+
+/** -------------------------------------------------------------------------- 
+* Lectura del mapa completo de registros en una sola transaccion
+* ---------------------------------------------------------------------------- 
+*/
+DS3231_Status DS3231_DecodeSnapshot(const uint8_t *regs, DS3231_Snapshot *snap)
+{
+    if (!regs || !snap) return DS3231_INVALID_PARAM;
+
+    DS3231_decode_time(&regs[DS3231_REG_SECONDS], &snap->time);
+    DS3231_decode_alarm(&regs[DS3231_REG_ALARM_1], true,  &snap->alarm1);
+    DS3231_decode_alarm(&regs[DS3231_REG_ALARM_2], false, &snap->alarm2);
+    snap->control     = regs[DS3231_REG_CONTROL];
+    snap->status      = regs[DS3231_REG_STATUS];
+    snap->aging       = (int8_t)regs[DS3231_REG_AGING];
+    snap->temperature_q4 = DS3231_temp_q4(regs[DS3231_REG_TEMP_MSB], regs[DS3231_REG_TEMP_LSB]);
+#ifndef DS3231_NO_FLOAT
+    snap->temperature = snap->temperature_q4 * 0.25f;
+#endif
+
+    return DS3231_OK;
+}
 
-static DS3231_Status DS3231_SetTimeBCD(const DS3231_Time *time)
+DS3231_Status DS3231_Dev_ReadSnapshot(DS3231_Handle *dev, DS3231_Snapshot *snap)
 {
-    if (!time) return DS3231_INVALID_PARAM;
+    PROF_SCOPE(PROF_ID_DS3231_READ_SNAPSHOT, 0, NULL);
+
+    if (!dev || !snap) return DS3231_INVALID_PARAM;
+
+    DS3231_Status status;
+    uint8_t regs[DS3231_REG_MAP_SIZE];
+
+    status = DS3231_parse_hal_status(DS3231_port_block_read(dev->port, DS3231_REG_SECONDS, regs, sizeof(regs)));
+    if (status != DS3231_OK) return status;
+
+    // La misma rafaga refresca la cache de CONTROL/STATUS/AGING, el formato de horas y OSF.
+    DS3231_shadow_store(dev, &regs[DS3231_REG_CONTROL]);
+    DS3231_osf_observe(dev, regs[DS3231_REG_STATUS], regs);
+    dev->hour_mode = (regs[DS3231_REG_HOURS] & DS3231_HOURS_12H) ? DS3231_HOURS_12 : DS3231_HOURS_24;
+
+    return DS3231_DecodeSnapshot(regs, snap);
+}
+
+/** -------------------------------------------------------------------------- 
+* Lecturas asincronicas: el buffer vive en el handle hasta que la ISR de I2C
+* notifica la finalizacion. Solo puede haber una lectura en curso por handle.
+* ---------------------------------------------------------------------------- 
+*/
+static void DS3231_ReadTime_done(HAL_StatusTypeDef hal_status, void *ctx)
+{
+    DS3231_AsyncCtx *actx = (DS3231_AsyncCtx *)ctx;
+    DS3231_Time time = {0};
+    DS3231_Status status = DS3231_parse_hal_status(hal_status);
+
+    if (status == DS3231_OK)
+        DS3231_decode_time(actx->buf, &time);
+
+    actx->cb.time(status, &time, actx->ctx);
+}
+
+static void DS3231_GetTemperature_done(HAL_StatusTypeDef hal_status, void *ctx)
+{
+    DS3231_AsyncCtx *actx = (DS3231_AsyncCtx *)ctx;
+    DS3231_Status status = DS3231_parse_hal_status(hal_status);
+    DS3231_Temp temp = 0;
+
+    if (status == DS3231_OK)
+        temp = DS3231_decode_temp(actx->buf);
+
+    actx->cb.temp(status, temp, actx->ctx);
+}
+
+DS3231_Status DS3231_Dev_ReadTimeAsync(DS3231_Handle *dev, DS3231_TimeCallback cb, void *ctx)
+{
+    PROF_SCOPE(PROF_ID_DS3231_READ_TIME_ASYNC, 0, NULL);
+
+    if (!dev || !cb) return DS3231_INVALID_PARAM;
+    if (DS3231_port_busy(dev->port)) return DS3231_BUSY;
+
+    dev->async.cb.time = cb;
+    dev->async.ctx     = ctx;
+
+    return DS3231_parse_hal_status(DS3231_port_block_read_async(dev->port, DS3231_REG_SECONDS, dev->async.buf,
+                                                                DS3231_MAX_BLOCK_READ,
+                                                                DS3231_ReadTime_done, &dev->async));
+}
+
+DS3231_Status DS3231_Dev_GetTemperatureAsync(DS3231_Handle *dev, DS3231_TempCallback cb, void *ctx)
+{
+    PROF_SCOPE(PROF_ID_DS3231_GET_TEMPERATURE_ASYNC, 0, NULL);
+
+    if (!dev || !cb) return DS3231_INVALID_PARAM;
+    if (DS3231_port_busy(dev->port)) return DS3231_BUSY;
+
+    dev->async.cb.temp = cb;
+    dev->async.ctx     = ctx;
+
+    return DS3231_parse_hal_status(DS3231_port_block_read_async(dev->port, DS3231_REG_TEMP_MSB, dev->async.buf,
+                                                                DS3231_TEMP_BUF_SIZE,
+                                                                DS3231_GetTemperature_done, &dev->async));
+}
+
+/** -------------------------------------------------------------------------- 
+* Snapshot de registros por DMA con doble buffer. El DMA llena regs[front ^ 1]
+* mientras la aplicacion decodifica regs[front]; al completar se intercambia
+* el indice. El lector marca el buffer que esta usando para que no se pise.
+* ---------------------------------------------------------------------------- 
+*/
+static void DS3231_SnapshotDMA_done(HAL_StatusTypeDef hal_status, void *ctx)
+{
+    DS3231_Handle *dev = (DS3231_Handle *)ctx;
+    DS3231_SnapshotDMA *snap = &dev->snap;
+    DS3231_Status status = DS3231_parse_hal_status(hal_status);
+
+    if (status == DS3231_OK) {
+        snap->front ^= 1;
+        snap->seq++;
+        DS3231_osf_observe(dev, snap->regs[snap->front][DS3231_REG_STATUS], snap->regs[snap->front]);
+    }
+    if (snap->cb)
+        snap->cb(status, snap->ctx);
+}
+
+DS3231_Status DS3231_Dev_SnapshotDMA_Start(DS3231_Handle *dev, DS3231_SnapshotCallback cb, void *ctx)
+{
+    PROF_SCOPE(PROF_ID_DS3231_SNAPSHOT_DMA_START, 0, NULL);
+
+    if (!dev) return DS3231_INVALID_PARAM;
+
+    uint8_t back = dev->snap.front ^ 1;
+
+    if (dev->snap.held == back) return DS3231_BUSY;
+    if (DS3231_port_busy(dev->port)) return DS3231_BUSY;
+
+    dev->snap.cb  = cb;
+    dev->snap.ctx = ctx;
+
+    return DS3231_parse_hal_status(DS3231_port_block_read_dma(dev->port, DS3231_REG_SECONDS, dev->snap.regs[back],
+                                                              DS3231_REG_MAP_SIZE,
+                                                              DS3231_SnapshotDMA_done, dev));
+}
+
+const uint8_t *DS3231_Dev_SnapshotDMA_Acquire(DS3231_Handle *dev, uint32_t *seq)
+{
+    uint8_t idx;
+
+    if (!dev || dev->snap.seq == 0) return NULL;
+
+    // Si la ISR intercambia los buffers mientras marco el frontal, reintento.
+    do {
+        idx = dev->snap.front;
+        dev->snap.held = idx;
+    } while (idx != dev->snap.front);
+
+    if (seq) *seq = dev->snap.seq;
+
+    return dev->snap.regs[idx];
+}
+
+void DS3231_Dev_SnapshotDMA_Release(DS3231_Handle *dev)
+{
+    if (dev) dev->snap.held = DS3231_SNAP_NONE;
+}
+
+/* -------------------------------------------------------------------------- */
+/* Funciones de lectura y control de Estado                                   */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief Lee el registro de Estado (0x0F). Siempre accede al bus, ya que
+ *        contiene flags que cambia el hardware.
+ */
+DS3231_Status DS3231_Dev_GetStatus(DS3231_Handle *dev, uint8_t *status)
+{
+    PROF_SCOPE(PROF_ID_DS3231_GET_STATUS, 0, NULL);
+
+    if (!dev || !status) return DS3231_INVALID_PARAM;
+    if (DS3231_parse_hal_status(DS3231_port_read(dev->port, DS3231_REG_STATUS, status)) != DS3231_OK)
+        return DS3231_ERROR;
+
+    dev->shadow.status = *status & (uint8_t)~DS3231_STATUS_VOLATILE;
+    dev->shadow.valid |= DS3231_CACHE_STATUS;
+    DS3231_osf_observe(dev, *status, NULL);
+    return DS3231_OK;
+}
+
+
+DS3231_Status DS3231_Dev_ClearStatus(DS3231_Handle *dev, uint8_t mask)
+{
+    PROF_SCOPE(PROF_ID_DS3231_CLEAR_STATUS, 0, NULL);
+
+    if (!dev) return DS3231_INVALID_PARAM;
 
-    DS3231_Status status = DS3231_OK;
-    uint8_t buf[DS3231_MAX_BLOCK_WRITE];
+    if (DS3231_shadow_load(dev, DS3231_CACHE_STATUS) != DS3231_OK)
+        return DS3231_ERROR;
 
-    buf[0] = DS3231_REG_SECONDS;
-    buf[1] = (uint8_t)(time->seconds & 0x7F);
-    buf[2] = (uint8_t)(time->minutes & 0x7F);
-    buf[3] = (uint8_t)(time->hours   & 0x3F);
-    buf[4] = (uint8_t)(time->day     & 0x07);
-    buf[5] = (uint8_t)(time->date    & 0x3F);
-    buf[6] = time->month;                     
-    buf[7] = time->year;
-
-    status = DS3231_parse_hal_status(DS3231_register_block_write(buf,  sizeof(buf)));
+    // Limpia solo los bits de la máscara
+    DS3231_Status status = DS3231_shadow_write(dev, DS3231_REG_STATUS, DS3231_status_write_value(dev, mask),
+                                               DS3231_CACHE_STATUS);
+    if (status == DS3231_OK && (mask & DS3231_STATUS_OSF)) {
+        __atomic_store_n(&dev->sup.resync, false, __ATOMIC_RELAXED);
+        __atomic_store_n(&dev->sup.state, DS3231_TIME_VALID, __ATOMIC_RELEASE);
+    }
     return status;
 }
 
-DS3231_Status DS3231_SetTime(uint8_t year, uint8_t month, uint8_t date,
-                                    uint8_t day, uint8_t hour, uint8_t min, uint8_t sec)
-{
-    if ((sec > 59 || min > 59 || hour > 23) || 
-        (day < 1  || day > 7) ||
-        (date < 1 || date > 31) || 
-        (month < 1 || month > 12) || 
-        year > 99)
-    {
-        return DS3231_INVALID_PARAM;
-    }
+/* -------------------------------------------------------------------------- */
+/* Supervision de OSF                                                         */
+/* -------------------------------------------------------------------------- */
 
-    DS3231_Time time;
-    time.seconds = dec2bcd(sec);
-    time.minutes = dec2bcd(min);
-    time.hours   = dec2bcd(hour);
-    time.day     = (uint8_t)(day & 0x07);
-    time.date    = dec2bcd(date);
-    time.month   = dec2bcd(month);
-    time.year    = dec2bcd(year);
+void DS3231_Dev_SetResyncCallback(DS3231_Handle *dev, DS3231_ResyncCallback cb, void *ctx)
+{
+    if (!dev) return;
 
-    return DS3231_SetTimeBCD(&time);
+    dev->sup.cb  = cb;
+    dev->sup.ctx = ctx;
 }
 
-/** -------------------------------------------------------------------------- 
-* Funcion de lectura de la temperatura                                       
-* ---------------------------------------------------------------------------- 
-*/
-DS3231_Status DS3231_GetTemperature(float *temp)
+DS3231_Status DS3231_Dev_Supervise(DS3231_Handle *dev)
 {
-    if (!temp)
-        return DS3231_INVALID_PARAM;
+    if (!dev) return DS3231_INVALID_PARAM;
 
-    uint8_t buf[DS3231_TEMP_BUF_SIZE];
+    if (__atomic_load_n(&dev->sup.state, __ATOMIC_ACQUIRE) == DS3231_TIME_UNKNOWN) {
+        PROF_SCOPE(PROF_ID_DS3231_SUPERVISE, 0, NULL);
 
-    if (DS3231_parse_hal_status(DS3231_register_block_read(DS3231_REG_TEMP_MSB, buf, sizeof(buf))) != DS3231_OK)
-        return DS3231_ERROR;
+        uint8_t regs[DS3231_REG_AGING + 1];     // Hora, alarmas, CONTROL, STATUS, AGING
 
-    /** - Conversion de valores a grados celsius.
-    *   El MSB contiene la parte entera con signo.
-    *   Los 2 bits altos del LSB contienen la fracción en pasos de 0.25°C.
-    */
-    *temp = (int8_t)buf[0] + ((buf[1] >> 6) * 0.25f);
+        if (DS3231_parse_hal_status(DS3231_port_block_read(dev->port, DS3231_REG_SECONDS, regs, sizeof(regs))) != DS3231_OK)
+            return DS3231_ERROR;
 
-    return DS3231_OK;
-}
+        DS3231_shadow_store(dev, &regs[DS3231_REG_CONTROL]);
+        DS3231_osf_observe(dev, regs[DS3231_REG_STATUS], regs);
+        dev->hour_mode = (regs[DS3231_REG_HOURS] & DS3231_HOURS_12H) ? DS3231_HOURS_12 : DS3231_HOURS_24;
+    }
 
-/* -------------------------------------------------------------------------- */
-/* Funciones de lectura y control de Estado                                   */
-/* -------------------------------------------------------------------------- */
+    if (!__atomic_load_n(&dev->sup.resync, __ATOMIC_ACQUIRE) || !dev->sup.cb) return DS3231_OK;
 
+    DS3231_Status status = dev->sup.cb(&dev->sup.event, dev->sup.ctx);
+    if (status != DS3231_OK) return status;
 
-DS3231_Status DS3231_GetStatus(uint8_t *status)
-{
-    if (!status) return DS3231_INVALID_PARAM;
-    if (DS3231_parse_hal_status(DS3231_register_read(DS3231_REG_STATUS, status)) != DS3231_OK)
-        return DS3231_ERROR;
-    return DS3231_OK;
+    // Con la cache cargada por la lectura que detectó OSF, una sola escritura.
+    return DS3231_Dev_ClearStatus(dev, DS3231_STATUS_OSF);
 }
 
-
-DS3231_Status DS3231_ClearStatus(uint8_t mask)
+bool DS3231_Dev_TimeValid(const DS3231_Handle *dev)
 {
-    uint8_t status;
-    if (DS3231_parse_hal_status(DS3231_register_read(DS3231_REG_STATUS, &status)) != DS3231_OK) 
-        return DS3231_ERROR;
+    return dev && __atomic_load_n(&dev->sup.state, __ATOMIC_ACQUIRE) == DS3231_TIME_VALID;
+}
 
-    status &= ~mask; // Limpia solo los bits de la máscara
+DS3231_Status DS3231_Dev_GetPowerLoss(const DS3231_Handle *dev, DS3231_PowerLoss *event)
+{
+    if (!dev || !event) return DS3231_INVALID_PARAM;
 
-    if (DS3231_parse_hal_status(DS3231_register_write(DS3231_REG_STATUS, status)) != DS3231_OK) 
-        return DS3231_ERROR;
+    // Un evento nuevo desde la ISR durante la copia cambia count: se copia de nuevo.
+    for (;;) {
+        uint32_t count = __atomic_load_n(&dev->sup.event.count, __ATOMIC_ACQUIRE);
 
-    return DS3231_OK;
+        if (count == 0) return DS3231_NOT_READY;
+        *event = dev->sup.event;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&dev->sup.event.count, __ATOMIC_RELAXED) == count) return DS3231_OK;
+    }
 }
 
 /* -------------------------------------------------------------------------- */
@@ -155,15 +1016,19 @@ DS3231_Status DS3231_ClearStatus(uint8_t mask)
 /* -------------------------------------------------------------------------- */
 
 /**
- * @brief Lee el registro de Control (0x0E).
+ * @brief Lee el registro de Control (0x0E). Se resuelve desde la cache si es
+ *        valida; el bit CONV (volatil) se reporta en 0.
  */
-DS3231_Status DS3231_GetControl(uint8_t *control)
+DS3231_Status DS3231_Dev_GetControl(DS3231_Handle *dev, uint8_t *control)
 {
-    if (!control) return DS3231_INVALID_PARAM;
+    PROF_SCOPE(PROF_ID_DS3231_GET_CONTROL, 0, NULL);
+
+    if (!dev || !control) return DS3231_INVALID_PARAM;
 
-    if (DS3231_parse_hal_status(DS3231_register_read(DS3231_REG_CONTROL, control)) != DS3231_OK)
+    if (DS3231_shadow_load(dev, DS3231_CACHE_CONTROL) != DS3231_OK)
         return DS3231_ERROR;
 
+    *control = dev->shadow.control;
     return DS3231_OK;
 }
 
@@ -171,73 +1036,64 @@ DS3231_Status DS3231_GetControl(uint8_t *control)
  * @brief Configura los bits indicados por la máscara.
  * @param mask Mascara con los bits a configurar (ej: DS3231_CTRL_INTCN | DS3231_CTRL_A1IE)
  */
-DS3231_Status DS3231_UpdateControl(uint8_t mask)
+DS3231_Status DS3231_Dev_UpdateControl(DS3231_Handle *dev, uint8_t mask)
 {
-    uint8_t ctrl;
-
-    if (DS3231_parse_hal_status(DS3231_register_read(DS3231_REG_CONTROL, &ctrl)) != DS3231_OK)
-        return DS3231_ERROR;
+    PROF_SCOPE(PROF_ID_DS3231_UPDATE_CONTROL, 0, NULL);
 
-    ctrl |= mask;
+    if (!dev) return DS3231_INVALID_PARAM;
 
-    if (DS3231_parse_hal_status(DS3231_register_write(DS3231_REG_CONTROL, ctrl)) != DS3231_OK)
+    if (DS3231_shadow_load(dev, DS3231_CACHE_CONTROL) != DS3231_OK)
         return DS3231_ERROR;
 
-    return DS3231_OK;
+    return DS3231_shadow_write(dev, DS3231_REG_CONTROL, dev->shadow.control | mask, DS3231_CACHE_CONTROL);
 }
 
 /**
  * @brief Limpia los bits indicados por la máscara.
  * @param mask Contiene los bits a limpiar.
  */
-DS3231_Status DS3231_ClearControl(uint8_t mask)
+DS3231_Status DS3231_Dev_ClearControl(DS3231_Handle *dev, uint8_t mask)
 {
-    uint8_t ctrl;
-
-    if (DS3231_parse_hal_status(DS3231_register_read(DS3231_REG_CONTROL, &ctrl)) != DS3231_OK)
-        return DS3231_ERROR;
+    PROF_SCOPE(PROF_ID_DS3231_CLEAR_CONTROL, 0, NULL);
 
-    ctrl &= ~mask;
+    if (!dev) return DS3231_INVALID_PARAM;
 
-    if (DS3231_parse_hal_status(DS3231_register_write(DS3231_REG_CONTROL, ctrl)) != DS3231_OK)
+    if (DS3231_shadow_load(dev, DS3231_CACHE_CONTROL) != DS3231_OK)
         return DS3231_ERROR;
 
-    return DS3231_OK;
+    return DS3231_shadow_write(dev, DS3231_REG_CONTROL, dev->shadow.control & (uint8_t)~mask, DS3231_CACHE_CONTROL);
 }
 
 /* -------------------------------------------------------------------------- */
 /* Habilita la salida de salida de 32 KHz                                     */
 /* -------------------------------------------------------------------------- */
 
-DS3231_Status DS3231_Enable32KHz(bool enable)
+DS3231_Status DS3231_Dev_Enable32KHz(DS3231_Handle *dev, bool enable)
 {
-    uint8_t status, control;
+    PROF_SCOPE(PROF_ID_DS3231_ENABLE_32KHZ, 0, NULL);
 
-    if (enable) {
-        // Leo el registro de control, para verificar que el oscilador esté encendido (EOSC = 0), en caso de que no lo esté lo enciendo.
-        if (DS3231_parse_hal_status(DS3231_register_read(DS3231_REG_CONTROL, &control)) != DS3231_OK) return DS3231_ERROR;
+    if (!dev) return DS3231_INVALID_PARAM;
 
-        if (control & DS3231_CTRL_EOSC) {
-            // Si el bit de EOSC esta en 1, lo limpio y escribo nuevamente el registro de control.
-            control &= ~DS3231_CTRL_EOSC;
-            if (DS3231_parse_hal_status(DS3231_register_write(DS3231_REG_CONTROL, control)) != DS3231_OK)
-                return DS3231_ERROR;
-        }
-    }
+    uint8_t status;
 
-    // Leo el estado del registro de estado.
-    if (DS3231_parse_hal_status(DS3231_register_read(DS3231_REG_STATUS, &status)) != DS3231_OK) 
+    if (DS3231_shadow_load(dev, DS3231_CACHE_CONTROL | DS3231_CACHE_STATUS) != DS3231_OK)
         return DS3231_ERROR;
 
+    // Verifico que el oscilador esté encendido (EOSC = 0), en caso de que no lo esté lo enciendo.
+    if (enable && (dev->shadow.control & DS3231_CTRL_EOSC)) {
+        if (DS3231_shadow_write(dev, DS3231_REG_CONTROL, dev->shadow.control & (uint8_t)~DS3231_CTRL_EOSC,
+                                DS3231_CACHE_CONTROL) != DS3231_OK)
+            return DS3231_ERROR;
+    }
+
+    // Parto del valor cacheado sin tocar los flags volatiles.
+    status = DS3231_status_write_value(dev, 0);
     if (enable) 
         status |=  DS3231_STATUS_EN32KHZ;
     else        
         status &= ~DS3231_STATUS_EN32KHZ;
 
-    if (DS3231_parse_hal_status(DS3231_register_write(DS3231_REG_STATUS, status)) != DS3231_OK) 
-        return DS3231_ERROR;
-
-    return DS3231_OK;
+    return DS3231_shadow_write(dev, DS3231_REG_STATUS, status, DS3231_CACHE_STATUS);
 }
 
 
@@ -245,16 +1101,21 @@ DS3231_Status DS3231_Enable32KHz(bool enable)
 /* Configura la frecuencia de la onda cuadrada                                */
 /* -------------------------------------------------------------------------- */
 
-DS3231_Status DS3231_SetSQWFreq(uint8_t rs_bits)
+DS3231_Status DS3231_Dev_SetSQWFreq(DS3231_Handle *dev, uint8_t rs_bits)
 {
+    PROF_SCOPE(PROF_ID_DS3231_SET_SQW_FREQ, 0, NULL);
+
+    if (!dev) return DS3231_INVALID_PARAM;
+
     uint8_t ctrl;
 
-    if (DS3231_parse_hal_status(DS3231_register_read(DS3231_REG_CONTROL, &ctrl)) != DS3231_OK)
+    if (DS3231_shadow_load(dev, DS3231_CACHE_CONTROL) != DS3231_OK)
         return DS3231_ERROR;
 
+    ctrl = dev->shadow.control;
+
     // Verifico que el oscilador esté encendido (EOSC = 0), en caso de que no lo esté lo enciendo.
-    if (ctrl & DS3231_CTRL_EOSC)
-        ctrl &= ~DS3231_CTRL_EOSC;
+    ctrl &= ~DS3231_CTRL_EOSC;
 
     // Limpio el bit INTCN, para asegurarme que el modo sea SQW y no INT.
     ctrl &= ~ DS3231_CTRL_INTCN;
@@ -265,31 +1126,354 @@ DS3231_Status DS3231_SetSQWFreq(uint8_t rs_bits)
     // Configuro la nueva nueva frecuencia
     ctrl |= (rs_bits & (DS3231_CTRL_RS1 | DS3231_CTRL_RS2));
 
-    if (DS3231_parse_hal_status(DS3231_register_write(DS3231_REG_CONTROL, ctrl)) != DS3231_OK)
-        return DS3231_ERROR;
+    // Si ya está configurada, no hace falta escribir.
+    if (ctrl == dev->shadow.control)
+        return DS3231_OK;
 
-    return DS3231_OK;
+    return DS3231_shadow_write(dev, DS3231_REG_CONTROL, ctrl, DS3231_CACHE_CONTROL);
 }
 
 /* -------------------------------------------------------------------------- */
 /* Funciones de lectura y configuracion del envejicimiento                    */
 /* -------------------------------------------------------------------------- */
 
-DS3231_Status DS3231_SetAging(int8_t offset)
+DS3231_Status DS3231_Dev_SetAging(DS3231_Handle *dev, int8_t offset)
 {
-    return (DS3231_parse_hal_status(DS3231_register_write(DS3231_REG_AGING, offset)) == DS3231_OK) ? DS3231_OK : DS3231_ERROR;
+    PROF_SCOPE(PROF_ID_DS3231_SET_AGING, 0, NULL);
+
+    if (!dev) return DS3231_INVALID_PARAM;
+
+    return DS3231_shadow_write(dev, DS3231_REG_AGING, (uint8_t)offset, DS3231_CACHE_AGING);
 }
 
-DS3231_Status DS3231_GetAging(int8_t *offset)
+DS3231_Status DS3231_Dev_GetAging(DS3231_Handle *dev, int8_t *offset)
 {
-    if (!offset) 
+    PROF_SCOPE(PROF_ID_DS3231_GET_AGING, 0, NULL);
+
+    if (!dev || !offset) 
         return DS3231_INVALID_PARAM;
 
-    uint8_t value;
+    if (DS3231_shadow_load(dev, DS3231_CACHE_AGING) != DS3231_OK)
+        return DS3231_ERROR;
+
+    *offset = (int8_t)dev->shadow.aging;
+    return DS3231_OK;
+}
+
+/* -------------------------------------------------------------------------- */
+/* Alarmas                                                                    */
+/* -------------------------------------------------------------------------- */
+
+DS3231_Status DS3231_Dev_SetAlarm(DS3231_Handle *dev, DS3231_AlarmId id, const DS3231_Alarm *alarm)
+{
+    PROF_SCOPE(PROF_ID_DS3231_SET_ALARM, 0, NULL);
+
+    bool a1 = (id == DS3231_ALARM_1);
+    uint8_t buf[1 + DS3231_ALARM1_BUF_SIZE];
+
+    if (!dev || !alarm || (id != DS3231_ALARM_1 && id != DS3231_ALARM_2)) return DS3231_INVALID_PARAM;
+    if (!DS3231_alarm_valid(alarm, a1)) return DS3231_INVALID_PARAM;
+
+    buf[0] = a1 ? DS3231_REG_ALARM_1 : DS3231_REG_ALARM_2;
+    DS3231_encode_alarm(alarm, a1, (DS3231_HourMode)dev->hour_mode, &buf[1]);
+
+    return DS3231_parse_hal_status(DS3231_port_block_write(dev->port, buf,
+                                   (uint16_t)(1 + (a1 ? DS3231_ALARM1_BUF_SIZE : DS3231_ALARM2_BUF_SIZE))));
+}
+
+DS3231_Status DS3231_Dev_GetAlarm(DS3231_Handle *dev, DS3231_AlarmId id, DS3231_Alarm *alarm)
+{
+    PROF_SCOPE(PROF_ID_DS3231_GET_ALARM, 0, NULL);
+
+    bool a1 = (id == DS3231_ALARM_1);
+    uint8_t buf[DS3231_ALARM1_BUF_SIZE];
+    DS3231_Status status;
+
+    if (!dev || !alarm || (id != DS3231_ALARM_1 && id != DS3231_ALARM_2)) return DS3231_INVALID_PARAM;
+
+    status = DS3231_parse_hal_status(DS3231_port_block_read(dev->port, a1 ? DS3231_REG_ALARM_1 : DS3231_REG_ALARM_2,
+                                                            buf, a1 ? DS3231_ALARM1_BUF_SIZE : DS3231_ALARM2_BUF_SIZE));
+    if (status != DS3231_OK) return status;
+
+    DS3231_decode_alarm(buf, a1, alarm);
+    return DS3231_OK;
+}
+
+/**
+ * @brief Programa, limpia el flag y habilita la interrupción. CONTROL y STATUS
+ *        salen de la cache, así que en caliente no hay lecturas.
+ */
+DS3231_Status DS3231_Dev_ArmAlarm(DS3231_Handle *dev, DS3231_AlarmId id, const DS3231_Alarm *alarm)
+{
+    PROF_SCOPE(PROF_ID_DS3231_ARM_ALARM, 0, NULL);
+
+    uint8_t buf[1 + DS3231_ALARM2_BUF_SIZE + 2];
+    uint8_t ctrl, status;
+    HAL_StatusTypeDef hal;
+
+    if (!dev || !alarm || (id != DS3231_ALARM_1 && id != DS3231_ALARM_2)) return DS3231_INVALID_PARAM;
+    if (!DS3231_alarm_valid(alarm, id == DS3231_ALARM_1)) return DS3231_INVALID_PARAM;
 
-    if (DS3231_parse_hal_status(DS3231_register_read(DS3231_REG_AGING, &value)) != DS3231_OK)
+    if (DS3231_shadow_load(dev, DS3231_CACHE_CONTROL | DS3231_CACHE_STATUS) != DS3231_OK)
         return DS3231_ERROR;
 
-    *offset = (int8_t)value;
+    ctrl   = (uint8_t)(dev->shadow.control | DS3231_CTRL_INTCN |
+                       (id == DS3231_ALARM_1 ? DS3231_CTRL_A1IE : DS3231_CTRL_A2IE));
+    status = DS3231_status_write_value(dev, id == DS3231_ALARM_1 ? DS3231_STATUS_A1F : DS3231_STATUS_A2F);
+
+    if (id == DS3231_ALARM_2) {
+        // 0x0B..0x0D alarma, 0x0E control, 0x0F status: una sola ráfaga.
+        buf[0] = DS3231_REG_ALARM_2;
+        DS3231_encode_alarm(alarm, false, (DS3231_HourMode)dev->hour_mode, &buf[1]);
+        buf[1 + DS3231_ALARM2_BUF_SIZE]     = ctrl;
+        buf[1 + DS3231_ALARM2_BUF_SIZE + 1] = status;
+        hal = DS3231_port_block_write(dev->port, buf, sizeof(buf));
+    } else {
+        if (DS3231_Dev_SetAlarm(dev, id, alarm) != DS3231_OK)
+            return DS3231_ERROR;
+        buf[0] = DS3231_REG_CONTROL;
+        buf[1] = ctrl;
+        buf[2] = status;
+        hal = DS3231_port_block_write(dev->port, buf, 3);
+    }
+
+    if (DS3231_parse_hal_status(hal) != DS3231_OK) {
+        dev->shadow.valid &= (uint8_t)~(DS3231_CACHE_CONTROL | DS3231_CACHE_STATUS);
+        return DS3231_ERROR;
+    }
+    dev->shadow.control = ctrl & (uint8_t)~DS3231_CTRL_CONV;
+    dev->shadow.status  = status & (uint8_t)~DS3231_STATUS_VOLATILE;
     return DS3231_OK;
 }
+
+DS3231_Status DS3231_Dev_DisarmAlarm(DS3231_Handle *dev, DS3231_AlarmId id)
+{
+    PROF_SCOPE(PROF_ID_DS3231_DISARM_ALARM, 0, NULL);
+
+    if (!dev || (id != DS3231_ALARM_1 && id != DS3231_ALARM_2)) return DS3231_INVALID_PARAM;
+
+    return DS3231_Dev_ClearControl(dev, id == DS3231_ALARM_1 ? DS3231_CTRL_A1IE : DS3231_CTRL_A2IE);
+}
+
+DS3231_Status DS3231_Dev_AckAlarms(DS3231_Handle *dev, uint8_t *fired)
+{
+    PROF_SCOPE(PROF_ID_DS3231_ACK_ALARMS, 0, NULL);
+
+    uint8_t status;
+    uint8_t flags;
+
+    if (!dev) return DS3231_INVALID_PARAM;
+    if (fired) *fired = 0;
+
+    if (DS3231_Dev_GetStatus(dev, &status) != DS3231_OK)
+        return DS3231_ERROR;
+
+    flags = status & (DS3231_STATUS_A1F | DS3231_STATUS_A2F);
+    if (fired) *fired = flags;
+    if (!flags) return DS3231_OK;
+
+    return DS3231_shadow_write(dev, DS3231_REG_STATUS, DS3231_status_write_value(dev, flags), DS3231_CACHE_STATUS);
+}
+
+/* -------------------------------------------------------------------------- */
+/* API sobre la instancia por defecto                                         */
+/* -------------------------------------------------------------------------- */
+
+void DS3231_CacheInvalidate(void)
+{
+    DS3231_Dev_CacheInvalidate(DS3231_DefaultHandle());
+}
+
+DS3231_Status DS3231_CacheRefresh(void)
+{
+    return DS3231_Dev_CacheRefresh(DS3231_DefaultHandle());
+}
+
+DS3231_Status DS3231_Init(void)
+{
+    return DS3231_Dev_Init(DS3231_DefaultHandle());
+}
+
+DS3231_Status DS3231_ReadTime(DS3231_Time *time)
+{
+    return DS3231_Dev_ReadTime(DS3231_DefaultHandle(), time);
+}
+
+DS3231_Status DS3231_SetTime(uint16_t year, uint8_t month, uint8_t date,
+                                    uint8_t day, uint8_t hour, uint8_t min, uint8_t sec)
+{
+    return DS3231_Dev_SetTime(DS3231_DefaultHandle(), year, month, date, day, hour, min, sec);
+}
+
+DS3231_Status DS3231_SetTimeAligned(const DS3231_Time *time, uint32_t offset_ns,
+                                    DS3231_TickSource ticks, uint32_t ticks_hz)
+{
+    return DS3231_Dev_SetTimeAligned(DS3231_DefaultHandle(), time, offset_ns, ticks, ticks_hz);
+}
+
+void DS3231_SetTimeAligned_OnEdge(uint32_t edge_ticks)
+{
+    DS3231_Dev_SetTimeAligned_OnEdge(DS3231_DefaultHandle(), edge_ticks);
+}
+
+DS3231_Status DS3231_SetTimeAligned_Result(DS3231_AlignedResult *result)
+{
+    return DS3231_Dev_SetTimeAligned_Result(DS3231_DefaultHandle(), result);
+}
+
+DS3231_Status DS3231_AdjustTime(int32_t delta_s)
+{
+    return DS3231_Dev_AdjustTime(DS3231_DefaultHandle(), delta_s);
+}
+
+DS3231_Status DS3231_GetTemperatureQ4(int16_t *temp_q4)
+{
+    return DS3231_Dev_GetTemperatureQ4(DS3231_DefaultHandle(), temp_q4);
+}
+
+#ifndef DS3231_NO_FLOAT
+DS3231_Status DS3231_GetTemperature(float *temp)
+{
+    return DS3231_Dev_GetTemperature(DS3231_DefaultHandle(), temp);
+}
+#endif
+
+DS3231_Status DS3231_ConvertTemperatureAsync(DS3231_TempCallback cb, void *ctx, uint32_t now_ms)
+{
+    return DS3231_Dev_ConvertTemperatureAsync(DS3231_DefaultHandle(), cb, ctx, now_ms);
+}
+
+DS3231_Status DS3231_ConvertTemperaturePoll(uint32_t now_ms)
+{
+    return DS3231_Dev_ConvertTemperaturePoll(DS3231_DefaultHandle(), now_ms);
+}
+
+DS3231_Status DS3231_SetHourMode(DS3231_HourMode mode)
+{
+    return DS3231_Dev_SetHourMode(DS3231_DefaultHandle(), mode);
+}
+
+DS3231_Status DS3231_GetHourMode(DS3231_HourMode *mode)
+{
+    return DS3231_Dev_GetHourMode(DS3231_DefaultHandle(), mode);
+}
+
+DS3231_Status DS3231_ReadSnapshot(DS3231_Snapshot *snap)
+{
+    return DS3231_Dev_ReadSnapshot(DS3231_DefaultHandle(), snap);
+}
+
+DS3231_Status DS3231_ReadTimeAsync(DS3231_TimeCallback cb, void *ctx)
+{
+    return DS3231_Dev_ReadTimeAsync(DS3231_DefaultHandle(), cb, ctx);
+}
+
+DS3231_Status DS3231_GetTemperatureAsync(DS3231_TempCallback cb, void *ctx)
+{
+    return DS3231_Dev_GetTemperatureAsync(DS3231_DefaultHandle(), cb, ctx);
+}
+
+DS3231_Status DS3231_SnapshotDMA_Start(DS3231_SnapshotCallback cb, void *ctx)
+{
+    return DS3231_Dev_SnapshotDMA_Start(DS3231_DefaultHandle(), cb, ctx);
+}
+
+const uint8_t *DS3231_SnapshotDMA_Acquire(uint32_t *seq)
+{
+    return DS3231_Dev_SnapshotDMA_Acquire(DS3231_DefaultHandle(), seq);
+}
+
+void DS3231_SnapshotDMA_Release(void)
+{
+    DS3231_Dev_SnapshotDMA_Release(DS3231_DefaultHandle());
+}
+
+DS3231_Status DS3231_GetStatus(uint8_t *status)
+{
+    return DS3231_Dev_GetStatus(DS3231_DefaultHandle(), status);
+}
+
+DS3231_Status DS3231_ClearStatus(uint8_t mask)
+{
+    return DS3231_Dev_ClearStatus(DS3231_DefaultHandle(), mask);
+}
+
+void DS3231_SetResyncCallback(DS3231_ResyncCallback cb, void *ctx)
+{
+    DS3231_Dev_SetResyncCallback(DS3231_DefaultHandle(), cb, ctx);
+}
+
+DS3231_Status DS3231_Supervise(void)
+{
+    return DS3231_Dev_Supervise(DS3231_DefaultHandle());
+}
+
+bool DS3231_TimeValid(void)
+{
+    return DS3231_Dev_TimeValid(DS3231_DefaultHandle());
+}
+
+DS3231_Status DS3231_GetPowerLoss(DS3231_PowerLoss *event)
+{
+    return DS3231_Dev_GetPowerLoss(DS3231_DefaultHandle(), event);
+}
+
+DS3231_Status DS3231_GetControl(uint8_t *control)
+{
+    return DS3231_Dev_GetControl(DS3231_DefaultHandle(), control);
+}
+
+DS3231_Status DS3231_UpdateControl(uint8_t mask)
+{
+    return DS3231_Dev_UpdateControl(DS3231_DefaultHandle(), mask);
+}
+
+DS3231_Status DS3231_ClearControl(uint8_t mask)
+{
+    return DS3231_Dev_ClearControl(DS3231_DefaultHandle(), mask);
+}
+
+DS3231_Status DS3231_Enable32KHz(bool enable)
+{
+    return DS3231_Dev_Enable32KHz(DS3231_DefaultHandle(), enable);
+}
+
+DS3231_Status DS3231_SetSQWFreq(uint8_t rs_bits)
+{
+    return DS3231_Dev_SetSQWFreq(DS3231_DefaultHandle(), rs_bits);
+}
+
+DS3231_Status DS3231_SetAging(int8_t offset)
+{
+    return DS3231_Dev_SetAging(DS3231_DefaultHandle(), offset);
+}
+
+DS3231_Status DS3231_GetAging(int8_t *offset)
+{
+    return DS3231_Dev_GetAging(DS3231_DefaultHandle(), offset);
+}
+
+DS3231_Status DS3231_SetAlarm(DS3231_AlarmId id, const DS3231_Alarm *alarm)
+{
+    return DS3231_Dev_SetAlarm(DS3231_DefaultHandle(), id, alarm);
+}
+
+DS3231_Status DS3231_GetAlarm(DS3231_AlarmId id, DS3231_Alarm *alarm)
+{
+    return DS3231_Dev_GetAlarm(DS3231_DefaultHandle(), id, alarm);
+}
+
+DS3231_Status DS3231_ArmAlarm(DS3231_AlarmId id, const DS3231_Alarm *alarm)
+{
+    return DS3231_Dev_ArmAlarm(DS3231_DefaultHandle(), id, alarm);
+}
+
+DS3231_Status DS3231_DisarmAlarm(DS3231_AlarmId id)
+{
+    return DS3231_Dev_DisarmAlarm(DS3231_DefaultHandle(), id);
+}
+
+DS3231_Status DS3231_AckAlarms(uint8_t *fired)
+{
+    return DS3231_Dev_AckAlarms(DS3231_DefaultHandle(), fired);
+}
@@ -0,0 +1,45 @@
+/**
+ * @file    ds3231_bcd.c
+ * @brief   Tablas de conversión BCD usadas por ds3231_bcd.h.
+ */
+
+#include "ds3231_bcd.h"
+
+/* Fila de 16 entradas con nibble alto h: 10*h + l, l = 0..15. */
+#define BCD_ROW(h)  \
+    10*(h)+0,  10*(h)+1,  10*(h)+2,  10*(h)+3,  10*(h)+4,  10*(h)+5,  10*(h)+6,  10*(h)+7, \
+    10*(h)+8,  10*(h)+9,  10*(h)+10, 10*(h)+11, 10*(h)+12, 10*(h)+13, 10*(h)+14, 10*(h)+15
+
+/* Decena de 10 entradas: d*16 + u, u = 0..9. */
+#define DEC_ROW(d)  \
+    16*(d)+0,  16*(d)+1,  16*(d)+2,  16*(d)+3,  16*(d)+4, \
+    16*(d)+5,  16*(d)+6,  16*(d)+7,  16*(d)+8,  16*(d)+9
+
+const uint8_t DS3231_bcd2dec_lut[256] = {
+    BCD_ROW(0),  BCD_ROW(1),  BCD_ROW(2),  BCD_ROW(3),
+    BCD_ROW(4),  BCD_ROW(5),  BCD_ROW(6),  BCD_ROW(7),
+    BCD_ROW(8),  BCD_ROW(9),  BCD_ROW(10), BCD_ROW(11),
+    BCD_ROW(12), BCD_ROW(13), BCD_ROW(14), BCD_ROW(15),
+};
+
+const uint8_t DS3231_dec2bcd_lut[100] = {
+    DEC_ROW(0), DEC_ROW(1), DEC_ROW(2), DEC_ROW(3), DEC_ROW(4),
+    DEC_ROW(5), DEC_ROW(6), DEC_ROW(7), DEC_ROW(8), DEC_ROW(9),
+};
+
+/* Horas en 12 h con nibble alto h (bit 4 = decena, bit 5 = PM): (10*h + l) % 12 (+ 12 si PM). */
+#define H12_ROW(h, pm)  \
+    (10*(h)+0)%12+(pm),  (10*(h)+1)%12+(pm),  (10*(h)+2)%12+(pm),  (10*(h)+3)%12+(pm),  \
+    (10*(h)+4)%12+(pm),  (10*(h)+5)%12+(pm),  (10*(h)+6)%12+(pm),  (10*(h)+7)%12+(pm),  \
+    (10*(h)+8)%12+(pm),  (10*(h)+9)%12+(pm),  (10*(h)+10)%12+(pm), (10*(h)+11)%12+(pm), \
+    (10*(h)+12)%12+(pm), (10*(h)+13)%12+(pm), (10*(h)+14)%12+(pm), (10*(h)+15)%12+(pm)
+
+const uint8_t DS3231_hours24_lut[128] = {
+    BCD_ROW(0),     BCD_ROW(1),     BCD_ROW(2),     BCD_ROW(3),         // 24 h: bits 5..0
+    H12_ROW(0, 0),  H12_ROW(1, 0),  H12_ROW(0, 12), H12_ROW(1, 12),     // 12 h: AM, PM
+};
+
+const uint8_t DS3231_hours12_lut[24] = {
+    0x52, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x50, 0x51,   // 12 AM .. 11 AM
+    0x72, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x70, 0x71,   // 12 PM .. 11 PM
+};
@@ -0,0 +1,1941 @@
+/**
+ * @file    ds3231_bench.c
+ * @brief   Benchmark de costo de bus de la API del DS3231 sobre DS3231_Sim.
+ */
+
+#include "ds3231_bench.h"
+#include "ds3231_bcd.h"
+#include <string.h>
+
+/* -------------------------------------------------------------------------- */
+/*  Casos                                                                     */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    const char *name;
+    void (*setup)(void);            // Estado previo (NULL: recién inicializado, cache inválida).
+    DS3231_Status (*run)(void);
+} DS3231_BenchCase;
+
+static void s_warm(void)  { (void)DS3231_CacheRefresh(); }
+
+static void cb_time(DS3231_Status status, const DS3231_Time *time, void *ctx) { }
+static void cb_temp(DS3231_Status status, DS3231_Temp temp, void *ctx) { }
+
+static DS3231_Status b_init(void)            { return DS3231_Init(); }
+static DS3231_Status b_read_time(void)       { DS3231_Time t; return DS3231_ReadTime(&t); }
+static DS3231_Status b_set_time(void)        { return DS3231_SetTime(2025, 9, 25, 4, 16, 5, 30); }
+#ifndef DS3231_NO_FLOAT
+static DS3231_Status b_get_temp(void)        { float t; return DS3231_GetTemperature(&t); }
+#endif
+static DS3231_Status b_get_temp_q4(void)     { int16_t t; return DS3231_GetTemperatureQ4(&t); }
+static DS3231_Status b_read_snapshot(void)   { DS3231_Snapshot s; return DS3231_ReadSnapshot(&s); }
+static DS3231_Status b_time_to_epoch(void)
+{
+    static const DS3231_Time t = { .seconds = 30, .minutes = 5, .hours = 16, .day = 4, .date = 25, .month = 9, .year = 2025 };
+    int64_t e;
+    return DS3231_TimeToEpoch(&t, &e);
+}
+static DS3231_Status b_epoch_to_time(void)   { DS3231_Time t; return DS3231_EpochToTime(1758816330LL, &t); }
+static DS3231_Status b_decode_snapshot(void)
+{
+    static const uint8_t regs[DS3231_REG_MAP_SIZE] = { 0x30, 0x05, 0x16, 0x04, 0x25, 0x09, 0x25 };
+    DS3231_Snapshot s;
+    return DS3231_DecodeSnapshot(regs, &s);
+}
+static DS3231_Status b_read_time_async(void) { return DS3231_ReadTimeAsync(cb_time, NULL); }
+static DS3231_Status b_get_temp_async(void)  { return DS3231_GetTemperatureAsync(cb_temp, NULL); }
+static DS3231_Status b_snapshot_dma(void)    { return DS3231_SnapshotDMA_Start(NULL, NULL); }
+static DS3231_Status b_cache_refresh(void)   { return DS3231_CacheRefresh(); }
+static DS3231_Status b_get_status(void)      { uint8_t v; return DS3231_GetStatus(&v); }
+static DS3231_Status b_clear_status(void)    { return DS3231_ClearStatus(DS3231_STATUS_OSF); }
+static DS3231_Status b_get_control(void)     { uint8_t v; return DS3231_GetControl(&v); }
+static DS3231_Status b_update_control(void)  { return DS3231_UpdateControl(DS3231_CTRL_A1IE); }
+static DS3231_Status b_clear_control(void)   { return DS3231_ClearControl(DS3231_CTRL_A1IE); }
+static DS3231_Status b_32k_on(void)          { return DS3231_Enable32KHz(true); }
+static DS3231_Status b_32k_off(void)         { return DS3231_Enable32KHz(false); }
+static DS3231_Status b_sqw_1hz(void)         { return DS3231_SetSQWFreq(DS3231_SQW_1HZ); }
+static DS3231_Status b_set_aging(void)       { return DS3231_SetAging(-3); }
+static DS3231_Status b_get_aging(void)       { int8_t v; return DS3231_GetAging(&v); }
+static void s_valid(void)                    { (void)DS3231_ClearStatus(DS3231_STATUS_OSF); }
+static DS3231_Status b_supervise(void)       { return DS3231_Supervise(); }
+static DS3231_Status b_time_valid(void)      { return DS3231_TimeValid() ? DS3231_OK : DS3231_NOT_READY; }
+
+static uint32_t bench_run_ticks;
+static uint32_t bench_ticks(void)            { return ++bench_run_ticks; }
+static const DS3231_Time bench_aligned_time = { 30, 5, 16, 4, 25, 9, 2025 };
+static DS3231_Status b_set_aligned(void)     { return DS3231_SetTimeAligned(&bench_aligned_time, DS3231_BENCH_ALIGN_OFFSET_NS, bench_ticks, 1000000U); }
+static void s_aligned(void)                  { (void)b_set_aligned(); }
+static DS3231_Status b_aligned_edge(void)    { DS3231_SetTimeAligned_OnEdge(bench_run_ticks); return DS3231_OK; }
+
+static DS3231_Status b_adjust_0(void)        { return DS3231_AdjustTime(0); }
+static DS3231_Status b_adjust_1s(void)       { return DS3231_AdjustTime(1); }
+static DS3231_Status b_adjust_1h(void)       { return DS3231_AdjustTime(3600); }
+
+static const DS3231_Alarm bench_alarm = { .seconds = 0, .minutes = 30, .hours = 7, .day_date = 1,
+                                          .dy = false, .mask = DS3231_ALARM1_MATCH_HMS };
+
+static DS3231_Status b_set_alarm1(void)      { return DS3231_SetAlarm(DS3231_ALARM_1, &bench_alarm); }
+static DS3231_Status b_set_alarm2(void)      { return DS3231_SetAlarm(DS3231_ALARM_2, &bench_alarm); }
+static DS3231_Status b_get_alarm1(void)      { DS3231_Alarm a; return DS3231_GetAlarm(DS3231_ALARM_1, &a); }
+static DS3231_Status b_arm_alarm1(void)      { return DS3231_ArmAlarm(DS3231_ALARM_1, &bench_alarm); }
+static DS3231_Status b_arm_alarm2(void)      { return DS3231_ArmAlarm(DS3231_ALARM_2, &bench_alarm); }
+static DS3231_Status b_ack_alarms(void)      { uint8_t f; return DS3231_AckAlarms(&f); }
+
+static void s_hr12(void)                     { (void)DS3231_SetHourMode(DS3231_HOURS_12); }
+static DS3231_Status b_set_mode12(void)      { return DS3231_SetHourMode(DS3231_HOURS_12); }
+static DS3231_Status b_get_mode(void)        { DS3231_HourMode m; return DS3231_GetHourMode(&m); }
+
+static DS3231_Sim *bench_sim;
+
+static void cb_conv(DS3231_Status status, DS3231_Temp temp, void *ctx) { }
+static void s_idle(void)                     { DS3231_Sim_Advance(bench_sim, DS3231_SIM_CONV_US); }  // Fin de la conversión de encendido.
+static void s_conv(void)                     { s_idle(); (void)DS3231_ConvertTemperatureAsync(cb_conv, NULL, 0); }
+static void s_conv_due(void)                 { s_conv(); DS3231_Sim_Advance(bench_sim, DS3231_CONV_TIME_MS * 1000U); }
+static DS3231_Status b_conv_start(void)      { return DS3231_ConvertTemperatureAsync(cb_conv, NULL, 0); }
+static DS3231_Status b_conv_early(void)      { return DS3231_ConvertTemperaturePoll(DS3231_CONV_TIME_MS / 2U); }
+static DS3231_Status b_conv_due(void)        { return DS3231_ConvertTemperaturePoll(DS3231_CONV_TIME_MS); }
+
+static DS3231_Clock bench_clock;
+
+static void s_sync(void)                     { (void)DS3231_Clock_Start(&bench_clock, DS3231_DefaultHandle(), DS3231_CLOCK_CHECK_PERIOD_S); }
+static DS3231_Status b_clock_start(void)     { return DS3231_Clock_Start(&bench_clock, DS3231_DefaultHandle(), DS3231_CLOCK_CHECK_PERIOD_S); }
+static DS3231_Status b_clock_now(void)       { DS3231_Time t; return DS3231_Clock_Now(&bench_clock, &t); }
+static DS3231_Status b_clock_poll(void)      { return DS3231_Clock_Poll(&bench_clock); }
+static DS3231_Status b_clock_snapshot(void)  { DS3231_ClockSnapshot s; return DS3231_Clock_Snapshot(&bench_clock, &s); }
+static DS3231_Status b_clock_ts(void)        { DS3231_Timestamp ts; (void)DS3231_Clock_Timestamp(&bench_clock, &ts); return DS3231_OK; }
+
+static const DS3231_BenchCase ds3231_bench_cases[] = {
+    { "Init",                  NULL,   b_init },
+    { "ReadTime",              NULL,   b_read_time },
+    { "SetTime",               NULL,   b_set_time },
+#ifndef DS3231_NO_FLOAT
+    { "GetTemperature",        NULL,   b_get_temp },
+#endif
+    { "ReadSnapshot",          NULL,   b_read_snapshot },
+    { "DecodeSnapshot",        NULL,   b_decode_snapshot },
+    { "TimeToEpoch",           NULL,   b_time_to_epoch },
+    { "EpochToTime",           NULL,   b_epoch_to_time },
+    { "ReadTimeAsync",         NULL,   b_read_time_async },
+    { "GetTemperatureAsync",   NULL,   b_get_temp_async },
+    { "SnapshotDMA_Start",     NULL,   b_snapshot_dma },
+    { "CacheRefresh",          NULL,   b_cache_refresh },
+    { "GetStatus",             NULL,   b_get_status },
+    { "ClearStatus/cold",      NULL,   b_clear_status },
+    { "ClearStatus/warm",      s_warm, b_clear_status },
+    { "GetControl/cold",       NULL,   b_get_control },
+    { "GetControl/warm",       s_warm, b_get_control },
+    { "UpdateControl/cold",    NULL,   b_update_control },
+    { "UpdateControl/warm",    s_warm, b_update_control },
+    { "ClearControl/warm",     s_warm, b_clear_control },
+    { "Enable32KHz_on/cold",   NULL,   b_32k_on },
+    { "Enable32KHz_on/warm",   s_warm, b_32k_on },
+    { "Enable32KHz_off/warm",  s_warm, b_32k_off },
+    { "SetSQWFreq/cold",       NULL,   b_sqw_1hz },
+    { "SetSQWFreq/warm",       s_warm, b_sqw_1hz },
+    { "SetAging",              NULL,   b_set_aging },
+    { "GetAging/cold",         NULL,   b_get_aging },
+    { "GetAging/warm",         s_warm, b_get_aging },
+    { "SetAlarm1",             NULL,   b_set_alarm1 },
+    { "SetAlarm2",             NULL,   b_set_alarm2 },
+    { "GetAlarm1",             NULL,   b_get_alarm1 },
+    { "ArmAlarm1/warm",        s_warm, b_arm_alarm1 },
+    { "ArmAlarm2/cold",        NULL,   b_arm_alarm2 },
+    { "ArmAlarm2/warm",        s_warm, b_arm_alarm2 },
+    { "AckAlarms",             NULL,   b_ack_alarms },
+    { "SetHourMode12",         NULL,   b_set_mode12 },
+    { "SetHourMode12/same",    s_hr12, b_set_mode12 },
+    { "GetHourMode",           NULL,   b_get_mode },
+    { "SetTime/12h",           s_hr12, b_set_time },
+    { "ConvertTempAsync",      s_idle, b_conv_start },
+    { "ConvertTempPoll/early", s_conv, b_conv_early },
+    { "ConvertTempPoll/due",   s_conv_due, b_conv_due },
+    { "GetTemperatureQ4",      NULL,   b_get_temp_q4 },
+    { "ClockStart",            NULL,   b_clock_start },
+    { "ClockNow",              s_sync, b_clock_now },
+    { "ClockPoll/idle",        s_sync, b_clock_poll },
+    { "ClockSnapshot",         s_sync, b_clock_snapshot },
+    { "ClockTimestamp",        s_sync, b_clock_ts },
+    { "Supervise/boot",        NULL,   b_supervise },
+    { "Supervise/valid",       s_valid, b_supervise },
+    { "TimeValid",             s_valid, b_time_valid },
+    { "SetTimeAligned",        NULL,   b_set_aligned },
+    { "SetTimeAligned/edge",   s_aligned, b_aligned_edge },
+    { "AdjustTime/0",          NULL,   b_adjust_0 },
+    { "AdjustTime/+1s",        NULL,   b_adjust_1s },
+    { "AdjustTime/+1h",        NULL,   b_adjust_1h },
+};
+
+#define DS3231_BENCH_N_CASES   ((uint16_t)(sizeof(ds3231_bench_cases) / sizeof(ds3231_bench_cases[0])))
+
+/* -------------------------------------------------------------------------- */
+/*  API pública                                                               */
+/* -------------------------------------------------------------------------- */
+
+uint16_t DS3231_Bench_Count(void)
+{
+    return DS3231_BENCH_N_CASES;
+}
+
+uint16_t DS3231_Bench_Run(DS3231_Sim *sim, DS3231_BenchClock clock,
+                          DS3231_BenchResult *results, uint16_t max)
+{
+    uint16_t n = 0;
+
+    if (!sim || !results) return 0;
+
+    bench_sim = sim;
+    DS3231_port_set_transport(&DS3231_Transport_Sim, sim);
+
+    for (uint16_t i = 0; i < DS3231_BENCH_N_CASES && n < max; i++) {
+        const DS3231_BenchCase *c = &ds3231_bench_cases[i];
+        DS3231_BenchResult *r = &results[n++];
+
+        // Cada caso parte de un chip recién encendido y una cache inválida.
+        DS3231_Sim_Init(sim);
+        (void)DS3231_Init();
+        if (c->setup) c->setup();
+
+        DS3231_Sim_ResetCounters(sim);
+        (void)c->run();
+
+        memset(r, 0, sizeof(*r));
+        strncpy(r->name, c->name, DS3231_BENCH_NAME_LEN - 1);
+        r->transactions = sim->stats.transactions;
+        r->starts       = sim->stats.starts;
+        r->stops        = sim->stats.stops;
+        r->bytes        = sim->stats.bytes;
+        r->bus_ns_400k  = (uint32_t)DS3231_Sim_BusTimeNs(sim, DS3231_SIM_SCL_400KHZ);
+
+        if (clock) {
+            uint64_t t0 = clock();
+            for (uint16_t k = 0; k < DS3231_BENCH_CPU_ITERS; k++) (void)c->run();
+            r->cpu_ns = (uint32_t)((clock() - t0) / DS3231_BENCH_CPU_ITERS);
+        }
+    }
+
+    DS3231_port_set_transport(NULL, NULL);
+    return n;
+}
+
+uint16_t DS3231_Bench_Compare(const DS3231_BenchResult *results, uint16_t count,
+                              const DS3231_BenchResult *baseline, uint16_t n_base,
+                              void (*report)(const DS3231_BenchResult *cur, const DS3231_BenchResult *base))
+{
+    uint16_t regressions = 0;
+
+    for (uint16_t i = 0; i < count; i++) {
+        const DS3231_BenchResult *cur = &results[i];
+
+        for (uint16_t j = 0; j < n_base; j++) {
+            const DS3231_BenchResult *base = &baseline[j];
+
+            if (strncmp(cur->name, base->name, DS3231_BENCH_NAME_LEN) != 0) continue;
+
+            if (cur->transactions > base->transactions || cur->starts > base->starts ||
+                cur->stops > base->stops || cur->bytes > base->bytes) {
+                regressions++;
+                if (report) report(cur, base);
+            }
+            break;
+        }
+    }
+    return regressions;
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Error de timestamps                                                       */
+/* -------------------------------------------------------------------------- */
+
+#define BENCH_NS_PER_S   (1000000000ULL)
+
+static uint64_t bench_ts_cpu_hz;
+static uint64_t bench_ts_now_ns;
+static uint32_t bench_ts_rng;
+
+/* Contador de ciclos de 32 bits de una CPU a bench_ts_cpu_hz en el instante bench_ts_now_ns. */
+static uint32_t bench_ts_cycles(void)
+{
+    uint64_t s  = bench_ts_now_ns / BENCH_NS_PER_S;
+    uint64_t ns = bench_ts_now_ns % BENCH_NS_PER_S;
+    return (uint32_t)(s * bench_ts_cpu_hz + ns * bench_ts_cpu_hz / BENCH_NS_PER_S);
+}
+
+/* Uniforme en [0, range) (LCG, reproducible). */
+static uint32_t bench_ts_rand(uint32_t range)
+{
+    bench_ts_rng = bench_ts_rng * 1664525U + 1013904223U;
+    return range ? (uint32_t)(((uint64_t)(bench_ts_rng >> 8) * range) >> 24) : 0;
+}
+
+static uint64_t bench_ts_isqrt(uint64_t v)
+{
+    uint64_t r = 0;
+    for (uint64_t bit = 1ULL << 62; bit; bit >>= 2) {
+        if (v >= r + bit) { v -= r + bit; r = (r >> 1) + bit; }
+        else              { r >>= 1; }
+    }
+    return r;
+}
+
+void DS3231_Bench_Timestamp(DS3231_Sim *sim, uint32_t seconds, uint32_t jitter_ns, int32_t cpu_ppm,
+                            DS3231_BenchTsError *result)
+{
+    static DS3231_Clock clk;
+    const uint64_t slot = BENCH_NS_PER_S / DS3231_BENCH_TS_QUERIES;
+    uint64_t next_edge;
+    uint32_t edge_idx = 1;
+    int64_t  sum = 0;
+    uint64_t sum_sq = 0;
+
+    if (!sim || !result) return;
+    memset(result, 0, sizeof(*result));
+    if (seconds > 28U * 86400U) seconds = 28U * 86400U;
+
+    bench_ts_cpu_hz = (uint64_t)((int64_t)DS3231_BENCH_TS_CPU_HZ + (int64_t)DS3231_BENCH_TS_CPU_HZ / 1000000 * cpu_ppm);
+    bench_ts_now_ns = 0;
+    bench_ts_rng    = 12345U;
+
+    // t = 0 es 00:00:00 del día 1; los flancos los genera el bench, no el simulador.
+    DS3231_port_set_transport(&DS3231_Transport_Sim, sim);
+    DS3231_Sim_Init(sim);
+    (void)DS3231_Init();
+    (void)DS3231_SetTime(2025, 1, 1, 3, 0, 0, 0);
+    (void)DS3231_Clock_Start(&clk, DS3231_DefaultHandle(), 0);
+    (void)DS3231_Clock_SetCycleSource(&clk, bench_ts_cycles, DS3231_BENCH_TS_CPU_HZ);
+
+    next_edge = BENCH_NS_PER_S + bench_ts_rand(2U * jitter_ns + 1U) - jitter_ns;
+
+    for (uint32_t k = 0; k < seconds; k++) {
+        for (uint32_t q = 0; q < DS3231_BENCH_TS_QUERIES; q++) {
+            uint64_t t = k * BENCH_NS_PER_S + q * slot + bench_ts_rand((uint32_t)slot);
+            DS3231_Timestamp ts;
+
+            while (next_edge <= t) {
+                bench_ts_now_ns = next_edge;
+                DS3231_Clock_OnEdge(&clk);
+                edge_idx++;
+                next_edge = edge_idx * BENCH_NS_PER_S + bench_ts_rand(2U * jitter_ns + 1U) - jitter_ns;
+            }
+
+            bench_ts_now_ns = t;
+            if (DS3231_Clock_Timestamp(&clk, &ts) != DS3231_OK || k < DS3231_BENCH_TS_WARMUP_S) continue;
+
+            uint64_t rtc_s = (uint64_t)(ts.time.date - 1U) * 86400U + ts.time.hours * 3600U +
+                             ts.time.minutes * 60U + ts.time.seconds;
+            int64_t err = (int64_t)(rtc_s * BENCH_NS_PER_S + ts.ns) - (int64_t)t;
+            uint64_t mag = (uint64_t)(err < 0 ? -err : err);
+
+            result->samples++;
+            sum    += err;
+            sum_sq += mag * mag;
+            if (mag > result->max_abs_ns) result->max_abs_ns = (uint32_t)(mag > UINT32_MAX ? UINT32_MAX : mag);
+        }
+    }
+
+    if (result->samples) {
+        result->mean_ns = (int32_t)(sum / (int64_t)result->samples);
+        result->rms_ns  = (uint32_t)bench_ts_isqrt(sum_sq / result->samples);
+    }
+    result->outliers = clk.outliers;
+
+    DS3231_port_set_transport(NULL, NULL);
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Conversiones a tiempo Unix                                                */
+/* -------------------------------------------------------------------------- */
+
+/* Avanza un día con la regla gregoriana completa (referencia independiente). */
+static void bench_epoch_next_day(DS3231_Time *t)
+{
+    static const uint8_t days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    uint16_t y = t->year;
+    bool leap = ((y % 4) == 0 && (y % 100) != 0) || (y % 400) == 0;
+
+    t->day = (uint8_t)((t->day % 7) + 1);
+    if (++t->date <= days[t->month - 1] + (t->month == 2 && leap)) return;
+    t->date = 1;
+    if (++t->month <= 12) return;
+    t->month = 1;
+    t->year++;
+}
+
+void DS3231_Bench_Epoch(uint32_t stride_s, DS3231_BenchClock clock, DS3231_BenchEpoch *result)
+{
+    // 2000-01-01 fue sábado (6 en la convención ISO de DS3231_EpochToTime).
+    DS3231_Time ref = { .seconds = 0, .minutes = 0, .hours = 0, .day = 6, .date = 1,
+                        .month = 1, .year = DS3231_YEAR_MIN };
+    const uint32_t n_days = (uint32_t)((DS3231_EPOCH_MAX + 1 - DS3231_EPOCH_MIN) / 86400);
+
+    if (!result) return;
+    memset(result, 0, sizeof(*result));
+    if (stride_s == 0) stride_s = 1;
+
+    for (uint32_t d = 0; d < n_days; d++) {
+        int64_t base = DS3231_EPOCH_MIN + (int64_t)d * 86400;
+
+        for (uint32_t sod = d % stride_s; sod < 86400U; sod += stride_s) {
+            DS3231_Time t;
+            int64_t back = -1;
+
+            result->checked++;
+            if (DS3231_EpochToTime(base + sod, &t) != DS3231_OK ||
+                t.seconds != sod % 60U || t.minutes != (sod / 60U) % 60U || t.hours != sod / 3600U ||
+                t.day != ref.day || t.date != ref.date || t.month != ref.month ||
+                t.year != ref.year ||
+                DS3231_TimeToEpoch(&t, &back) != DS3231_OK || back != base + sod) {
+                result->mismatches++;
+            }
+        }
+        bench_epoch_next_day(&ref);
+    }
+
+    if (clock) {
+        static int64_t epochs[DS3231_BENCH_EPOCH_SET];
+        static DS3231_Time times[DS3231_BENCH_EPOCH_SET];
+        const uint32_t reps = 256;
+        volatile int64_t sink = 0;
+        uint64_t t0;
+
+        bench_ts_rng = 777U;
+        for (uint32_t i = 0; i < DS3231_BENCH_EPOCH_SET; i++) {
+            epochs[i] = DS3231_EPOCH_MIN + (int64_t)bench_ts_rand(n_days) * 86400 + bench_ts_rand(86400U);
+        }
+
+        t0 = clock();
+        for (uint32_t r = 0; r < reps; r++) {
+            for (uint32_t i = 0; i < DS3231_BENCH_EPOCH_SET; i++) (void)DS3231_EpochToTime(epochs[i], &times[i]);
+        }
+        result->to_time_ps = (uint32_t)((clock() - t0) * 1000U / ((uint64_t)reps * DS3231_BENCH_EPOCH_SET));
+
+        t0 = clock();
+        for (uint32_t r = 0; r < reps; r++) {
+            for (uint32_t i = 0; i < DS3231_BENCH_EPOCH_SET; i++) {
+                int64_t e;
+                (void)DS3231_TimeToEpoch(&times[i], &e);
+                sink += e;
+            }
+        }
+        result->to_epoch_ps = (uint32_t)((clock() - t0) * 1000U / ((uint64_t)reps * DS3231_BENCH_EPOCH_SET));
+        (void)sink;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Cache de CONTROL, STATUS y AGING                                          */
+/* -------------------------------------------------------------------------- */
+
+static void bench_expect(bool ok, DS3231_BenchCheck *result)
+{
+    result->checked++;
+    if (!ok) result->mismatches++;
+}
+
+/* Verifica el resultado de una llamada y sus transacciones exactas; reinicia los contadores. */
+static void bench_cache_cost(DS3231_Sim *sim, DS3231_Status got, uint32_t tx, DS3231_BenchCheck *result)
+{
+    bench_expect(got == DS3231_OK && sim->stats.transactions == tx, result);
+    DS3231_Sim_ResetCounters(sim);
+}
+
+void DS3231_Bench_Cache(DS3231_Sim *sim, DS3231_BenchCheck *result)
+{
+    uint8_t v;
+    int8_t  aging;
+
+    if (!sim || !result) return;
+    memset(result, 0, sizeof(*result));
+
+    DS3231_port_set_transport(&DS3231_Transport_Sim, sim);
+    DS3231_Sim_Init(sim);
+
+    // GetControl: en frío una ráfaga 0x0E..0x10, en caliente sin bus.
+    (void)DS3231_Init();
+    DS3231_Sim_ResetCounters(sim);
+    bench_cache_cost(sim, DS3231_GetControl(&v), 1, result);
+    bench_expect(v == (sim->regs[DS3231_REG_CONTROL] & (uint8_t)~DS3231_CTRL_CONV), result);
+    bench_cache_cost(sim, DS3231_GetControl(&v), 0, result);
+
+    // UpdateControl / ClearControl: en frío ráfaga + escritura, en caliente solo la escritura.
+    (void)DS3231_Init();
+    DS3231_Sim_ResetCounters(sim);
+    bench_cache_cost(sim, DS3231_UpdateControl(DS3231_CTRL_A1IE), 2, result);
+    bench_cache_cost(sim, DS3231_UpdateControl(DS3231_CTRL_A2IE), 1, result);
+    bench_expect((sim->regs[DS3231_REG_CONTROL] & (DS3231_CTRL_A1IE | DS3231_CTRL_A2IE)) ==
+                 (DS3231_CTRL_A1IE | DS3231_CTRL_A2IE), result);
+    bench_cache_cost(sim, DS3231_ClearControl(DS3231_CTRL_A1IE), 1, result);
+    (void)DS3231_Init();
+    DS3231_Sim_ResetCounters(sim);
+    bench_cache_cost(sim, DS3231_ClearControl(DS3231_CTRL_A2IE), 2, result);
+    bench_expect(!(sim->regs[DS3231_REG_CONTROL] & (DS3231_CTRL_A1IE | DS3231_CTRL_A2IE)), result);
+    bench_cache_cost(sim, DS3231_GetControl(&v), 0, result);
+    bench_expect(v == (sim->regs[DS3231_REG_CONTROL] & (uint8_t)~DS3231_CTRL_CONV), result);
+
+    // ClearStatus: en frío ráfaga + escritura, en caliente solo la escritura.
+    (void)DS3231_Init();
+    sim->regs[DS3231_REG_STATUS] |= DS3231_STATUS_OSF | DS3231_STATUS_A1F;
+    DS3231_Sim_ResetCounters(sim);
+    bench_cache_cost(sim, DS3231_ClearStatus(DS3231_STATUS_OSF), 2, result);
+    bench_expect((sim->regs[DS3231_REG_STATUS] & (DS3231_STATUS_OSF | DS3231_STATUS_A1F)) == DS3231_STATUS_A1F, result);
+    bench_cache_cost(sim, DS3231_ClearStatus(DS3231_STATUS_A1F), 1, result);
+    bench_expect(!(sim->regs[DS3231_REG_STATUS] & DS3231_STATUS_A1F), result);
+
+    // SetAging no lee: una escritura aun en frío, y deja AGING en cache.
+    (void)DS3231_Init();
+    DS3231_Sim_ResetCounters(sim);
+    bench_cache_cost(sim, DS3231_SetAging(-3), 1, result);
+    bench_cache_cost(sim, DS3231_GetAging(&aging), 0, result);
+    bench_expect(aging == -3 && sim->regs[DS3231_REG_AGING] == (uint8_t)-3, result);
+
+    // Un cambio externo no se ve hasta invalidar; GetAging en frío es una ráfaga.
+    sim->regs[DS3231_REG_AGING] = 5;
+    bench_cache_cost(sim, DS3231_GetAging(&aging), 0, result);
+    bench_expect(aging == -3, result);
+    DS3231_CacheInvalidate();
+    bench_cache_cost(sim, DS3231_GetAging(&aging), 1, result);
+    bench_expect(aging == 5, result);
+
+    // Una escritura fallida invalida el registro: la siguiente lectura vuelve al chip.
+    sim->present = false;
+    bench_expect(DS3231_UpdateControl(DS3231_CTRL_A1IE) == DS3231_ERROR, result);
+    sim->present = true;
+    DS3231_Sim_ResetCounters(sim);
+    bench_cache_cost(sim, DS3231_GetControl(&v), 1, result);
+    bench_expect(!(v & DS3231_CTRL_A1IE), result);
+
+    (void)DS3231_Init();
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Lecturas asíncronas y doble buffer por DMA                                */
+/* -------------------------------------------------------------------------- */
+
+#define BENCH_ASYNC_OTHER_ADDR  (0x50)      // Segundo dispositivo del bus (p.ej. una EEPROM).
+
+typedef struct {
+    uint32_t      calls;
+    DS3231_Status status;
+    DS3231_Time   time;
+    uint8_t       next;     // Dirección de la transferencia en curso al entrar al callback (0 = bus libre).
+} bench_async_read;
+
+static char    bench_async_order[8];        // Orden de los callbacks: 'R' DS3231, 'E' el otro dispositivo.
+static uint8_t bench_async_n;
+
+static void bench_async_mark(char who)
+{
+    if (bench_async_n < sizeof(bench_async_order) - 1U) bench_async_order[bench_async_n++] = who;
+}
+
+static void bench_async_time(DS3231_Status status, const DS3231_Time *time, void *ctx)
+{
+    bench_async_read *r = (bench_async_read *)ctx;
+    const I2CM_SimTransfer *x = I2CM_Sim_GetPending();
+
+    r->calls++;
+    r->next   = x ? x->address : 0;
+    r->status = status;
+    r->time   = *time;
+    bench_async_mark('R');
+}
+
+static void bench_async_other(HAL_StatusTypeDef status, void *ctx)
+{
+    *(HAL_StatusTypeDef *)ctx = status;
+    bench_async_mark('E');
+}
+
+static void bench_async_snap(DS3231_Status status, void *ctx)
+{
+    (*(uint32_t *)ctx)++;
+}
+
+/* Termina la transferencia en curso como la ISR de I2C; las lecturas del DS3231 copian los registros de @p sim. */
+static bool bench_async_complete(const DS3231_Sim *sim, HAL_StatusTypeDef status)
+{
+    const I2CM_SimTransfer *x = I2CM_Sim_GetPending();
+
+    if (!x) return false;
+    if (status == HAL_OK && x->is_read && x->address == DS3231_ADDRESS) {
+        for (uint16_t i = 0; i < x->size; i++) x->data[i] = sim->regs[(x->reg + i) % DS3231_REG_MAP_SIZE];
+    }
+    I2CM_Async_Complete(status);
+    return true;
+}
+
+static bool bench_async_pending(uint8_t address, uint8_t reg, uint16_t size, bool dma)
+{
+    const I2CM_SimTransfer *x = I2CM_Sim_GetPending();
+    return x && x->address == address && x->is_read && x->reg == reg && x->size == size && x->use_dma == dma;
+}
+
+void DS3231_Bench_Async(DS3231_Sim *sim, DS3231_BenchCheck *result)
+{
+    static const DS3231_Time t0 = { 30, 5, 16, 4, 25, 9, 2025 };
+    static DS3231_Handle rtc;
+    static uint8_t other_buf[4];
+    static I2CM_Request other_req;
+    HAL_StatusTypeDef other_st = HAL_OK;
+    bench_async_read rd = { 0 };
+    I2CM_Device other;
+
+    if (!sim || !result) return;
+    memset(result, 0, sizeof(*result));
+    bench_async_n = 0;
+    memset(bench_async_order, 0, sizeof(bench_async_order));
+
+    // La hora se escribe por el simulador; el handle lee por dev_i2cm, que deja
+    // cada transferencia pendiente hasta bench_async_complete().
+    DS3231_port_set_transport(&DS3231_Transport_Sim, sim);
+    DS3231_Sim_Init(sim);
+    (void)DS3231_Init();
+    (void)DS3231_SetTime(t0.year, t0.month, t0.date, t0.day, t0.hours, t0.minutes, t0.seconds);
+    (void)DS3231_HandleInit(&rtc, &DS3231_Transport_HAL, NULL, DS3231_ADDRESS);
+
+    const I2CM_DeviceConfig other_cfg = { .bus = NULL, .address = BENCH_ASYNC_OTHER_ADDR };
+    bench_expect(I2CM_Register(&other_cfg, &other) == HAL_OK, result);
+    other_req = (I2CM_Request){ .dev = other, .op = I2CM_OP_READ_SR, .reg = 0x10, .data = other_buf,
+                                .size = sizeof(other_buf), .cb = bench_async_other, .ctx = &other_st };
+
+    // Lectura en curso: un segundo pedido del mismo chip es BUSY y no toca el bus.
+    bench_expect(DS3231_Dev_ReadTimeAsync(&rtc, bench_async_time, &rd) == DS3231_OK, result);
+    bench_expect(bench_async_pending(DS3231_ADDRESS, DS3231_REG_SECONDS, DS3231_MAX_BLOCK_READ, false) && rd.calls == 0, result);
+    bench_expect(DS3231_Dev_ReadTimeAsync(&rtc, bench_async_time, &rd) == DS3231_BUSY, result);
+    bench_expect(DS3231_Dev_GetTemperatureAsync(&rtc, cb_temp, NULL) == DS3231_BUSY, result);
+    bench_expect(DS3231_Dev_SnapshotDMA_Start(&rtc, NULL, NULL) == DS3231_BUSY, result);
+
+    // Otro dispositivo: el inicio directo es BUSY, el encolado espera su turno.
+    bench_expect(I2CM_Read_Sr_IT(BENCH_ASYNC_OTHER_ADDR, 0x10, other_buf, sizeof(other_buf), NULL, NULL) == HAL_BUSY, result);
+    bench_expect(I2CM_Submit(&other_req) == HAL_OK, result);
+    bench_expect(bench_async_pending(DS3231_ADDRESS, DS3231_REG_SECONDS, DS3231_MAX_BLOCK_READ, false), result);
+
+    // Al terminar la del DS3231 arranca la encolada, antes del callback.
+    bench_expect(bench_async_complete(sim, HAL_OK), result);
+    bench_expect(rd.calls == 1 && rd.status == DS3231_OK && memcmp(&rd.time, &t0, sizeof(t0)) == 0, result);
+    bench_expect(rd.next == BENCH_ASYNC_OTHER_ADDR, result);
+    bench_expect(bench_async_pending(BENCH_ASYNC_OTHER_ADDR, 0x10, sizeof(other_buf), false), result);
+
+    // Pedido del DS3231 con el otro en vuelo: queda en cola y sale después, aunque el otro falle.
+    bench_expect(DS3231_Dev_ReadTimeAsync(&rtc, bench_async_time, &rd) == DS3231_OK, result);
+    bench_expect(bench_async_pending(BENCH_ASYNC_OTHER_ADDR, 0x10, sizeof(other_buf), false) && rd.calls == 1, result);
+    bench_expect(bench_async_complete(sim, HAL_ERROR) && other_st == HAL_ERROR, result);
+    bench_expect(bench_async_pending(DS3231_ADDRESS, DS3231_REG_SECONDS, DS3231_MAX_BLOCK_READ, false), result);
+    bench_expect(bench_async_complete(sim, HAL_OK) && rd.calls == 2 && rd.status == DS3231_OK, result);
+    bench_expect(I2CM_Sim_GetPending() == NULL && strcmp(bench_async_order, "RER") == 0, result);
+
+    // Error de bus en la lectura del DS3231: llega al callback.
+    (void)DS3231_Dev_ReadTimeAsync(&rtc, bench_async_time, &rd);
+    bench_expect(bench_async_complete(sim, HAL_ERROR) && rd.calls == 3 && rd.status == DS3231_ERROR, result);
+
+    (void)I2CM_Unregister(other);
+}
+
+void DS3231_Bench_SnapshotDMA(DS3231_Sim *sim, DS3231_BenchCheck *result)
+{
+    static DS3231_Handle rtc;
+    uint8_t held_copy[DS3231_REG_MAP_SIZE];
+    const uint8_t *held, *fresh;
+    uint32_t snaps = 0, seq = 0;
+
+    if (!sim || !result) return;
+    memset(result, 0, sizeof(*result));
+
+    DS3231_port_set_transport(&DS3231_Transport_Sim, sim);
+    DS3231_Sim_Init(sim);
+    (void)DS3231_Init();
+    (void)DS3231_SetTime(2025, 9, 25, 4, 16, 5, 30);
+    (void)DS3231_HandleInit(&rtc, &DS3231_Transport_HAL, NULL, DS3231_ADDRESS);
+
+    // Nada publicado todavía.
+    bench_expect(DS3231_Dev_SnapshotDMA_Acquire(&rtc, &seq) == NULL, result);
+    bench_expect(DS3231_Dev_SnapshotDMA_Start(&rtc, bench_async_snap, &snaps) == DS3231_OK, result);
+    bench_expect(bench_async_pending(DS3231_ADDRESS, DS3231_REG_SECONDS, DS3231_REG_MAP_SIZE, true) &&
+                 I2CM_Sim_GetPending()->data == rtc.snap.regs[rtc.snap.front ^ 1], result);
+    bench_expect(bench_async_complete(sim, HAL_OK) && snaps == 1, result);
+
+    held = DS3231_Dev_SnapshotDMA_Acquire(&rtc, &seq);
+    bench_expect(held && seq == 1 && memcmp(held, sim->regs, DS3231_REG_MAP_SIZE) == 0, result);
+    if (!held) return;
+    memcpy(held_copy, held, sizeof(held_copy));
+
+    // Con el frontal tomado, el DMA llena el otro; al terminar se publica sin tocar el tomado.
+    DS3231_Sim_Advance(sim, 1000000U);
+    bench_expect(DS3231_Dev_SnapshotDMA_Start(&rtc, bench_async_snap, &snaps) == DS3231_OK, result);
+    bench_expect(I2CM_Sim_GetPending() && I2CM_Sim_GetPending()->data != held, result);
+    bench_expect(bench_async_complete(sim, HAL_OK) && snaps == 2 && rtc.snap.seq == 2, result);
+    bench_expect(memcmp(held, held_copy, sizeof(held_copy)) == 0 &&
+                 rtc.snap.regs[rtc.snap.front] != held, result);
+
+    // El único buffer libre es el tomado: no se inicia otra lectura hasta liberarlo.
+    bench_expect(DS3231_Dev_SnapshotDMA_Start(&rtc, bench_async_snap, &snaps) == DS3231_BUSY &&
+                 I2CM_Sim_GetPending() == NULL, result);
+    DS3231_Dev_SnapshotDMA_Release(&rtc);
+
+    fresh = DS3231_Dev_SnapshotDMA_Acquire(&rtc, &seq);
+    bench_expect(fresh && fresh != held && seq == 2 && memcmp(fresh, sim->regs, DS3231_REG_MAP_SIZE) == 0 &&
+                 fresh[DS3231_REG_SECONDS] != held_copy[DS3231_REG_SECONDS], result);
+    DS3231_Dev_SnapshotDMA_Release(&rtc);
+    bench_expect(DS3231_Dev_SnapshotDMA_Start(&rtc, bench_async_snap, &snaps) == DS3231_OK &&
+                 I2CM_Sim_GetPending()->data == held, result);
+    bench_expect(bench_async_complete(sim, HAL_OK) && snaps == 3, result);
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Cambio de siglo                                                           */
+/* -------------------------------------------------------------------------- */
+
+static void bench_century_edge(DS3231_SimEdge edge, void *ctx)
+{
+    if (edge == DS3231_SIM_EDGE_SQW) DS3231_Clock_OnEdge((DS3231_Clock *)ctx);
+}
+
+/* Lee el chip y el reloj por SQW y los compara con @p ref. */
+static void bench_century_check(DS3231_Clock *clk, const DS3231_Time *ref, DS3231_BenchCheck *result)
+{
+    DS3231_Time chip, local;
+
+    result->checked++;
+    if (DS3231_ReadTime(&chip) != DS3231_OK || DS3231_Clock_Now(clk, &local) != DS3231_OK ||
+        memcmp(&chip, ref, sizeof(chip)) != 0 || memcmp(&local, ref, sizeof(local)) != 0) {
+        result->mismatches++;
+    }
+}
+
+void DS3231_Bench_Century(DS3231_Sim *sim, DS3231_BenchCheck *result)
+{
+    static const uint8_t days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    static DS3231_Clock clk;
+
+    if (!sim || !result) return;
+    memset(result, 0, sizeof(*result));
+
+    DS3231_port_set_transport(&DS3231_Transport_Sim, sim);
+    DS3231_Sim_Init(sim);
+    sim->on_edge  = bench_century_edge;
+    sim->edge_ctx = &clk;
+    (void)DS3231_Init();
+    (void)DS3231_Clock_Start(&clk, DS3231_DefaultHandle(), 0);
+
+    // Último segundo de cada mes -> primer segundo del siguiente.
+    for (uint16_t year = DS3231_YEAR_MIN; year <= DS3231_YEAR_MAX; year++) {
+        for (uint8_t month = 1; month <= 12; month++) {
+            uint8_t last = (uint8_t)(days[month - 1] + (month == 2 && (year % 4) == 0));
+            DS3231_Time ref = { .seconds = 59, .minutes = 59, .hours = 23, .day = 7,
+                                .date = last, .month = month, .year = year };
+
+            (void)DS3231_SetTime(year, month, last, ref.day, 23, 59, 59);
+            (void)DS3231_Clock_Resync(&clk);
+            bench_century_check(&clk, &ref, result);
+            result->checked++;
+            if ((sim->regs[DS3231_REG_MONTH] & DS3231_MONTH_CENTURY) != (year >= 2100U ? DS3231_MONTH_CENTURY : 0)) {
+                result->mismatches++;
+            }
+
+            DS3231_Sim_Advance(sim, 1000000U);
+            ref = (DS3231_Time){ .seconds = 0, .minutes = 0, .hours = 0, .day = 1, .date = 1,
+                                 .month = (uint8_t)(month % 12U + 1U), .year = year };
+            if (month == 12) ref.year = (year == DS3231_YEAR_MAX) ? DS3231_YEAR_MIN : (uint16_t)(year + 1U);
+            bench_century_check(&clk, &ref, result);
+        }
+    }
+
+    // Segundo a segundo alrededor de 2099 -> 2100 (jueves 2099-12-31).
+    DS3231_Time ref = { .seconds = 0, .minutes = 0, .hours = 0, .day = 4, .date = 31, .month = 12, .year = 2099 };
+    int64_t start;
+
+    (void)DS3231_TimeToEpoch(&ref, &start);
+    (void)DS3231_SetTime(ref.year, ref.month, ref.date, ref.day, 0, 0, 0);
+    (void)DS3231_Clock_Resync(&clk);
+    for (uint32_t k = 0; k < 2U * 86400U; k++) {
+        (void)DS3231_EpochToTime(start + k, &ref);
+        bench_century_check(&clk, &ref, result);
+        DS3231_Sim_Advance(sim, 1000000U);
+    }
+
+    sim->on_edge = NULL;
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Formato 12/24 h                                                           */
+/* -------------------------------------------------------------------------- */
+
+/* Lee la hora y el registro de horas; verifica hours == @p h y el formato @p mode. */
+static void bench_hour_check(DS3231_Sim *sim, uint8_t h, DS3231_HourMode mode, DS3231_BenchCheck *result)
+{
+    DS3231_Time t;
+    uint8_t reg = sim->regs[DS3231_REG_HOURS];
+
+    result->checked++;
+    if (DS3231_ReadTime(&t) != DS3231_OK || t.hours != h ||
+        ((reg & DS3231_HOURS_12H) != 0) != (mode == DS3231_HOURS_12)) {
+        result->mismatches++;
+    }
+}
+
+void DS3231_Bench_HourMode(DS3231_Sim *sim, DS3231_BenchCheck *result)
+{
+    if (!sim || !result) return;
+    memset(result, 0, sizeof(*result));
+
+    DS3231_port_set_transport(&DS3231_Transport_Sim, sim);
+    DS3231_Sim_Init(sim);
+    (void)DS3231_Init();
+
+    for (uint8_t m = 0; m < 2; m++) {
+        DS3231_HourMode mode  = m ? DS3231_HOURS_12 : DS3231_HOURS_24;
+        DS3231_HourMode other = m ? DS3231_HOURS_24 : DS3231_HOURS_12;
+
+        for (uint8_t h = 0; h < 24; h++) {
+            uint8_t next = (uint8_t)((h + 1U) % 24U);
+            DS3231_Alarm a = { .seconds = 0, .minutes = 0, .hours = next, .day_date = 1,
+                               .dy = false, .mask = DS3231_ALARM1_MATCH_HMS };
+            DS3231_Alarm back;
+            uint8_t fired = 0;
+
+            (void)DS3231_SetHourMode(mode);
+            (void)DS3231_SetTime(2025, 1, 1, 3, h, 59, 59);
+            bench_hour_check(sim, h, mode, result);
+
+            // El cambio de formato con 59:59 se rechaza; con 59:58 conserva la hora.
+            result->checked++;
+            if (DS3231_SetHourMode(other) != DS3231_BUSY) result->mismatches++;
+            (void)DS3231_SetTime(2025, 1, 1, 3, h, 59, 58);
+            (void)DS3231_SetHourMode(other);
+            bench_hour_check(sim, h, other, result);
+            (void)DS3231_SetHourMode(mode);
+            bench_hour_check(sim, h, mode, result);
+
+            (void)DS3231_SetAlarm(DS3231_ALARM_1, &a);
+            (void)DS3231_AckAlarms(NULL);
+            result->checked++;
+            if (DS3231_GetAlarm(DS3231_ALARM_1, &back) != DS3231_OK || back.hours != next ||
+                ((sim->regs[DS3231_REG_ALARM_1 + 2] & DS3231_HOURS_12H) != 0) != (mode == DS3231_HOURS_12)) {
+                result->mismatches++;
+            }
+
+            DS3231_Sim_Advance(sim, 2000000U);
+            bench_hour_check(sim, next, mode, result);
+            result->checked++;
+            if (DS3231_AckAlarms(&fired) != DS3231_OK || !(fired & DS3231_STATUS_A1F)) result->mismatches++;
+        }
+
+        // Los campos enmascarados no se validan: fuera de rango se escriben en 0 sin tocar el bit 12/24.
+        DS3231_Alarm any = { .seconds = 0, .minutes = 200, .hours = 255, .day_date = 99,
+                             .dy = false, .mask = DS3231_ALARM1_MATCH_S };
+        const uint8_t *reg = &sim->regs[DS3231_REG_ALARM_1];
+
+        result->checked++;
+        if (DS3231_SetAlarm(DS3231_ALARM_1, &any) != DS3231_OK || reg[1] != DS3231_ALARM_AXM ||
+            reg[2] != (uint8_t)(DS3231_ALARM_AXM | DS3231_bcd_hours_reg(0, mode)) || reg[3] != DS3231_ALARM_AXM) {
+            result->mismatches++;
+        }
+    }
+
+    (void)DS3231_SetHourMode(DS3231_HOURS_24);
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Supervisión de OSF                                                        */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    bool     available;     // La fuente de hora está disponible.
+    uint32_t calls;
+} bench_resync_ctx;
+
+static DS3231_Status bench_resync(const DS3231_PowerLoss *event, void *ctx)
+{
+    bench_resync_ctx *c = (bench_resync_ctx *)ctx;
+
+    c->calls++;
+    if (!c->available) return DS3231_NOT_READY;
+    return DS3231_SetTime(2031, 5, 17, 6, 8, 30, 0);
+}
+
+/* Resincroniza con la fuente disponible: callback (1 escritura) + limpieza de OSF (1 escritura). */
+static void bench_power_resolve(DS3231_Sim *sim, bench_resync_ctx *ctx, DS3231_BenchCheck *result)
+{
+    ctx->available = true;
+    DS3231_Sim_ResetCounters(sim);
+    bench_expect(DS3231_Supervise() == DS3231_OK && DS3231_TimeValid(), result);
+    bench_expect(sim->stats.transactions == 2 && !(sim->regs[DS3231_REG_STATUS] & DS3231_STATUS_OSF), result);
+    bench_expect(sim->regs[DS3231_REG_YEAR] == 0x31 && sim->regs[DS3231_REG_DATE] == 0x17, result);
+}
+
+void DS3231_Bench_PowerLoss(DS3231_Sim *sim, DS3231_BenchCheck *result)
+{
+    bench_resync_ctx ctx = { .available = false };
+    DS3231_PowerLoss ev;
+    DS3231_Snapshot snap;
+    DS3231_Time good;
+    uint32_t base;
+
+    if (!sim || !result) return;
+    memset(result, 0, sizeof(*result));
+
+    DS3231_port_set_transport(&DS3231_Transport_Sim, sim);
+    DS3231_Sim_Init(sim);
+    (void)DS3231_Init();
+    DS3231_SetResyncCallback(bench_resync, &ctx);
+    DS3231_Sim_Advance(sim, 3000000U);
+
+    // Arranque: OSF de power-on, sin fuente de hora todavía. Una lectura, ninguna escritura.
+    bench_expect(!DS3231_TimeValid(), result);
+    DS3231_Sim_ResetCounters(sim);
+    bench_expect(DS3231_Supervise() == DS3231_NOT_READY && !DS3231_TimeValid(), result);
+    bench_expect(sim->stats.transactions == 1 && (sim->regs[DS3231_REG_STATUS] & DS3231_STATUS_OSF), result);
+    bench_expect(DS3231_GetPowerLoss(&ev) == DS3231_OK && ev.detected.year == 2000 && ev.detected.seconds == 3, result);
+    base = ev.count;    // El handle por defecto acumula los eventos de los casos anteriores.
+
+    // El evento pendiente no se vuelve a registrar en otras lecturas.
+    (void)DS3231_ReadSnapshot(&snap);
+    bench_expect(DS3231_GetPowerLoss(&ev) == DS3231_OK && ev.count == base && ctx.calls == 1, result);
+    bench_power_resolve(sim, &ctx, result);
+
+    // Lecturas periódicas: la hora buena queda registrada; las consultas no usan el bus.
+    DS3231_Sim_Advance(sim, 5000000U);
+    (void)DS3231_ReadSnapshot(&snap);
+    good = snap.time;
+    DS3231_Sim_ResetCounters(sim);
+    bench_expect(DS3231_TimeValid() && DS3231_Supervise() == DS3231_OK && sim->stats.transactions == 0, result);
+
+    // Corte sin batería, visto por un snapshot bloqueante.
+    DS3231_Sim_PowerLoss(sim, 30000000U, false);
+    DS3231_Sim_Advance(sim, 2000000U);
+    bench_expect(DS3231_ReadSnapshot(&snap) == DS3231_OK && !DS3231_TimeValid(), result);
+    bench_expect(DS3231_GetPowerLoss(&ev) == DS3231_OK && ev.count == base + 1 &&
+                 memcmp(&ev.last_good, &good, sizeof(good)) == 0 && ev.detected.year == 2000, result);
+    bench_power_resolve(sim, &ctx, result);
+
+    // Corte sin batería, visto por el snapshot por DMA (callback de la ISR).
+    (void)DS3231_ReadSnapshot(&snap);
+    good = snap.time;
+    DS3231_Sim_PowerLoss(sim, 1000000U, false);
+    bench_expect(DS3231_SnapshotDMA_Start(NULL, NULL) == DS3231_OK && !DS3231_TimeValid(), result);
+    bench_expect(DS3231_GetPowerLoss(&ev) == DS3231_OK && ev.count == base + 2 &&
+                 memcmp(&ev.last_good, &good, sizeof(good)) == 0, result);
+    bench_power_resolve(sim, &ctx, result);
+
+    // Corte con batería: el oscilador sigue y la hora es válida.
+    DS3231_Sim_PowerLoss(sim, 60000000U, true);
+    bench_expect(DS3231_ReadSnapshot(&snap) == DS3231_OK && DS3231_TimeValid(), result);
+    bench_expect(DS3231_GetPowerLoss(&ev) == DS3231_OK && ev.count == base + 2 && ctx.calls == 4, result);
+
+    DS3231_SetResyncCallback(NULL, NULL);
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Escritura alineada                                                        */
+/* -------------------------------------------------------------------------- */
+
+static DS3231_Sim *bench_align_sim;
+static uint64_t    bench_align_sqw_us;      // Primer flanco de SQW después de la escritura (0 = ninguno).
+
+/* Contador de 1 MHz sobre el tiempo virtual; cada lectura consume 1 µs de CPU. */
+static uint32_t bench_align_ticks(void)
+{
+    DS3231_Sim_Advance(bench_align_sim, 1);
+    return (uint32_t)bench_align_sim->now_us;
+}
+
+static void bench_align_edge(DS3231_SimEdge edge, void *ctx)
+{
+    if (edge == DS3231_SIM_EDGE_SQW && bench_align_sqw_us == 0) bench_align_sqw_us = bench_align_sim->now_us;
+}
+
+/* Fase real: primer flanco de SQW después del de referencia, menos 1 s. */
+static int32_t bench_align_measure(DS3231_Sim *sim, uint64_t ref_us)
+{
+    bench_align_sqw_us = 0;
+    DS3231_Sim_Advance(sim, 1000000U + 500000U - (sim->now_us - ref_us));
+    return (int32_t)((int64_t)(bench_align_sqw_us - ref_us) - 1000000) * 1000;
+}
+
+/* Avanza hasta el próximo flanco de referencia (0.437 s dentro del segundo virtual) y lo retorna. */
+static uint64_t bench_align_next_ref(DS3231_Sim *sim)
+{
+    uint64_t ref = (sim->now_us / 1000000U + 1U) * 1000000U + 437000U;
+    DS3231_Sim_Advance(sim, ref - sim->now_us);
+    return ref;
+}
+
+static bool bench_align_phase_ok(int32_t measured_ns, int32_t phase_ns)
+{
+    int32_t d = measured_ns - phase_ns;
+    return d >= -1000 && d <= 1000;     // Resolución del contador: 1 µs.
+}
+
+void DS3231_Bench_Aligned(DS3231_Sim *sim, DS3231_BenchAligned *result)
+{
+    DS3231_Time t = { .seconds = 59, .minutes = 59, .hours = 23, .day = 3, .date = 31, .month = 12, .year = 2030 };
+    DS3231_AlignedResult res;
+    DS3231_Time now;
+    uint64_t ref;
+
+    if (!sim || !result) return;
+    memset(result, 0, sizeof(*result));
+    DS3231_BenchCheck *chk = &result->check;
+
+    DS3231_port_set_transport(&DS3231_Transport_Sim, sim);
+    DS3231_Sim_Init(sim);
+    (void)DS3231_Init();
+    (void)DS3231_SetSQWFreq(DS3231_SQW_1HZ);
+    DS3231_Sim_SetBusSpeed(sim, DS3231_SIM_SCL_400KHZ);
+    bench_align_sim = sim;
+    sim->on_edge    = bench_align_edge;
+
+    bench_expect(DS3231_SetTimeAligned(&t, 0, NULL, 1000000U) == DS3231_INVALID_PARAM, chk);
+    bench_expect(DS3231_SetTimeAligned(&t, DS3231_ALIGN_MAX_OFFSET_NS + 1U, bench_align_ticks, 1000000U) == DS3231_INVALID_PARAM, chk);
+
+    // Offset suficiente: la ISR espera y el ACK de los segundos cae en ref + offset.
+    bench_expect(DS3231_SetTimeAligned(&t, DS3231_BENCH_ALIGN_OFFSET_NS, bench_align_ticks, 1000000U) == DS3231_OK, chk);
+    bench_expect(DS3231_SetTimeAligned_Result(&res) == DS3231_BUSY, chk);
+    ref = bench_align_next_ref(sim);
+    DS3231_Sim_Advance(sim, DS3231_BENCH_ALIGN_ISR_US);
+    DS3231_Sim_ResetCounters(sim);
+    DS3231_SetTimeAligned_OnEdge((uint32_t)ref);
+    bench_expect(sim->stats.transactions == 1, chk);
+    bench_expect(DS3231_SetTimeAligned_Result(&res) == DS3231_OK && res.status == DS3231_OK && !res.late &&
+                 res.latency_ticks == DS3231_BENCH_ALIGN_ISR_US + 1U, chk);
+    result->phase_ns    = res.phase_ns;
+    result->measured_ns = bench_align_measure(sim, ref);
+    bench_expect(res.phase_ns == (int32_t)DS3231_BENCH_ALIGN_OFFSET_NS, chk);
+    bench_expect(bench_align_phase_ok(result->measured_ns, res.phase_ns), chk);
+
+    // Después del flanco del chip ya corre el segundo siguiente (acarreo hasta el año).
+    bench_expect(DS3231_ReadTime(&now) == DS3231_OK && now.year == 2031 && now.month == 1 && now.date == 1 &&
+                 now.hours == 0 && now.minutes == 0 && now.seconds == 0, chk);
+
+    // Sin escritura armada el flanco no usa el bus.
+    DS3231_Sim_ResetCounters(sim);
+    DS3231_SetTimeAligned_OnEdge((uint32_t)sim->now_us);
+    bench_expect(sim->stats.transactions == 0, chk);
+
+    // Offset menor que la latencia: la ISR no espera ni escribe y el resultado es DS3231_TIMEOUT.
+    bench_expect(DS3231_SetTimeAligned(&t, 0, bench_align_ticks, 1000000U) == DS3231_OK, chk);
+    ref = bench_align_next_ref(sim);
+    DS3231_Sim_Advance(sim, DS3231_BENCH_ALIGN_ISR_US);
+    DS3231_Sim_ResetCounters(sim);
+    DS3231_SetTimeAligned_OnEdge((uint32_t)ref);
+    bench_expect(sim->stats.transactions == 0 && sim->now_us - ref == DS3231_BENCH_ALIGN_ISR_US + 1U, chk);
+    bench_expect(DS3231_SetTimeAligned_Result(&res) == DS3231_OK && res.status == DS3231_TIMEOUT && res.late, chk);
+
+    // Referencia: la misma hora escrita desde el lazo principal, 0.3 s después del flanco.
+    ref = bench_align_next_ref(sim);
+    DS3231_Sim_Advance(sim, 300000U);
+    (void)DS3231_SetTime(t.year, t.month, t.date, t.day, t.hours, t.minutes, t.seconds);
+    result->naive_ns = bench_align_measure(sim, ref);
+
+    sim->on_edge = NULL;
+    DS3231_Sim_SetBusSpeed(sim, 0);
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Ajuste por diferencia y slew                                              */
+/* -------------------------------------------------------------------------- */
+
+static const DS3231_Time bench_adjust_starts[] = {
+    { 30,  5, 16, 4, 25,  9, 2025 },
+    { 58, 59, 23, 2, 31, 12, 2030 },
+    { 30, 59, 23, 5, 31, 12, 2099 },
+    {  0, 30, 23, 3, 28,  2, 2024 },
+    {  0,  0, 12, 7, 29,  2, 2028 },
+    {  0,  0,  0, 6,  1,  1, 2000 },
+    {  0, 30, 23, 7, 28,  2, 2100 },
+    {  0,  0, 12, 1, 29,  2, 2100 },
+};
+
+static const int32_t bench_adjust_deltas[] = {
+    0, 1, -1, 29, 60, -60, 1800, 3600, -3600, 43200, 86400, -86400, 31 * 86400, 365 * 86400,
+};
+
+/* Tramo de registros 0x00..0x06 que difiere entre dos estados del modelo (0 = ninguno). */
+static uint8_t bench_adjust_span(const uint8_t *before, const uint8_t *after, uint8_t *first)
+{
+    int8_t lo = -1, hi = -1;
+
+    for (int8_t i = 0; i < DS3231_MAX_BLOCK_READ; i++) {
+        if (before[i] == after[i]) continue;
+        if (lo < 0) lo = i;
+        hi = i;
+    }
+    *first = (uint8_t)lo;
+    return (lo < 0) ? 0 : (uint8_t)(hi - lo + 1);
+}
+
+/* Referencia en el calendario del chip (bisiesto cada 4 años, también 2100): avanza día por día. */
+static uint8_t bench_chip_days_in_month(uint8_t month, uint16_t year)
+{
+    static const uint8_t days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+    return (month == 2 && (year % 4) == 0) ? 29 : days[month - 1];
+}
+
+static bool bench_chip_add(const DS3231_Time *start, int32_t delta, DS3231_Time *t)
+{
+    int64_t sod  = start->hours * 3600 + start->minutes * 60 + start->seconds + (int64_t)delta;
+    int32_t days = (int32_t)(sod >= 0 ? sod / 86400 : -((-sod + 86399) / 86400));
+
+    sod -= (int64_t)days * 86400;
+    *t = *start;
+    t->day     = (uint8_t)((start->day - 1 + days % 7 + 7) % 7 + 1);
+    t->hours   = (uint8_t)(sod / 3600);
+    t->minutes = (uint8_t)((sod / 60) % 60);
+    t->seconds = (uint8_t)(sod % 60);
+
+    for (; days > 0; days--) {
+        if (++t->date <= bench_chip_days_in_month(t->month, t->year)) continue;
+        t->date = 1;
+        if (++t->month > 12) { t->month = 1; t->year++; }
+    }
+    for (; days < 0; days++) {
+        if (--t->date > 0) continue;
+        if (--t->month == 0) { t->month = 12; t->year--; }
+        t->date = bench_chip_days_in_month(t->month, t->year);
+    }
+    return t->year >= DS3231_YEAR_MIN && t->year <= DS3231_YEAR_MAX;
+}
+
+static void bench_adjust_one(DS3231_Sim *sim, const DS3231_Time *start, int32_t delta, DS3231_BenchAdjust *result)
+{
+    DS3231_BenchCheck *chk = &result->check;
+    uint8_t before[DS3231_MAX_BLOCK_READ];
+    DS3231_Time exp, now;
+
+    (void)DS3231_SetTime(start->year, start->month, start->date, start->day, start->hours, start->minutes,
+                         start->seconds);
+    DS3231_Sim_Advance(sim, 300000U);   // A mitad de segundo: un tramo sin segundos no debe moverlo.
+    memcpy(before, sim->regs, sizeof(before));
+    uint32_t subsec = sim->subsec_us;
+
+    bool in_range = bench_chip_add(start, delta, &exp);
+
+    DS3231_Sim_ResetCounters(sim);
+    DS3231_Status st = DS3231_AdjustTime(delta);
+    DS3231_SimStats stats = sim->stats;
+
+    if (!in_range) {
+        bench_expect(st == DS3231_INVALID_PARAM && stats.transactions == 1, chk);
+        return;
+    }
+
+    uint8_t first;
+    uint8_t span = bench_adjust_span(before, sim->regs, &first);
+    bench_expect(st == DS3231_OK, chk);
+    bench_expect(stats.transactions == 1U + (span ? 1U : 0U) && stats.bytes == 10U + (span ? 2U + span : 0U), chk);
+    bench_expect((span && first == 0) ? sim->subsec_us == 0 : sim->subsec_us == subsec, chk);
+    bench_expect(DS3231_ReadTime(&now) == DS3231_OK && memcmp(&now, &exp, sizeof(now)) == 0, chk);
+
+    if (span) {
+        result->adjusts++;
+        result->bytes      += stats.bytes;
+        result->full_bytes += 10U + 9U;
+    }
+}
+
+void DS3231_Bench_Adjust(DS3231_Sim *sim, DS3231_BenchAdjust *result)
+{
+    DS3231_Slew slew;
+
+    if (!sim || !result) return;
+    memset(result, 0, sizeof(*result));
+
+    DS3231_port_set_transport(&DS3231_Transport_Sim, sim);
+    DS3231_Sim_Init(sim);
+    (void)DS3231_Init();
+
+    for (uint8_t mode = DS3231_HOURS_24; mode <= DS3231_HOURS_12; mode++) {
+        (void)DS3231_SetHourMode((DS3231_HourMode)mode);
+        for (uint32_t i = 0; i < sizeof(bench_adjust_starts) / sizeof(bench_adjust_starts[0]); i++) {
+            for (uint32_t j = 0; j < sizeof(bench_adjust_deltas) / sizeof(bench_adjust_deltas[0]); j++) {
+                bench_adjust_one(sim, &bench_adjust_starts[i], bench_adjust_deltas[j], result);
+                bench_adjust_one(sim, &bench_adjust_starts[i], -bench_adjust_deltas[j], result);
+            }
+        }
+    }
+    (void)DS3231_SetHourMode(DS3231_HOURS_24);
+
+    // En :59 no se escribe nada.
+    (void)DS3231_SetTime(2025, 9, 25, 4, 16, 5, 59);
+    DS3231_Sim_ResetCounters(sim);
+    bench_expect(DS3231_AdjustTime(3600) == DS3231_BUSY && sim->stats.transactions == 1, &result->check);
+
+    // Slew sin margen de AGING en el sentido pedido.
+    (void)DS3231_SetAging(INT8_MAX);
+    bench_expect(DS3231_Slew_Start(&slew, DS3231_DefaultHandle(), -1000, 0, 0, 0) == DS3231_INVALID_PARAM, &result->check);
+    bench_expect(DS3231_Slew_Start(&slew, DS3231_DefaultHandle(), DS3231_SLEW_MAX_US + 1, 0, 0, 0) == DS3231_INVALID_PARAM,
+                 &result->check);
+}
+
+/* Fase del chip respecto del tiempo real del simulador, en ns. */
+static int64_t bench_slew_phase_ns(const DS3231_Sim *sim)
+{
+    DS3231_Snapshot snap;
+    int64_t epoch;
+
+    (void)DS3231_DecodeSnapshot(sim->regs, &snap);
+    (void)DS3231_TimeToEpoch(&snap.time, &epoch);
+    return (epoch * 1000000 + sim->subsec_us - (int64_t)sim->now_us) * 1000 + sim->frac / 1000000U;
+}
+
+void DS3231_Bench_Slew(DS3231_Sim *sim, int32_t offset_us, uint8_t lsb, DS3231_BenchSlew *result)
+{
+    DS3231_Slew slew;
+    int8_t aging;
+
+    if (!sim || !result) return;
+    memset(result, 0, sizeof(*result));
+    DS3231_BenchCheck *chk = &result->check;
+
+    DS3231_port_set_transport(&DS3231_Transport_Sim, sim);
+    DS3231_Sim_Init(sim);
+    (void)DS3231_Init();
+    (void)DS3231_SetTime(2025, 9, 25, 4, 16, 5, 30);
+    // Chip calibrado: AGING = 7 cancela el error del cristal, así la fase solo cambia por el slew.
+    DS3231_Sim_SetFrequencyError(sim, 7 * DS3231_SIM_AGING_PPB);
+    (void)DS3231_SetAging(7);
+    DS3231_Sim_Advance(sim, DS3231_SIM_TCXO_PERIOD_S * 1000000ULL);    // La conversión automática lo aplica.
+
+    int64_t  before = bench_slew_phase_ns(sim);
+    uint64_t t0     = sim->now_us;
+    DS3231_Sim_ResetCounters(sim);
+
+    DS3231_Status st = DS3231_Slew_Start(&slew, DS3231_DefaultHandle(), offset_us, 0, lsb, (uint32_t)(sim->now_us / 1000U));
+    bench_expect(st == DS3231_OK && slew.state == DS3231_SLEW_APPLYING, chk);
+
+    uint64_t limit = t0 + (uint64_t)slew.duration_ms * 1000U + 10000000U;
+    while (st == DS3231_OK && slew.state != DS3231_SLEW_DONE && sim->now_us < limit) {
+        DS3231_Sim_Advance(sim, 10000U);
+        st = DS3231_Slew_Poll(&slew, (uint32_t)(sim->now_us / 1000U));
+    }
+
+    result->achieved_ns  = (int32_t)(bench_slew_phase_ns(sim) - before);
+    result->duration_s   = (uint32_t)((sim->now_us - t0) / 1000000U);
+    result->base_aging   = slew.base_aging;
+    result->slew_aging   = slew.slew_aging;
+    result->transactions = sim->stats.transactions;
+
+    int32_t err = result->achieved_ns - offset_us * 1000;
+    bench_expect(st == DS3231_OK && slew.state == DS3231_SLEW_DONE, chk);
+    bench_expect(err >= -1000 && err <= 1000, chk);
+    bench_expect(DS3231_GetAging(&aging) == DS3231_OK && aging == 7 && sim->aging_applied == 7, chk);
+    bench_expect(DS3231_Sim_FrequencyError(sim) == 0, chk);
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Conversión de temperatura forzada                                         */
+/* -------------------------------------------------------------------------- */
+
+/* Cuartos de grado -> DS3231_Temp. */
+#ifdef DS3231_NO_FLOAT
+#define BENCH_TEMP(q4)  ((DS3231_Temp)(q4))
+#else
+#define BENCH_TEMP(q4)  ((q4) * 0.25f)
+#endif
+
+typedef struct {
+    uint32_t      calls;
+    DS3231_Status status;
+    DS3231_Temp   temp;
+} bench_conv_result;
+
+static void bench_conv_cb(DS3231_Status status, DS3231_Temp temp, void *ctx)
+{
+    bench_conv_result *r = (bench_conv_result *)ctx;
+
+    r->calls++;
+    r->status = status;
+    r->temp   = temp;
+}
+
+void DS3231_Bench_Conversion(DS3231_Sim *sim, DS3231_BenchConv *result)
+{
+    bench_conv_result r = { 0 };
+    uint32_t now_ms = 0;
+
+    if (!sim || !result) return;
+    memset(result, 0, sizeof(*result));
+
+    DS3231_port_set_transport(&DS3231_Transport_Sim, sim);
+    DS3231_Sim_Init(sim);
+    (void)DS3231_Init();
+
+    // Conversión normal: 37.25 °C en el modelo, consulta cada 1 ms. Antes
+    // termina la conversión automática de encendido.
+    DS3231_Sim_Advance(sim, DS3231_SIM_CONV_US);
+    DS3231_Sim_SetTemperature(sim, 149);
+    DS3231_Sim_ResetCounters(sim);
+    bench_expect(DS3231_ConvertTemperatureAsync(bench_conv_cb, &r, now_ms) == DS3231_OK, &result->check);
+    bench_expect(DS3231_ConvertTemperatureAsync(bench_conv_cb, &r, now_ms) == DS3231_BUSY, &result->check);
+    while (r.calls == 0 && now_ms < 2U * DS3231_CONV_TIMEOUT_MS) {
+        DS3231_Sim_Advance(sim, 1000U);
+        (void)DS3231_ConvertTemperaturePoll(++now_ms);
+    }
+    result->latency_ms   = now_ms;
+    result->transactions = sim->stats.transactions;
+    result->bytes        = sim->stats.bytes;
+    bench_expect(r.calls == 1 && r.status == DS3231_OK && r.temp == BENCH_TEMP(149), &result->check);
+    bench_expect(now_ms >= DS3231_SIM_CONV_US / 1000U && now_ms <= DS3231_CONV_TIME_MS + DS3231_CONV_POLL_MS, &result->check);
+
+    // Durante la conversión automática (cada 64 s) no se puede forzar otra.
+    while (!(sim->regs[DS3231_REG_STATUS] & DS3231_STATUS_BSY) && now_ms < 70000U) {
+        DS3231_Sim_Advance(sim, 1000U);
+        now_ms++;
+    }
+    bench_expect(DS3231_ConvertTemperatureAsync(bench_conv_cb, &r, now_ms) == DS3231_BUSY, &result->check);
+    DS3231_Sim_Advance(sim, DS3231_SIM_CONV_US);
+    now_ms += DS3231_SIM_CONV_US / 1000U;
+
+    // Error de bus durante la espera: llega al callback y libera la conversión.
+    r.calls = 0;
+    bench_expect(DS3231_ConvertTemperatureAsync(bench_conv_cb, &r, now_ms) == DS3231_OK, &result->check);
+    sim->present = false;
+    DS3231_Sim_Advance(sim, DS3231_CONV_TIME_MS * 1000U);
+    (void)DS3231_ConvertTemperaturePoll(now_ms + DS3231_CONV_TIME_MS);
+    sim->present = true;
+    bench_expect(r.calls == 1 && r.status == DS3231_ERROR, &result->check);
+    bench_expect(DS3231_ConvertTemperaturePoll(now_ms + DS3231_CONV_TIME_MS) == DS3231_OK, &result->check);
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Calibración de AGING                                                      */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    DS3231_Sim      *sim;
+    DS3231_Cal      *cal;
+    DS3231_SimEdge   edge;          // Evento que corresponde a la fuente elegida.
+    DS3231_CalRecord stored;
+    uint32_t         stores;
+} bench_cal_ctx;
+
+/* Captura ideal: contador de referencia derivado del tiempo real del modelo. */
+static void bench_cal_edge(DS3231_SimEdge edge, void *ctx)
+{
+    bench_cal_ctx *c = (bench_cal_ctx *)ctx;
+
+    if (edge == c->edge) DS3231_Cal_OnEvent(c->cal, (uint32_t)(c->sim->now_us * (DS3231_BENCH_TS_CPU_HZ / 1000000U)));
+}
+
+static void bench_cal_store(const DS3231_CalRecord *rec, void *ctx)
+{
+    bench_cal_ctx *c = (bench_cal_ctx *)ctx;
+
+    c->stored = *rec;
+    c->stores++;
+}
+
+void DS3231_Bench_Calibration(DS3231_Sim *sim, DS3231_CalSource source, int32_t ppb, int16_t aging_ppb,
+                              DS3231_BenchCal *result)
+{
+    static DS3231_Cal cal;
+    bench_cal_ctx ctx = { .sim = sim, .cal = &cal };
+
+    if (!sim || !result) return;
+    memset(result, 0, sizeof(*result));
+
+    DS3231_port_set_transport(&DS3231_Transport_Sim, sim);
+    DS3231_Sim_Init(sim);
+    DS3231_Sim_SetFrequencyError(sim, ppb);
+    sim->aging_ppb = aging_ppb;
+    sim->on_edge   = bench_cal_edge;
+    sim->edge_ctx  = &ctx;
+    ctx.edge = (source == DS3231_CAL_SRC_SQW) ? DS3231_SIM_EDGE_SQW : DS3231_SIM_EDGE_32KHZ;
+    (void)DS3231_Init();
+    DS3231_Sim_ResetCounters(sim);
+
+    result->ppb_initial = DS3231_Sim_FrequencyError(sim);
+    bench_expect(DS3231_Cal_Start(&cal, DS3231_DefaultHandle(), source, DS3231_BENCH_TS_CPU_HZ) == DS3231_OK, &result->check);
+    DS3231_Cal_SetStore(&cal, bench_cal_store, &ctx);
+
+    // Hasta DS3231_CAL_MAX_STEPS ventanas, más las conversiones entre ellas.
+    while (cal.state == DS3231_CAL_MEASURING || cal.state == DS3231_CAL_APPLYING) {
+        if (sim->now_us > (uint64_t)(DS3231_CAL_MAX_STEPS + 1U) * (DS3231_CAL_WINDOW + 2U) * 1000000U) break;
+        DS3231_Sim_Advance(sim, 10000U);
+        (void)DS3231_Cal_Poll(&cal, (uint32_t)(sim->now_us / 1000U));
+    }
+    sim->on_edge = NULL;
+
+    result->ppb_residual = DS3231_Sim_FrequencyError(sim);
+    result->ppb_measured = cal.ppb;
+    result->aging        = cal.aging;
+    result->steps        = cal.steps;
+    result->sens_ppb     = (uint16_t)cal.sens_ppb;
+    result->duration_s   = cal.record.duration_s;
+    result->transactions = sim->stats.transactions;
+
+    int32_t residual = result->ppb_residual < 0 ? -result->ppb_residual : result->ppb_residual;
+    bench_expect(cal.state == DS3231_CAL_CONVERGED && 2 * residual <= aging_ppb, &result->check);
+    bench_expect((int8_t)sim->regs[DS3231_REG_AGING] == cal.aging, &result->check);
+    bench_expect(source != DS3231_CAL_SRC_32KHZ || (sim->regs[DS3231_REG_STATUS] & DS3231_STATUS_EN32KHZ), &result->check);
+    bench_expect(ctx.stores == 1 && memcmp(&ctx.stored, &cal.record, sizeof(ctx.stored)) == 0, &result->check);
+
+    // Corte sin batería: AGING vuelve a 0 y se recupera del registro guardado.
+    DS3231_Sim_PowerLoss(sim, 1000000U, false);
+    bench_expect(DS3231_Cal_Restore(DS3231_DefaultHandle(), &ctx.stored) == DS3231_OK &&
+                 (int8_t)sim->regs[DS3231_REG_AGING] == cal.aging, &result->check);
+    ctx.stored.aging++;
+    bench_expect(DS3231_Cal_Restore(DS3231_DefaultHandle(), &ctx.stored) == DS3231_INVALID_PARAM, &result->check);
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Modelo de deriva por temperatura                                          */
+/* -------------------------------------------------------------------------- */
+
+#define BENCH_DRIFT_BASE_PPB    (1500)      // Error del cristal a 25 °C.
+#define BENCH_DRIFT_TC_PPB      (4)         // Curvatura del residuo, ppb/°C².
+#define BENCH_DRIFT_STEP_MS     (100U)
+#define BENCH_DRIFT_LEARN_S     (48U * 3600U)
+#define BENCH_DRIFT_CHECK_S     (24U * 3600U)
+
+typedef struct {
+    DS3231_Sim   *sim;
+    DS3231_Drift *drift;
+} bench_drift_ctx;
+
+static void bench_drift_edge(DS3231_SimEdge edge, void *ctx)
+{
+    bench_drift_ctx *c = (bench_drift_ctx *)ctx;
+
+    if (edge == DS3231_SIM_EDGE_SQW)
+        DS3231_Drift_OnEvent(c->drift, (uint32_t)(c->sim->now_us * (DS3231_BENCH_TS_CPU_HZ / 1000000U)));
+}
+
+/* Perfil triangular de lo_q4 a hi_q4 y vuelta en period_s. */
+static int16_t bench_drift_temp(uint32_t t_s, int16_t lo_q4, int16_t hi_q4, uint32_t period_s)
+{
+    uint32_t half  = period_s / 2U;
+    uint32_t phase = t_s % period_s;
+    uint32_t pos   = (phase < half) ? phase : period_s - phase;
+
+    return (int16_t)(lo_q4 + (int32_t)((int64_t)(hi_q4 - lo_q4) * pos / half));
+}
+
+void DS3231_Bench_Drift(DS3231_Sim *sim, DS3231_BenchDrift *result)
+{
+    static DS3231_Drift drift;
+    static int16_t saved[DS3231_DRIFT_BINS];
+    bench_drift_ctx ctx = { .sim = sim, .drift = &drift };
+
+    if (!sim || !result) return;
+    memset(result, 0, sizeof(*result));
+
+    DS3231_port_set_transport(&DS3231_Transport_Sim, sim);
+    DS3231_Sim_Init(sim);
+    DS3231_Sim_SetFrequencyError(sim, BENCH_DRIFT_BASE_PPB);
+    DS3231_Sim_SetTempCoefficient(sim, BENCH_DRIFT_TC_PPB);
+    sim->on_edge  = bench_drift_edge;
+    sim->edge_ctx = &ctx;
+    (void)DS3231_Init();
+
+    // Aprendizaje: SQW contra la referencia, 5..35 °C en 24 h.
+    bool ok = DS3231_Drift_Start(&drift, DS3231_DefaultHandle(), DS3231_CAL_SRC_SQW, DS3231_BENCH_TS_CPU_HZ,
+                                 sim->aging_ppb) == DS3231_OK;
+    for (uint32_t ms = 0; ms < BENCH_DRIFT_LEARN_S * 1000U; ms += BENCH_DRIFT_STEP_MS) {
+        if (ms % 60000U == 0) DS3231_Sim_SetTemperature(sim, bench_drift_temp(ms / 1000U, 5 * 4, 35 * 4, 24U * 3600U));
+        DS3231_Sim_Advance(sim, BENCH_DRIFT_STEP_MS * 1000U);
+        if (DS3231_Drift_Poll(&drift, (uint32_t)(sim->now_us / 1000U)) != DS3231_OK) ok = false;
+    }
+    bench_expect(ok, &result->check);
+    sim->on_edge = NULL;
+
+    result->learned = drift.learned;
+    for (uint16_t i = 0; i < DS3231_DRIFT_BINS; i++) {
+        if (drift.table[i] != DS3231_DRIFT_EMPTY) result->bins++;
+    }
+    memcpy(saved, drift.table, sizeof(saved));
+
+    // Reinicio sin referencia: la tabla se restaura como lo haría la aplicación.
+    ok = DS3231_Drift_Start(&drift, DS3231_DefaultHandle(), DS3231_CAL_SRC_SQW, 0, sim->aging_ppb) == DS3231_OK;
+    memcpy(drift.table, saved, sizeof(saved));
+    DS3231_Sim_ResetCounters(sim);
+
+    int32_t fixed_aging = (BENCH_DRIFT_BASE_PPB + sim->aging_ppb / 2) / sim->aging_ppb;
+    int64_t sum_sq = 0, fixed_sum_sq = 0, sum_ps = 0, fixed_sum_ps = 0;
+    uint32_t n = 0;
+
+    for (uint32_t ms = 0; ms < BENCH_DRIFT_CHECK_S * 1000U; ms += BENCH_DRIFT_STEP_MS) {
+        if (ms % 60000U == 0) DS3231_Sim_SetTemperature(sim, bench_drift_temp(ms / 1000U, 8 * 4, 32 * 4, 6U * 3600U));
+        DS3231_Sim_Advance(sim, BENCH_DRIFT_STEP_MS * 1000U);
+        if (DS3231_Drift_Poll(&drift, (uint32_t)(sim->now_us / 1000U)) != DS3231_OK) ok = false;
+
+        // Con AGING fijo el error es el del cristal menos la corrección calibrada a 25 °C.
+        int32_t e = DS3231_Sim_FrequencyError(sim);
+        int32_t f = e + ((int32_t)sim->aging_applied - fixed_aging) * sim->aging_ppb;
+        int32_t ae = e < 0 ? -e : e;
+        int32_t af = f < 0 ? -f : f;
+
+        if (ae > result->max_ppb) result->max_ppb = ae;
+        if (af > result->fixed_max_ppb) result->fixed_max_ppb = af;
+        sum_sq       += (int64_t)e * e;
+        fixed_sum_sq += (int64_t)f * f;
+        sum_ps       += (int64_t)e * BENCH_DRIFT_STEP_MS;     // ppb * ms = ps
+        fixed_sum_ps += (int64_t)f * BENCH_DRIFT_STEP_MS;
+        n++;
+    }
+    bench_expect(ok, &result->check);
+
+    result->updates       = drift.updates;
+    result->transactions  = sim->stats.transactions;
+    result->rms_ppb       = (int32_t)bench_ts_isqrt((uint64_t)(sum_sq / n));
+    result->fixed_rms_ppb = (int32_t)bench_ts_isqrt((uint64_t)(fixed_sum_sq / n));
+    result->time_us       = (int32_t)(sum_ps / 1000000);
+    result->fixed_time_us = (int32_t)(fixed_sum_ps / 1000000);
+
+    int32_t at = result->time_us < 0 ? -result->time_us : result->time_us;
+    int32_t af = result->fixed_time_us < 0 ? -result->fixed_time_us : result->fixed_time_us;
+    bench_expect(result->learned > 0 && result->bins >= (35 - 5) * 4 / 2, &result->check);
+    bench_expect(result->updates > 0 && (int8_t)sim->regs[DS3231_REG_AGING] == drift.aging, &result->check);
+    bench_expect(result->rms_ppb <= sim->aging_ppb && 4 * at < af, &result->check);
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Codificación BCD                                                          */
+/* -------------------------------------------------------------------------- */
+
+typedef void (*bench_bcd_decode)(const uint8_t *buf, DS3231_Time *time);
+typedef void (*bench_bcd_encode)(const DS3231_Time *time, uint8_t *buf);
+
+static const bench_bcd_decode bench_bcd_decoders[DS3231_BENCH_BCD_IMPLS] = {
+    [DS3231_BCD_SCALAR] = DS3231_bcd_decode_time_scalar,
+    [DS3231_BCD_SWAR]   = DS3231_bcd_decode_time_swar,
+    [DS3231_BCD_TABLE]  = DS3231_bcd_decode_time_table,
+};
+
+static const bench_bcd_encode bench_bcd_encoders[DS3231_BENCH_BCD_IMPLS] = {
+    [DS3231_BCD_SCALAR] = DS3231_bcd_encode_time_scalar,
+    [DS3231_BCD_SWAR]   = DS3231_bcd_encode_time_swar,
+    [DS3231_BCD_TABLE]  = DS3231_bcd_encode_time_table,
+};
+
+/*
+ * Cada variante se mide en su propio lazo con la llamada directa (no por
+ * puntero) para que el compilador la expanda igual que en ds3231.c.
+ */
+#define BENCH_BCD_TIME(clock, reps, expr, out)                                    \
+    do {                                                                          \
+        uint64_t t0_ = (clock)();                                                 \
+        for (uint32_t r_ = 0; r_ < (reps); r_++) {                                \
+            for (uint32_t i = 0; i < DS3231_BENCH_BCD_SET; i++) { expr; }         \
+            __asm__ volatile("" ::: "memory");                                    \
+        }                                                                         \
+        (out) = (uint32_t)(((clock)() - t0_) * 1000U / ((uint64_t)(reps) * DS3231_BENCH_BCD_SET)); \
+    } while (0)
+
+void DS3231_Bench_Bcd(DS3231_BenchClock clock, DS3231_BenchBcd *result)
+{
+    static uint8_t regs[DS3231_BENCH_BCD_SET][7];
+    static DS3231_Time times[DS3231_BENCH_BCD_SET];
+    static DS3231_Time decoded[DS3231_BENCH_BCD_SET];
+    static uint8_t encoded[DS3231_BENCH_BCD_SET][7];
+
+    if (!result) return;
+    memset(result, 0, sizeof(*result));
+
+    bench_ts_rng = 4242U;
+    for (uint32_t i = 0; i < DS3231_BENCH_BCD_SET; i++) {
+        for (uint32_t k = 0; k < 7; k++) regs[i][k] = (uint8_t)bench_ts_rand(256U);
+        times[i] = (DS3231_Time){ .seconds = (uint8_t)bench_ts_rand(60U), .minutes = (uint8_t)bench_ts_rand(60U),
+                                  .hours = (uint8_t)bench_ts_rand(24U), .day = (uint8_t)(1U + bench_ts_rand(7U)),
+                                  .date = (uint8_t)(1U + bench_ts_rand(31U)), .month = (uint8_t)(1U + bench_ts_rand(12U)),
+                                  .year = (uint16_t)(DS3231_YEAR_MIN + bench_ts_rand(200U)) };
+    }
+
+    for (uint32_t i = 0; i < DS3231_BENCH_BCD_SET; i++) {
+        DS3231_Time ref_t, t;
+        uint8_t ref_b[7], b[7];
+
+        DS3231_bcd_decode_time_scalar(regs[i], &ref_t);
+        DS3231_bcd_encode_time_scalar(&times[i], ref_b);
+        for (uint32_t v = 1; v < DS3231_BENCH_BCD_IMPLS; v++) {
+            bench_bcd_decoders[v](regs[i], &t);
+            bench_bcd_encoders[v](&times[i], b);
+            if (memcmp(&t, &ref_t, sizeof(t)) != 0 || memcmp(b, ref_b, sizeof(b)) != 0) result->mismatches++;
+        }
+    }
+
+    if (clock) {
+        const uint32_t reps = 256;
+
+        BENCH_BCD_TIME(clock, reps, DS3231_bcd_decode_time_scalar(regs[i], &decoded[i]), result->decode_ps[DS3231_BCD_SCALAR]);
+        BENCH_BCD_TIME(clock, reps, DS3231_bcd_decode_time_swar(regs[i], &decoded[i]),   result->decode_ps[DS3231_BCD_SWAR]);
+        BENCH_BCD_TIME(clock, reps, DS3231_bcd_decode_time_table(regs[i], &decoded[i]),  result->decode_ps[DS3231_BCD_TABLE]);
+        BENCH_BCD_TIME(clock, reps, DS3231_bcd_encode_time_scalar(&times[i], encoded[i]), result->encode_ps[DS3231_BCD_SCALAR]);
+        BENCH_BCD_TIME(clock, reps, DS3231_bcd_encode_time_swar(&times[i], encoded[i]),   result->encode_ps[DS3231_BCD_SWAR]);
+        BENCH_BCD_TIME(clock, reps, DS3231_bcd_encode_time_table(&times[i], encoded[i]),  result->encode_ps[DS3231_BCD_TABLE]);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Temperatura: punto fijo y float                                           */
+/* -------------------------------------------------------------------------- */
+
+void DS3231_Bench_Temperature(DS3231_BenchClock clock, DS3231_BenchTemp *result)
+{
+    static uint8_t regs[DS3231_BENCH_BCD_SET][2];
+    static int16_t q4[DS3231_BENCH_BCD_SET];
+#ifndef DS3231_NO_FLOAT
+    static float celsius[DS3231_BENCH_BCD_SET];
+#endif
+
+    if (!result) return;
+    memset(result, 0, sizeof(*result));
+
+    // Las 1024 lecturas posibles: MSB completo y los dos bits altos del LSB.
+    for (uint32_t i = 0; i < DS3231_BENCH_BCD_SET; i++) {
+        regs[i][0] = (uint8_t)(i >> 2);
+        regs[i][1] = (uint8_t)((i & 0x03U) << 6);
+
+        // Referencia: complemento a 2 de 10 bits alineado a la izquierda.
+        int16_t ref = (int16_t)((uint16_t)(regs[i][0] << 8) | regs[i][1]) / 64;
+        if (DS3231_temp_q4(regs[i][0], regs[i][1]) != ref) result->mismatches++;
+#ifndef DS3231_NO_FLOAT
+        // La versión float anterior del driver.
+        if (DS3231_temp_q4(regs[i][0], regs[i][1]) * 0.25f != (int8_t)regs[i][0] + ((regs[i][1] >> 6) * 0.25f))
+            result->mismatches++;
+#endif
+    }
+
+    if (clock) {
+        const uint32_t reps = 256;
+
+        // Sin lectores, el compilador eliminaría las escrituras a q4/celsius.
+        __asm__ volatile("" :: "r"(q4) : "memory");
+#ifndef DS3231_NO_FLOAT
+        __asm__ volatile("" :: "r"(celsius) : "memory");
+#endif
+        BENCH_BCD_TIME(clock, reps, q4[i] = DS3231_temp_q4(regs[i][0], regs[i][1]), result->q4_ps);
+#ifndef DS3231_NO_FLOAT
+        BENCH_BCD_TIME(clock, reps, celsius[i] = (int8_t)regs[i][0] + ((regs[i][1] >> 6) * 0.25f), result->float_ps);
+#endif
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Ejecutable de host                                                        */
+/* -------------------------------------------------------------------------- */
+
+#ifdef DS3231_BENCH_MAIN
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+
+#define BENCH_MAX_CASES  (64)
+
+/* -------------------------------------------------------------------------- */
+/*  Seqlock de ds3231_clock con hilos                                         */
+/* -------------------------------------------------------------------------- */
+
+#define BENCH_SEQ_EDGES     (200000U)   // Flancos del escritor.
+#define BENCH_SEQ_READERS   (3U)
+#define BENCH_SEQ_PERIOD    (84000000U) // Ciclos por flanco, exactos: el filtro no corrige nada.
+#define BENCH_SEQ_YIELD     (4096U)     // Cada cuántos flancos el escritor cede el CPU a mitad de escritura.
+
+static DS3231_Clock bench_seq_clock;
+static uint32_t     bench_seq_cycles;   // Contador de ciclos que ve la ISR simulada.
+static uint32_t     bench_seq_edges0;   // edges al arrancar el escritor.
+static int64_t      bench_seq_epoch0;   // Hora del chip menos edges, constante mientras avanza.
+static volatile bool bench_seq_done;
+
+/* Fuente de ciclos: corre dentro de OnEdge, entre la hora y edges, con la secuencia impar. */
+static uint32_t bench_seq_cycle_source(void)
+{
+    uint32_t now = __atomic_load_n(&bench_seq_cycles, __ATOMIC_RELAXED);
+
+    if ((now / BENCH_SEQ_PERIOD) % BENCH_SEQ_YIELD == 0) sched_yield();
+    return now;
+}
+
+/* Hace de ISR de la SQW: cada flanco avanza el contador un período exacto. */
+static void *bench_seq_writer(void *arg)
+{
+    for (uint32_t i = 1; i <= BENCH_SEQ_EDGES; i++) {
+        __atomic_store_n(&bench_seq_cycles, i * BENCH_SEQ_PERIOD, __ATOMIC_RELAXED);
+        DS3231_Clock_OnEdge(&bench_seq_clock);
+    }
+    bench_seq_done = true;
+    return NULL;
+}
+
+/*
+ * Cada snapshot debe salir de un mismo flanco: hora = epoch0 + edges, fase del
+ * último flanco = (edges - edges0) períodos, y edges nunca retrocede.
+ */
+static void *bench_seq_reader(void *arg)
+{
+    DS3231_BenchCheck *result = (DS3231_BenchCheck *)arg;
+    uint32_t last = bench_seq_edges0;
+
+    while (!bench_seq_done) {
+        DS3231_ClockSnapshot snap;
+        int64_t epoch;
+        uint32_t n;
+
+        result->checked++;
+        if (DS3231_Clock_Snapshot(&bench_seq_clock, &snap) != DS3231_OK ||
+            DS3231_TimeToEpoch(&snap.time, &epoch) != DS3231_OK) {
+            result->mismatches++;
+            continue;
+        }
+        n = snap.edges - bench_seq_edges0;
+        if (epoch != bench_seq_epoch0 + snap.edges || (int32_t)(snap.edges - last) < 0 ||
+            (n > 0 && (!snap.phase || snap.edge_cycles != n * BENCH_SEQ_PERIOD))) {
+            result->mismatches++;
+        }
+        last = snap.edges;
+    }
+    return NULL;
+}
+
+/*
+ * Un hilo escritor (DS3231_Clock_OnEdge) y BENCH_SEQ_READERS lectores
+ * (DS3231_Clock_Snapshot) sobre el mismo reloj. El escritor cede el CPU a mitad
+ * de algunas escrituras para que los lectores las encuentren en curso.
+ */
+static void bench_seqlock(DS3231_Sim *sim, DS3231_BenchCheck *result)
+{
+    static DS3231_BenchCheck per_reader[BENCH_SEQ_READERS];
+    pthread_t writer, readers[BENCH_SEQ_READERS];
+    DS3231_ClockSnapshot snap;
+
+    memset(result, 0, sizeof(*result));
+    memset(per_reader, 0, sizeof(per_reader));
+
+    DS3231_port_set_transport(&DS3231_Transport_Sim, sim);
+    DS3231_Sim_Init(sim);
+    (void)DS3231_Init();
+    if (DS3231_Clock_Start(&bench_seq_clock, DS3231_DefaultHandle(), 0) != DS3231_OK ||
+        DS3231_Clock_SetCycleSource(&bench_seq_clock, bench_seq_cycle_source, BENCH_SEQ_PERIOD) != DS3231_OK ||
+        DS3231_Clock_Snapshot(&bench_seq_clock, &snap) != DS3231_OK ||
+        DS3231_TimeToEpoch(&snap.time, &bench_seq_epoch0) != DS3231_OK) {
+        result->checked = result->mismatches = 1;
+        return;
+    }
+    bench_seq_edges0  = snap.edges;
+    bench_seq_epoch0 -= snap.edges;
+    bench_seq_cycles  = 0;
+    bench_seq_done    = false;
+
+    for (uint32_t i = 0; i < BENCH_SEQ_READERS; i++) {
+        pthread_create(&readers[i], NULL, bench_seq_reader, &per_reader[i]);
+    }
+    pthread_create(&writer, NULL, bench_seq_writer, NULL);
+    pthread_join(writer, NULL);
+    for (uint32_t i = 0; i < BENCH_SEQ_READERS; i++) {
+        pthread_join(readers[i], NULL);
+        result->checked    += per_reader[i].checked;
+        result->mismatches += per_reader[i].mismatches;
+    }
+
+    // Al final, el estado publicado es el del último flanco.
+    result->checked++;
+    if (DS3231_Clock_Snapshot(&bench_seq_clock, &snap) != DS3231_OK ||
+        snap.edges - bench_seq_edges0 != BENCH_SEQ_EDGES) {
+        result->mismatches++;
+    }
+}
+
+static uint64_t host_clock_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void write_csv(FILE *f, const DS3231_BenchResult *r, uint16_t n)
+{
+    fprintf(f, "name,transactions,starts,stops,bytes,bus_ns_400k,cpu_ns\n");
+    for (uint16_t i = 0; i < n; i++) {
+        fprintf(f, "%s,%u,%u,%u,%u,%u,%u\n", r[i].name, r[i].transactions, r[i].starts,
+                r[i].stops, r[i].bytes, r[i].bus_ns_400k, r[i].cpu_ns);
+    }
+}
+
+static uint16_t read_csv(const char *path, DS3231_BenchResult *r, uint16_t max)
+{
+    char line[160];
+    uint16_t n = 0;
+    FILE *f = fopen(path, "r");
+
+    if (!f) return 0;
+    while (n < max && fgets(line, sizeof(line), f)) {
+        DS3231_BenchResult *e = &r[n];
+        memset(e, 0, sizeof(*e));
+        if (sscanf(line, "%31[^,],%u,%u,%u,%u,%u,%u", e->name, &e->transactions, &e->starts,
+                   &e->stops, &e->bytes, &e->bus_ns_400k, &e->cpu_ns) == 7) {
+            n++;
+        }
+    }
+    fclose(f);
+    return n;
+}
+
+static void report_regression(const DS3231_BenchResult *cur, const DS3231_BenchResult *base)
+{
+    fprintf(stderr, "REGRESION %-24s tx %u -> %u, bytes %u -> %u\n", cur->name,
+            base->transactions, cur->transactions, base->bytes, cur->bytes);
+}
+
+int main(int argc, char **argv)
+{
+    static DS3231_Sim sim;
+    static DS3231_BenchResult results[BENCH_MAX_CASES];
+    static DS3231_BenchResult baseline[BENCH_MAX_CASES];
+    const char *out_path = NULL, *base_path = NULL;
+    uint32_t epoch_stride = DS3231_BENCH_EPOCH_STRIDE;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-e") == 0) epoch_stride = 1;
+        else if (i + 1 < argc && strcmp(argv[i], "-o") == 0) out_path = argv[++i];
+        else if (i + 1 < argc && strcmp(argv[i], "-b") == 0) base_path = argv[++i];
+    }
+
+    uint16_t n = DS3231_Bench_Run(&sim, host_clock_ns, results, BENCH_MAX_CASES);
+
+    printf("%-24s %4s %4s %4s %5s %10s %8s\n", "call", "tx", "S", "P", "bytes", "bus_us@400k", "cpu_ns");
+    for (uint16_t i = 0; i < n; i++) {
+        printf("%-24s %4u %4u %4u %5u %10.1f %8u\n", results[i].name, results[i].transactions,
+               results[i].starts, results[i].stops, results[i].bytes,
+               results[i].bus_ns_400k / 1000.0, results[i].cpu_ns);
+    }
+
+    static const struct { uint32_t jitter_ns; int32_t cpu_ppm; } ts_cases[] = {
+        { 0, 0 }, { 0, 10000 }, { 1000, 0 }, { 1000, 10000 }, { 10000, -10000 },
+    };
+
+    printf("\n%-24s %8s %10s %10s %10s %8s\n", "timestamp jitter/ppm", "samples", "mean_ns", "rms_ns", "max_ns", "outliers");
+    for (uint16_t i = 0; i < sizeof(ts_cases) / sizeof(ts_cases[0]); i++) {
+        DS3231_BenchTsError e;
+        char name[DS3231_BENCH_NAME_LEN];
+
+        DS3231_Bench_Timestamp(&sim, 3600, ts_cases[i].jitter_ns, ts_cases[i].cpu_ppm, &e);
+        snprintf(name, sizeof(name), "%uns/%+dppm", ts_cases[i].jitter_ns, ts_cases[i].cpu_ppm);
+        printf("%-24s %8u %10d %10u %10u %8u\n", name, e.samples, e.mean_ns, e.rms_ns, e.max_abs_ns, e.outliers);
+    }
+
+    DS3231_BenchEpoch ep;
+    DS3231_Bench_Epoch(epoch_stride, host_clock_ns, &ep);
+    printf("\nepoch 2000..2199 (paso %us): %llu verificados, %llu errores, EpochToTime %.2f ns, TimeToEpoch %.2f ns\n",
+           epoch_stride, (unsigned long long)ep.checked, (unsigned long long)ep.mismatches,
+           ep.to_time_ps / 1000.0, ep.to_epoch_ps / 1000.0);
+    if (ep.mismatches) return 1;
+
+    DS3231_BenchCheck chk;
+    DS3231_Bench_Century(&sim, &chk);
+    printf("\nsiglo 2000..2199: %u lecturas verificadas, %u errores\n", chk.checked, chk.mismatches);
+    if (chk.mismatches) return 1;
+
+    DS3231_Bench_HourMode(&sim, &chk);
+    printf("formato 12/24 h: %u lecturas verificadas, %u errores\n", chk.checked, chk.mismatches);
+    if (chk.mismatches) return 1;
+
+    DS3231_Bench_Cache(&sim, &chk);
+    printf("cache de CONTROL/STATUS/AGING: %u verificaciones, %u errores\n", chk.checked, chk.mismatches);
+    if (chk.mismatches) return 1;
+
+    DS3231_Bench_Async(&sim, &chk);
+    printf("lecturas asincronas: %u verificaciones, %u errores\n", chk.checked, chk.mismatches);
+    if (chk.mismatches) return 1;
+
+    DS3231_Bench_SnapshotDMA(&sim, &chk);
+    printf("snapshot por DMA (doble buffer): %u verificaciones, %u errores\n", chk.checked, chk.mismatches);
+    if (chk.mismatches) return 1;
+
+    bench_seqlock(&sim, &chk);
+    printf("seqlock del reloj (1 escritor, %u lectores): %u lecturas, %u inconsistentes\n",
+           BENCH_SEQ_READERS, chk.checked, chk.mismatches);
+    if (chk.mismatches) return 1;
+
+    DS3231_Bench_PowerLoss(&sim, &chk);
+    printf("supervision de OSF: %u verificaciones, %u errores\n", chk.checked, chk.mismatches);
+    if (chk.mismatches) return 1;
+
+    DS3231_BenchAligned al;
+    DS3231_Bench_Aligned(&sim, &al);
+    printf("escritura alineada: fase %+.1f us (informada %+.1f us), SetTime %+.1f ms; "
+           "%u verificaciones, %u errores\n", al.measured_ns / 1000.0, al.phase_ns / 1000.0,
+           al.naive_ns / 1000000.0, al.check.checked, al.check.mismatches);
+    if (al.check.mismatches) return 1;
+
+    DS3231_BenchAdjust adj;
+    DS3231_Bench_Adjust(&sim, &adj);
+    printf("ajuste por diferencia: %u ajustes, %u bytes (lectura + SetTime: %u); %u verificaciones, %u errores\n",
+           adj.adjusts, adj.bytes, adj.full_bytes, adj.check.checked, adj.check.mismatches);
+    if (adj.check.mismatches) return 1;
+
+    static const struct { int32_t offset_us; uint8_t lsb; } slew_runs[] = { { 5000, 0 }, { -250000, 127 } };
+    for (uint32_t i = 0; i < sizeof(slew_runs) / sizeof(slew_runs[0]); i++) {
+        DS3231_BenchSlew sl;
+        DS3231_Bench_Slew(&sim, slew_runs[i].offset_us, slew_runs[i].lsb, &sl);
+        printf("slew %+.3f ms: logrado %+.4f ms en %u s (AGING %d -> %d), %u tx; %u errores\n",
+               slew_runs[i].offset_us / 1000.0, sl.achieved_ns / 1000000.0, sl.duration_s, sl.base_aging,
+               sl.slew_aging, sl.transactions, sl.check.mismatches);
+        if (sl.check.mismatches) return 1;
+    }
+
+    DS3231_BenchConv conv;
+    DS3231_Bench_Conversion(&sim, &conv);
+    printf("conversion forzada: %u ms, %u tx, %u bytes; %u verificaciones, %u errores\n", conv.latency_ms,
+           conv.transactions, conv.bytes, conv.check.checked, conv.check.mismatches);
+    if (conv.check.mismatches) return 1;
+
+    static const struct { DS3231_CalSource source; int32_t ppb; int16_t aging_ppb; const char *name; } cal_runs[] = {
+        { DS3231_CAL_SRC_SQW,    7300, 80,  "sqw"   },
+        { DS3231_CAL_SRC_32KHZ, -4100, 100, "32khz" },
+    };
+    for (uint32_t i = 0; i < sizeof(cal_runs) / sizeof(cal_runs[0]); i++) {
+        DS3231_BenchCal cal;
+        DS3231_Bench_Calibration(&sim, cal_runs[i].source, cal_runs[i].ppb, cal_runs[i].aging_ppb, &cal);
+        printf("calibracion %-5s: %+d -> %+d ppb (medido %+d), aging %d, %u pasos, %u s, sens %u ppb/LSB, %u tx; %u errores\n",
+               cal_runs[i].name, cal.ppb_initial, cal.ppb_residual, cal.ppb_measured, cal.aging, cal.steps,
+               cal.duration_s, cal.sens_ppb, cal.transactions, cal.check.mismatches);
+        if (cal.check.mismatches) return 1;
+    }
+
+    DS3231_BenchDrift drift;
+    DS3231_Bench_Drift(&sim, &drift);
+    printf("deriva: %u ventanas, %u celdas; 24 h sin referencia: tabla %d ppb rms (max %d), hora %+.1f ms, "
+           "%u escrituras de AGING, %u tx; AGING fijo %d ppb rms (max %d), hora %+.1f ms; %u errores\n",
+           drift.learned, drift.bins, drift.rms_ppb, drift.max_ppb, drift.time_us / 1000.0, drift.updates,
+           drift.transactions, drift.fixed_rms_ppb, drift.fixed_max_ppb, drift.fixed_time_us / 1000.0,
+           drift.check.mismatches);
+    if (drift.check.mismatches) return 1;
+
+    DS3231_BenchTemp temp;
+    DS3231_Bench_Temperature(host_clock_ns, &temp);
+    printf("\ntemperatura: q4 %.2f ns", temp.q4_ps / 1000.0);
+#ifndef DS3231_NO_FLOAT
+    printf(", float %.2f ns", temp.float_ps / 1000.0);
+#else
+    printf(" (DS3231_NO_FLOAT)");
+#endif
+    printf("; %u errores\n", temp.mismatches);
+    if (temp.mismatches) return 1;
+
+    static const char *const bcd_names[DS3231_BENCH_BCD_IMPLS] = { "escalar", "swar", "tabla" };
+    DS3231_BenchBcd bcd;
+    DS3231_Bench_Bcd(host_clock_ns, &bcd);
+    printf("\n%-24s %10s %10s\n", "bcd (bloque de tiempo)", "decode_ns", "encode_ns");
+    for (uint32_t i = 0; i < DS3231_BENCH_BCD_IMPLS; i++) {
+        printf("%-24s %10.2f %10.2f%s\n", bcd_names[i], bcd.decode_ps[i] / 1000.0, bcd.encode_ps[i] / 1000.0,
+               i == DS3231_BCD_IMPL ? "  (driver)" : "");
+    }
+    if (bcd.mismatches) { fprintf(stderr, "bcd: %u bloques difieren de la variante escalar\n", bcd.mismatches); return 1; }
+
+    if (out_path) {
+        FILE *f = fopen(out_path, "w");
+        if (!f) { perror(out_path); return 2; }
+        write_csv(f, results, n);
+        fclose(f);
+    }
+
+    if (base_path) {
+        uint16_t n_base = read_csv(base_path, baseline, BENCH_MAX_CASES);
+        if (n_base == 0) { fprintf(stderr, "%s: linea base vacia o inexistente\n", base_path); return 2; }
+        if (DS3231_Bench_Compare(results, n, baseline, n_base, report_regression) != 0) return 1;
+    }
+    return 0;
+}
+#endif /* DS3231_BENCH_MAIN */
@@ -0,0 +1,271 @@
+/**
+ * @file    ds3231_cal.c
+ * @brief   Calibración automática del registro AGING del DS3231.
+ */
+
+#include "ds3231_cal.h"
+#include "ds3231_registers.h"
+#include "dev_prof.h"
+#include <stddef.h>
+#include <string.h>
+
+#define CAL_PPB_PER_UNIT    (1000000000LL)
+
+/* -------------------------------------------------------------------------- */
+/*  Helpers                                                                   */
+/* -------------------------------------------------------------------------- */
+
+static uint32_t cal_record_check(const DS3231_CalRecord *rec)
+{
+    const uint8_t *p = (const uint8_t *)rec;
+    uint32_t h = 2166136261UL;
+
+    for (size_t i = 0; i < offsetof(DS3231_CalRecord, check); i++) {
+        h ^= p[i];
+        h *= 16777619UL;
+    }
+    return h;
+}
+
+static void cal_set_state(DS3231_Cal *cal, DS3231_CalState state)
+{
+    __atomic_store_n(&cal->state, state, __ATOMIC_RELEASE);
+}
+
+static void cal_finish(DS3231_Cal *cal)
+{
+    DS3231_CalRecord *rec = &cal->record;
+
+    memset(rec, 0, sizeof(*rec));
+    rec->magic      = DS3231_CAL_RECORD_MAGIC;
+    rec->ppb        = cal->ppb;
+    rec->duration_s = cal->events;
+    rec->steps      = cal->steps;
+    rec->sens_ppb   = (uint16_t)cal->sens_ppb;
+    rec->aging      = cal->aging;
+    rec->check      = cal_record_check(rec);
+
+    cal_set_state(cal, DS3231_CAL_CONVERGED);
+    if (cal->store) cal->store(rec, cal->store_ctx);
+}
+
+/* Fin de la conversión que aplica el nuevo AGING: empieza otra ventana. */
+static void cal_conv_done(DS3231_Status status, DS3231_Temp temp, void *ctx)
+{
+    DS3231_Cal *cal = (DS3231_Cal *)ctx;
+
+    if (status != DS3231_OK) return;    // Se reintenta en el próximo Poll.
+
+    DS3231_CalMeter_Reset(&cal->meter, cal->meter.ref_hz);
+    cal_set_state(cal, DS3231_CAL_MEASURING);
+}
+
+/* Fin de una conversión de DS3231_CalApply: la libera y avisa a su dueño. */
+static void cal_apply_done(DS3231_Status status, DS3231_Temp temp, void *ctx)
+{
+    DS3231_CalApply *apply = (DS3231_CalApply *)ctx;
+
+    apply->converting = false;
+    if (apply->done) apply->done(status, temp, apply->ctx);
+}
+
+/* -------------------------------------------------------------------------- */
+/*  API pública                                                               */
+/* -------------------------------------------------------------------------- */
+
+void DS3231_CalMeter_Reset(DS3231_CalMeter *meter, uint32_t ref_hz)
+{
+    if (!meter) return;
+
+    meter->ref_hz  = ref_hz;
+    meter->samples = 0;
+    meter->offset  = 0;
+    meter->sum_t   = 0;
+    meter->sum_kt  = 0;
+    __atomic_store_n(&meter->ready, false, __ATOMIC_RELEASE);
+}
+
+bool DS3231_CalMeter_OnEvent(DS3231_CalMeter *meter, uint32_t ref_ticks)
+{
+    if (!meter || meter->ready) return false;
+
+    if (meter->samples > 0) {
+        int32_t  err = (int32_t)(ref_ticks - meter->last_ticks - meter->ref_hz);
+        uint32_t mag = (uint32_t)(err < 0 ? -err : err);
+
+        if (mag > (meter->ref_hz >> DS3231_CAL_TOL_SHIFT)) {
+            // Evento perdido o espurio: la ventana arranca de nuevo en este evento.
+            meter->outliers++;
+            DS3231_CalMeter_Reset(meter, meter->ref_hz);
+        } else {
+            meter->offset += err;
+            meter->sum_t  += meter->offset;
+            meter->sum_kt += (int64_t)meter->samples * meter->offset;
+        }
+    }
+    meter->last_ticks = ref_ticks;
+
+    if (++meter->samples < DS3231_CAL_WINDOW) return false;
+    __atomic_store_n(&meter->ready, true, __ATOMIC_RELEASE);
+    return true;
+}
+
+void DS3231_CalApply_Init(DS3231_CalApply *apply, DS3231_TempCallback done, void *ctx)
+{
+    if (!apply) return;
+
+    memset(apply, 0, sizeof(*apply));
+    apply->done = done;
+    apply->ctx  = ctx;
+}
+
+DS3231_Status DS3231_CalApply_Poll(DS3231_CalApply *apply, DS3231_Handle *dev, uint32_t now_ms)
+{
+    if (!apply || !dev) return DS3231_INVALID_PARAM;
+
+    if (!apply->converting) {
+        DS3231_Status st = DS3231_Dev_ConvertTemperatureAsync(dev, cal_apply_done, apply, now_ms);
+
+        // BUSY: una conversión automática en curso, que al terminar ya aplica el
+        // AGING escrito. Se reintenta en el próximo Poll.
+        if (st == DS3231_BUSY) {
+            apply->deferred = true;
+            return DS3231_OK;
+        }
+        if (st != DS3231_OK) return st;
+
+        // Si hubo que esperar, el AGING se aplicó recién (al terminar la automática):
+        // se cuenta como si la forzada hubiera empezado una conversión antes.
+        apply->converting = true;
+        apply->conv_ms    = apply->deferred ? now_ms - DS3231_CONV_TIME_MS : now_ms;
+        apply->deferred   = false;
+        return DS3231_OK;
+    }
+
+    DS3231_Status st = DS3231_Dev_ConvertTemperaturePoll(dev, now_ms);
+    return (st == DS3231_BUSY) ? DS3231_OK : st;
+}
+
+/*
+ * Recta de mínimos cuadrados t'(k) = a + b*k con k = 0..n-1 equiespaciados:
+ * b = sum((k - kmed) * t'(k)) / sum((k - kmed)^2), ambos multiplicados por 2
+ * para trabajar en enteros. b es lo que el período del RTC excede a ref_hz,
+ * en ticks; el RTC adelanta (ppb > 0) cuando su segundo es más corto.
+ */
+int32_t DS3231_CalMeter_Ppb(const DS3231_CalMeter *meter)
+{
+    int64_t n = meter ? meter->samples : 0;
+    if (n < 2) return 0;
+
+    int64_t num2 = 2 * meter->sum_kt - (n - 1) * meter->sum_t;
+    int64_t den2 = n * (n * n - 1) / 6;
+
+    return (int32_t)DS3231_Cal_DivRound(-num2 * CAL_PPB_PER_UNIT, den2 * (int64_t)meter->ref_hz);
+}
+
+DS3231_Status DS3231_Cal_Start(DS3231_Cal *cal, DS3231_Handle *dev, DS3231_CalSource source, uint32_t ref_hz)
+{
+    if (!cal || !dev || ref_hz < (1UL << DS3231_CAL_TOL_SHIFT) || source > DS3231_CAL_SRC_32KHZ)
+        return DS3231_INVALID_PARAM;
+
+    memset(cal, 0, sizeof(*cal));
+    cal->dev      = dev;
+    cal->source   = source;
+    cal->sens_ppb = DS3231_CAL_SENS_PPB;
+    DS3231_CalApply_Init(&cal->apply, cal_conv_done, cal);
+
+    DS3231_Status st = (source == DS3231_CAL_SRC_SQW) ? DS3231_Dev_SetSQWFreq(dev, DS3231_SQW_1HZ)
+                                                      : DS3231_Dev_Enable32KHz(dev, true);
+    if (st != DS3231_OK) return st;
+
+    // Se parte del AGING vigente, que el chip ya aplicó en conversiones anteriores.
+    st = DS3231_Dev_GetAging(dev, &cal->aging);
+    if (st != DS3231_OK) return st;
+    cal->prev_aging = cal->aging;
+
+    DS3231_CalMeter_Reset(&cal->meter, ref_hz);
+    cal_set_state(cal, DS3231_CAL_MEASURING);
+    return DS3231_OK;
+}
+
+void DS3231_Cal_SetStore(DS3231_Cal *cal, DS3231_CalStore store, void *ctx)
+{
+    if (!cal) return;
+
+    cal->store     = store;
+    cal->store_ctx = ctx;
+}
+
+void DS3231_Cal_OnEvent(DS3231_Cal *cal, uint32_t ref_ticks)
+{
+    if (!cal) return;
+
+    DS3231_CalState state = __atomic_load_n(&cal->state, __ATOMIC_ACQUIRE);
+    if (state != DS3231_CAL_MEASURING && state != DS3231_CAL_APPLYING) return;
+
+    cal->events++;
+    if (state == DS3231_CAL_MEASURING) (void)DS3231_CalMeter_OnEvent(&cal->meter, ref_ticks);
+}
+
+DS3231_Status DS3231_Cal_Poll(DS3231_Cal *cal, uint32_t now_ms)
+{
+    if (!cal || !cal->dev) return DS3231_INVALID_PARAM;
+
+    switch (cal->state) {
+        case DS3231_CAL_APPLYING:   return DS3231_CalApply_Poll(&cal->apply, cal->dev, now_ms);
+        case DS3231_CAL_CONVERGED:  return DS3231_OK;
+        case DS3231_CAL_FAILED:     return DS3231_ERROR;
+        case DS3231_CAL_MEASURING:  break;
+        default:                    return DS3231_NOT_READY;
+    }
+    if (!__atomic_load_n(&cal->meter.ready, __ATOMIC_ACQUIRE)) return DS3231_OK;
+
+    PROF_SCOPE(PROF_ID_DS3231_CAL_STEP, 0, NULL);
+
+    int32_t ppb = DS3231_CalMeter_Ppb(&cal->meter);
+
+    // La sensibilidad real de AGING sale del cambio de error entre dos pasos.
+    cal->steps++;
+    if (cal->steps > 1 && cal->aging != cal->prev_aging) {
+        int32_t sens = (int32_t)DS3231_Cal_DivRound(cal->prev_ppb - ppb, cal->aging - cal->prev_aging);
+        if (sens >= DS3231_CAL_SENS_MIN_PPB && sens <= DS3231_CAL_SENS_MAX_PPB) cal->sens_ppb = sens;
+    }
+    cal->prev_ppb   = ppb;
+    cal->prev_aging = cal->aging;
+    cal->ppb        = ppb;
+
+    if (2 * (ppb < 0 ? -ppb : ppb) <= cal->sens_ppb) {
+        cal_finish(cal);
+        return DS3231_OK;
+    }
+
+    // AGING positivo atrasa el oscilador: un RTC que adelanta necesita más AGING.
+    int32_t next = cal->aging + (int32_t)DS3231_Cal_DivRound(ppb, cal->sens_ppb);
+    if (next > INT8_MAX) next = INT8_MAX;
+    if (next < INT8_MIN) next = INT8_MIN;
+
+    if (cal->steps >= DS3231_CAL_MAX_STEPS || next == cal->aging) {
+        cal_set_state(cal, DS3231_CAL_FAILED);
+        return DS3231_ERROR;
+    }
+
+    cal_set_state(cal, DS3231_CAL_APPLYING);
+    DS3231_Status st = DS3231_Dev_SetAging(cal->dev, (int8_t)next);
+    if (st != DS3231_OK) {
+        // El registro quedó como estaba: se mide otra ventana con el AGING anterior.
+        DS3231_CalMeter_Reset(&cal->meter, cal->meter.ref_hz);
+        cal_set_state(cal, DS3231_CAL_MEASURING);
+        return st;
+    }
+    cal->aging = (int8_t)next;
+
+    return DS3231_CalApply_Poll(&cal->apply, cal->dev, now_ms);
+}
+
+DS3231_Status DS3231_Cal_Restore(DS3231_Handle *dev, const DS3231_CalRecord *rec)
+{
+    if (!dev || !rec) return DS3231_INVALID_PARAM;
+    if (rec->magic != DS3231_CAL_RECORD_MAGIC || rec->check != cal_record_check(rec)) return DS3231_INVALID_PARAM;
+
+    return DS3231_Dev_SetAging(dev, rec->aging);
+}
@@ -0,0 +1,316 @@
+/**
+ * @file    ds3231_clock.c
+ * @brief   Reloj por software sincronizado con la SQW de 1 Hz del DS3231.
+ */
+
+#include "ds3231_clock.h"
+#include "ds3231_registers.h"
+#include "dev_prof.h"
+#include <string.h>
+
+#ifndef I2CM_HOST_SIM
+#include "stm32f4xx_hal.h"
+#endif
+
+/* Escrituras desde el lazo principal: la ISR no puede interrumpir una escritura a medias. */
+#ifndef I2CM_HOST_SIM
+#define CLOCK_CRITICAL_ENTER()  uint32_t clock_primask = __get_PRIMASK(); __disable_irq()
+#define CLOCK_CRITICAL_EXIT()   __set_PRIMASK(clock_primask)
+#else
+#define CLOCK_CRITICAL_ENTER()  do { } while (0)
+#define CLOCK_CRITICAL_EXIT()   do { } while (0)
+#endif
+
+#define CLOCK_NS_PER_S      (1000000000ULL)
+
+/* -------------------------------------------------------------------------- */
+/*  Helpers                                                                   */
+/* -------------------------------------------------------------------------- */
+
+/* Igual que el chip: bisiesto cada 4 años, también 2100. */
+static uint8_t clock_days_in_month(uint8_t month, uint16_t year)
+{
+    static const uint8_t days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+    if (month < 1 || month > 12) return 31;
+    if (month == 2 && (year % 4) == 0) return 29;
+    return days[month - 1];
+}
+
+static void clock_tick(DS3231_Time *t)
+{
+    if (++t->seconds < 60) return;
+    t->seconds = 0;
+    if (++t->minutes < 60) return;
+    t->minutes = 0;
+    if (++t->hours < 24) return;
+    t->hours = 0;
+
+    t->day = (uint8_t)((t->day % 7) + 1);
+    if (++t->date <= clock_days_in_month(t->month, t->year)) return;
+    t->date = 1;
+    if (++t->month <= 12) return;
+    t->month = 1;
+    // El chip invierte el siglo al pasar de 99 a 00: 2199 vuelve a 2000.
+    if (++t->year > DS3231_YEAR_MAX) t->year = DS3231_YEAR_MIN;
+}
+
+/* Seqlock: secuencia impar mientras se escribe snap. */
+static void clock_write_begin(DS3231_Clock *clk)
+{
+    __atomic_store_n(&clk->seq, clk->seq + 1U, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static void clock_write_end(DS3231_Clock *clk)
+{
+    __atomic_store_n(&clk->seq, clk->seq + 1U, __ATOMIC_RELEASE);
+}
+
+/* Copia snap y, si now != NULL, lee el contador de ciclos dentro de la misma ventana. */
+static void clock_read(const DS3231_Clock *clk, DS3231_ClockSnapshot *snap, uint32_t *now)
+{
+    for (;;) {
+        uint32_t seq = __atomic_load_n(&clk->seq, __ATOMIC_ACQUIRE);
+
+        if (seq & 1U) continue;
+        *snap = clk->snap;
+        if (now) *now = (snap->phase && clk->cycles) ? clk->cycles() : 0;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&clk->seq, __ATOMIC_RELAXED) == seq) return;
+    }
+}
+
+static uint32_t clock_edges(const DS3231_Clock *clk)
+{
+    return __atomic_load_n(&clk->snap.edges, __ATOMIC_RELAXED);
+}
+
+static void clock_set_period(DS3231_Clock *clk, uint32_t period_q4)
+{
+    uint32_t period = (period_q4 + 8U) >> 4;
+
+    clk->period_q4 = period_q4;
+    clk->snap.ns_per_cycle_q32 = period ? (CLOCK_NS_PER_S << 32) / period : 0;
+}
+
+/*
+ * Filtro alfa-beta sobre la captura del contador en cada flanco: corrige la
+ * fase predicha (último flanco + período) y el período con ganancias fijas.
+ * El primer intervalo medido reemplaza al período nominal (el HSI puede
+ * errar un 1 %, lo que el filtro tardaría un minuto en absorber). Un flanco
+ * fuera de tolerancia (perdido, glitch) reinicia la fase.
+ */
+static void clock_latch(DS3231_Clock *clk)
+{
+    uint32_t now    = clk->cycles();
+    uint32_t period = (clk->period_q4 + 8U) >> 4;
+
+    if (clk->lock) {
+        int32_t  err = (int32_t)(now - (clk->snap.edge_cycles + period));
+        uint32_t mag = (uint32_t)(err < 0 ? -err : err);
+
+        if (mag <= (period >> DS3231_CLOCK_TOL_SHIFT)) {
+            if (clk->lock == 1) {
+                clk->snap.edge_cycles = now;
+                clock_set_period(clk, (period + (uint32_t)err) << 4);
+                clk->lock = 2;
+                return;
+            }
+            clk->snap.edge_cycles += period + (uint32_t)(err / (1 << DS3231_CLOCK_PHASE_SHIFT));
+            clock_set_period(clk, clk->period_q4 + (uint32_t)((err * 16) / (1 << DS3231_CLOCK_FREQ_SHIFT)));
+            return;
+        }
+        clk->outliers++;
+    }
+    clk->snap.edge_cycles = now;
+    clk->snap.phase = true;
+    clk->lock = 1;
+}
+
+#ifndef I2CM_HOST_SIM
+static uint32_t clock_dwt_cycles(void)
+{
+    return DWT->CYCCNT;
+}
+#endif
+
+/*
+ * Lee la hora del chip sin flancos de por medio. Devuelve en *edge el valor de
+ * edges que corresponde a la hora leída.
+ */
+static DS3231_Status clock_read_chip(DS3231_Clock *clk, DS3231_Time *time, uint32_t *edge)
+{
+    for (uint32_t i = 0; i < DS3231_CLOCK_SYNC_RETRIES; i++) {
+        uint32_t e0 = clock_edges(clk);
+        DS3231_Status st = DS3231_Dev_ReadTime(clk->dev, time);
+
+        if (st != DS3231_OK) return st;
+        if (clock_edges(clk) == e0) {
+            *edge = e0;
+            return DS3231_OK;
+        }
+    }
+    return DS3231_BUSY;
+}
+
+/*
+ * Carga el calendario si no hubo flancos desde la lectura. Con mismatch != NULL
+ * compara antes de cargar. false: hubo un flanco, hay que volver a leer.
+ */
+static bool clock_store(DS3231_Clock *clk, const DS3231_Time *time, uint32_t edge, bool *mismatch)
+{
+    bool stored = false;
+
+    CLOCK_CRITICAL_ENTER();
+    if (clk->snap.edges == edge) {
+        if (mismatch) *mismatch = !clk->snap.valid || memcmp(&clk->snap.time, time, sizeof(*time)) != 0;
+        clock_write_begin(clk);
+        clk->snap.time  = *time;
+        clk->snap.valid = true;
+        clock_write_end(clk);
+        stored = true;
+    }
+    CLOCK_CRITICAL_EXIT();
+
+    if (stored) clk->next_check = edge + clk->check_period_s;
+    return stored;
+}
+
+/* -------------------------------------------------------------------------- */
+/*  API pública                                                               */
+/* -------------------------------------------------------------------------- */
+
+DS3231_Status DS3231_Clock_Start(DS3231_Clock *clk, DS3231_Handle *dev, uint32_t check_period_s)
+{
+    if (!clk || !dev) return DS3231_INVALID_PARAM;
+
+    // La ISR del flanco puede estar habilitada: no debe ver el reloj a medio borrar.
+    CLOCK_CRITICAL_ENTER();
+    memset(clk, 0, sizeof(*clk));
+    clk->dev = dev;
+    clk->check_period_s = check_period_s;
+    CLOCK_CRITICAL_EXIT();
+
+#ifndef I2CM_HOST_SIM
+    // El contador puede estar ya habilitado por dev_prof; habilitarlo de nuevo no lo reinicia.
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    (void)DS3231_Clock_SetCycleSource(clk, clock_dwt_cycles, SystemCoreClock);
+#endif
+
+    if (DS3231_Dev_SetSQWFreq(dev, DS3231_SQW_1HZ) != DS3231_OK)
+        return DS3231_ERROR;
+
+    return DS3231_Clock_Resync(clk);
+}
+
+DS3231_Status DS3231_Clock_Resync(DS3231_Clock *clk)
+{
+    PROF_SCOPE(PROF_ID_DS3231_CLOCK_RESYNC, 0, NULL);
+
+    if (!clk || !clk->dev) return DS3231_INVALID_PARAM;
+
+    for (uint32_t i = 0; i < DS3231_CLOCK_SYNC_RETRIES; i++) {
+        DS3231_Time time;
+        uint32_t edge;
+        DS3231_Status st = clock_read_chip(clk, &time, &edge);
+
+        if (st != DS3231_OK) return st;
+        if (clock_store(clk, &time, edge, NULL)) {
+            clk->resyncs++;
+            return DS3231_OK;
+        }
+    }
+    return DS3231_BUSY;
+}
+
+void DS3231_Clock_OnEdge(DS3231_Clock *clk)
+{
+    if (!clk) return;
+
+    clock_write_begin(clk);
+    if (clk->snap.valid) clock_tick(&clk->snap.time);
+    if (clk->cycles) clock_latch(clk);
+    clk->snap.edges++;
+    clock_write_end(clk);
+}
+
+DS3231_Status DS3231_Clock_Snapshot(const DS3231_Clock *clk, DS3231_ClockSnapshot *snap)
+{
+    if (!clk || !snap) return DS3231_INVALID_PARAM;
+
+    clock_read(clk, snap, NULL);
+    return snap->valid ? DS3231_OK : DS3231_NOT_READY;
+}
+
+DS3231_Status DS3231_Clock_Now(const DS3231_Clock *clk, DS3231_Time *time)
+{
+    DS3231_ClockSnapshot snap;
+
+    if (!clk || !time) return DS3231_INVALID_PARAM;
+
+    clock_read(clk, &snap, NULL);
+    *time = snap.time;
+    return snap.valid ? DS3231_OK : DS3231_NOT_READY;
+}
+
+DS3231_Status DS3231_Clock_SetCycleSource(DS3231_Clock *clk, DS3231_ClockCycles source, uint32_t nominal_hz)
+{
+    if (!clk || (source && (nominal_hz < 16U || nominal_hz > (UINT32_MAX >> 4)))) return DS3231_INVALID_PARAM;
+
+    CLOCK_CRITICAL_ENTER();
+    clock_write_begin(clk);
+    clk->cycles     = source;
+    clk->lock       = 0;
+    clk->snap.phase = false;
+    clock_set_period(clk, source ? nominal_hz << 4 : 0);
+    clock_write_end(clk);
+    CLOCK_CRITICAL_EXIT();
+    return DS3231_OK;
+}
+
+DS3231_Status DS3231_Clock_Timestamp(const DS3231_Clock *clk, DS3231_Timestamp *ts)
+{
+    DS3231_ClockSnapshot snap;
+    uint32_t now;
+
+    if (!clk || !ts) return DS3231_INVALID_PARAM;
+
+    clock_read(clk, &snap, &now);
+    ts->time = snap.time;
+    ts->ns   = 0;
+    if (!snap.valid || !snap.phase) return DS3231_NOT_READY;
+
+    // La fase filtrada puede quedar unos ciclos después de la captura real.
+    uint32_t elapsed = now - snap.edge_cycles;
+    if ((int32_t)elapsed > 0) {
+        uint64_t ns = ((uint64_t)elapsed * snap.ns_per_cycle_q32) >> 32;
+        ts->ns = (ns < CLOCK_NS_PER_S) ? (uint32_t)ns : (uint32_t)(CLOCK_NS_PER_S - 1U);
+    }
+    return DS3231_OK;
+}
+
+DS3231_Status DS3231_Clock_Poll(DS3231_Clock *clk)
+{
+    if (!clk || !clk->dev) return DS3231_INVALID_PARAM;
+
+    if (!clk->snap.valid) return DS3231_Clock_Resync(clk);
+    if (clk->check_period_s == 0 || (int32_t)(clock_edges(clk) - clk->next_check) < 0) return DS3231_OK;
+
+    PROF_SCOPE(PROF_ID_DS3231_CLOCK_CHECK, 0, NULL);
+
+    for (uint32_t i = 0; i < DS3231_CLOCK_SYNC_RETRIES; i++) {
+        DS3231_Time time;
+        uint32_t edge;
+        bool mismatch = false;
+        DS3231_Status st = clock_read_chip(clk, &time, &edge);
+
+        if (st != DS3231_OK) return st;
+        if (clock_store(clk, &time, edge, &mismatch)) {
+            if (mismatch) clk->mismatches++;
+            return DS3231_OK;
+        }
+    }
+    return DS3231_BUSY;
+}
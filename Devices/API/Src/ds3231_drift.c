@@ -0,0 +1,173 @@
+/**
+ * @file    ds3231_drift.c
+ * @brief   Modelo de deriva del DS3231 indexado por temperatura.
+ */
+
+#include "ds3231_drift.h"
+#include "dev_prof.h"
+#include <string.h>
+
+/* -------------------------------------------------------------------------- */
+/*  Helpers                                                                   */
+/* -------------------------------------------------------------------------- */
+
+static uint16_t drift_bin(int16_t temp_q4)
+{
+    if (temp_q4 < DS3231_DRIFT_T_MIN_Q4) temp_q4 = DS3231_DRIFT_T_MIN_Q4;
+    if (temp_q4 > DS3231_DRIFT_T_MAX_Q4) temp_q4 = DS3231_DRIFT_T_MAX_Q4;
+    return (uint16_t)(temp_q4 - DS3231_DRIFT_T_MIN_Q4);
+}
+
+/* Abre una ventana nueva con el AGING vigente, si hay referencia. */
+static void drift_window_open(DS3231_Drift *drift)
+{
+    if (drift->meter.ref_hz == 0) return;
+
+    drift->window_temp_q4 = drift->temp_q4;
+    DS3231_CalMeter_Reset(&drift->meter, drift->meter.ref_hz);
+    __atomic_store_n(&drift->measuring, true, __ATOMIC_RELEASE);
+}
+
+/* Fin de la conversión que aplica el nuevo AGING. */
+static void drift_conv_done(DS3231_Status status, DS3231_Temp temp, void *ctx)
+{
+    DS3231_Drift *drift = (DS3231_Drift *)ctx;
+
+    if (status != DS3231_OK) return;    // Se reintenta en el próximo Poll.
+
+    drift->applying = false;
+    drift_window_open(drift);
+}
+
+/* Lleva AGING al valor que cancela la deriva a la temperatura actual. */
+static DS3231_Status drift_compensate(DS3231_Drift *drift, uint32_t now_ms)
+{
+    int32_t d;
+    if (DS3231_Drift_Lookup(drift, drift->temp_q4, &d) != DS3231_OK) return DS3231_OK;
+
+    // Histéresis de 1/8 de LSB: una deriva cerca del punto medio no alterna entre dos valores.
+    int32_t err = d - (int32_t)drift->aging * drift->sens_ppb;
+    if (8 * (err < 0 ? -err : err) <= 5 * drift->sens_ppb) return DS3231_OK;
+
+    int32_t next = (int32_t)DS3231_Cal_DivRound(d, drift->sens_ppb);
+    if (next > INT8_MAX) next = INT8_MAX;
+    if (next < INT8_MIN) next = INT8_MIN;
+    if (next == drift->aging) return DS3231_OK;
+
+    DS3231_Status st = DS3231_Dev_SetAging(drift->dev, (int8_t)next);
+    if (st != DS3231_OK) return st;
+
+    // La ventana en curso mezclaría dos AGING: se descarta hasta aplicar el nuevo.
+    __atomic_store_n(&drift->measuring, false, __ATOMIC_RELEASE);
+    drift->aging    = (int8_t)next;
+    drift->applying = true;
+    drift->updates++;
+
+    return DS3231_CalApply_Poll(&drift->apply, drift->dev, now_ms);
+}
+
+/* -------------------------------------------------------------------------- */
+/*  API pública                                                               */
+/* -------------------------------------------------------------------------- */
+
+DS3231_Status DS3231_Drift_Start(DS3231_Drift *drift, DS3231_Handle *dev, DS3231_CalSource source,
+                                 uint32_t ref_hz, int32_t sens_ppb)
+{
+    if (!drift || !dev || source > DS3231_CAL_SRC_32KHZ) return DS3231_INVALID_PARAM;
+    if (ref_hz != 0 && ref_hz < (1UL << DS3231_CAL_TOL_SHIFT)) return DS3231_INVALID_PARAM;
+
+    memset(drift, 0, sizeof(*drift));
+    drift->dev      = dev;
+    drift->sens_ppb = (sens_ppb > 0) ? sens_ppb : DS3231_CAL_SENS_PPB;
+    DS3231_CalApply_Init(&drift->apply, drift_conv_done, drift);
+    for (uint16_t i = 0; i < DS3231_DRIFT_BINS; i++) drift->table[i] = DS3231_DRIFT_EMPTY;
+    DS3231_CalMeter_Reset(&drift->meter, ref_hz);
+
+    if (ref_hz != 0) {
+        DS3231_Status st = (source == DS3231_CAL_SRC_SQW) ? DS3231_Dev_SetSQWFreq(dev, DS3231_SQW_1HZ)
+                                                          : DS3231_Dev_Enable32KHz(dev, true);
+        if (st != DS3231_OK) return st;
+    }
+
+    return DS3231_Dev_GetAging(dev, &drift->aging);
+}
+
+void DS3231_Drift_Learn(DS3231_Drift *drift, int16_t temp_q4, int32_t ppb, int8_t aging)
+{
+    if (!drift) return;
+
+    int32_t d = ppb + (int32_t)aging * drift->sens_ppb;
+    if (d > INT16_MAX) d = INT16_MAX;
+    if (d < -INT16_MAX) d = -INT16_MAX;     // INT16_MIN queda reservado para DS3231_DRIFT_EMPTY.
+
+    int16_t *cell = &drift->table[drift_bin(temp_q4)];
+    if (*cell == DS3231_DRIFT_EMPTY) {
+        *cell = (int16_t)d;
+    } else {
+        *cell = (int16_t)(*cell + (int32_t)DS3231_Cal_DivRound(d - *cell, 1 << DS3231_DRIFT_LEARN_SHIFT));
+    }
+    drift->learned++;
+}
+
+DS3231_Status DS3231_Drift_Lookup(const DS3231_Drift *drift, int16_t temp_q4, int32_t *ppb)
+{
+    if (!drift || !ppb) return DS3231_INVALID_PARAM;
+
+    int32_t bin = drift_bin(temp_q4);
+    int32_t lo  = bin;
+    int32_t hi  = bin;
+    while (lo >= 0 && drift->table[lo] == DS3231_DRIFT_EMPTY) lo--;
+    while (hi < DS3231_DRIFT_BINS && drift->table[hi] == DS3231_DRIFT_EMPTY) hi++;
+
+    if (lo < 0 && hi >= DS3231_DRIFT_BINS) return DS3231_NOT_READY;
+
+    if (lo < 0) {
+        *ppb = drift->table[hi];
+    } else if (hi >= DS3231_DRIFT_BINS || hi == lo) {
+        *ppb = drift->table[lo];
+    } else {
+        int32_t a = drift->table[lo];
+        int32_t b = drift->table[hi];
+        *ppb = a + (int32_t)DS3231_Cal_DivRound((b - a) * (bin - lo), hi - lo);
+    }
+    return DS3231_OK;
+}
+
+void DS3231_Drift_OnEvent(DS3231_Drift *drift, uint32_t ref_ticks)
+{
+    if (!drift || !__atomic_load_n(&drift->measuring, __ATOMIC_ACQUIRE)) return;
+
+    (void)DS3231_CalMeter_OnEvent(&drift->meter, ref_ticks);
+}
+
+DS3231_Status DS3231_Drift_Poll(DS3231_Drift *drift, uint32_t now_ms)
+{
+    if (!drift || !drift->dev) return DS3231_INVALID_PARAM;
+    if (drift->applying) return DS3231_CalApply_Poll(&drift->apply, drift->dev, now_ms);
+
+    bool window = __atomic_load_n(&drift->measuring, __ATOMIC_ACQUIRE) &&
+                  __atomic_load_n(&drift->meter.ready, __ATOMIC_ACQUIRE);
+    if (drift->temp_valid && !window && (uint32_t)(now_ms - drift->last_read_ms) < DS3231_DRIFT_PERIOD_MS)
+        return DS3231_OK;
+
+    PROF_SCOPE(PROF_ID_DS3231_DRIFT_UPDATE, 0, NULL);
+
+    int16_t temp_q4;
+    DS3231_Status st = DS3231_Dev_GetTemperatureQ4(drift->dev, &temp_q4);
+    if (st != DS3231_OK) return st;
+    drift->temp_q4      = temp_q4;
+    drift->last_read_ms = now_ms;
+
+    if (window) {
+        // Se aprende a la temperatura media de la ventana si no cambió demasiado.
+        int32_t dq = temp_q4 - drift->window_temp_q4;
+        if (dq >= -DS3231_DRIFT_LEARN_MAX_DQ4 && dq <= DS3231_DRIFT_LEARN_MAX_DQ4) {
+            DS3231_Drift_Learn(drift, (int16_t)(drift->window_temp_q4 + dq / 2),
+                               DS3231_CalMeter_Ppb(&drift->meter), drift->aging);
+        }
+    }
+    if (window || !drift->temp_valid) drift_window_open(drift);
+    drift->temp_valid = true;
+
+    return drift_compensate(drift, now_ms);
+}
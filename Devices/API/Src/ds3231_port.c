@@ -4,38 +4,299 @@
  */
 
 #include "ds3231_port.h"
+#include "dev_i2cm_ll.h"
+#include "dev_prof.h"
 
 /* -------------------------------------------------------------------------- */
-/*  API pública                                                               */
+/*  Backends de transporte                                                    */
 /* -------------------------------------------------------------------------- */
 
-HAL_StatusTypeDef DS3231_is_ready(void)
+/*
+ * HAL: el contexto es el bus (I2C_HandleTypeDef *, NULL = hi2c1). El DS3231 se
+ * registra en dev_i2cm en el primer acceso a cada bus.
+ */
+static I2CM_Device hal_device(void *bus, uint8_t address)
 {
-    return I2CM_IsDeviceReady(DS3231_ADDRESS, DS3231_RETRY_COUNT);
+    I2CM_Device dev = I2CM_Find((I2C_HandleTypeDef *)bus, address);
+
+    if (dev == I2CM_DEVICE_INVALID) {
+        const I2CM_DeviceConfig config = {
+            .bus        = (I2C_HandleTypeDef *)bus,
+            .address    = address,
+            .speed_hz   = DS3231_I2C_SPEED_HZ,
+            .timeout_ms = I2C_TIMEOUT,
+        };
+        (void)I2CM_Register(&config, &dev);
+    }
+    return dev;
 }
 
-HAL_StatusTypeDef DS3231_register_write(uint8_t reg, uint8_t data)
+static HAL_StatusTypeDef hal_write(void *bus, uint8_t address, uint8_t *data, uint16_t len)
+{
+    return I2CM_Dev_Write(hal_device(bus, address), data, len);
+}
+
+static HAL_StatusTypeDef hal_read_reg(void *bus, uint8_t address, uint8_t reg, uint8_t *data, uint16_t len)
+{
+    return I2CM_Dev_Read_Sr(hal_device(bus, address), reg, data, len);
+}
+
+static HAL_StatusTypeDef hal_is_ready(void *bus, uint8_t address, uint32_t trials)
+{
+    return I2CM_Dev_IsReady(hal_device(bus, address), trials);
+}
+
+/*
+ * Las lecturas asíncronas pasan por el planificador de dev_i2cm, así esperan su
+ * turno junto a los demás dispositivos del bus. Hay una sola en vuelo por
+ * dispositivo registrado.
+ */
+typedef struct {
+    I2CM_Request req;
+    volatile bool pending;
+    I2CM_Callback cb;
+    void *ctx;
+} hal_async_slot;
+
+static hal_async_slot hal_slots[I2CM_MAX_DEVICES];
+
+static void hal_req_done(HAL_StatusTypeDef status, void *ctx)
+{
+    hal_async_slot *slot = (hal_async_slot *)ctx;
+    I2CM_Callback cb = slot->cb;
+
+    slot->pending = false;
+    if (cb) {
+        cb(status, slot->ctx);
+    }
+}
+
+static HAL_StatusTypeDef hal_submit(void *bus, uint8_t address, I2CM_Op op, uint8_t reg,
+                                    uint8_t *data, uint16_t len, I2CM_Callback cb, void *ctx)
+{
+    I2CM_Device dev = hal_device(bus, address);
+    if (dev == I2CM_DEVICE_INVALID) return HAL_ERROR;
+
+    hal_async_slot *slot = &hal_slots[dev];
+    if (slot->pending) return HAL_BUSY;
+
+    slot->pending = true;
+    slot->cb  = cb;
+    slot->ctx = ctx;
+    slot->req = (I2CM_Request){
+        .dev  = dev,
+        .op   = op,
+        .reg  = reg,
+        .data = data,
+        .size = len,
+        .cb   = hal_req_done,
+        .ctx  = slot,
+    };
+    if (I2CM_Submit(&slot->req) != HAL_OK) {
+        slot->pending = false;
+        return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef hal_read_reg_async(void *bus, uint8_t address, uint8_t reg, uint8_t *data, uint16_t len,
+                                            I2CM_Callback cb, void *ctx)
+{
+    return hal_submit(bus, address, I2CM_OP_READ_SR, reg, data, len, cb, ctx);
+}
+
+static HAL_StatusTypeDef hal_read_reg_dma(void *bus, uint8_t address, uint8_t reg, uint8_t *data, uint16_t len,
+                                          I2CM_Callback cb, void *ctx)
+{
+    return hal_submit(bus, address, I2CM_OP_READ_SR_DMA, reg, data, len, cb, ctx);
+}
+
+static bool hal_async_busy(void *bus, uint8_t address)
+{
+    I2CM_Device dev = I2CM_Find((I2C_HandleTypeDef *)bus, address);
+    return (dev != I2CM_DEVICE_INVALID) && hal_slots[dev].pending;
+}
+
+const DS3231_Transport DS3231_Transport_HAL = {
+    .write          = hal_write,
+    .read_reg       = hal_read_reg,
+    .is_ready       = hal_is_ready,
+    .read_reg_async = hal_read_reg_async,
+    .read_reg_dma   = hal_read_reg_dma,
+    .async_busy     = hal_async_busy,
+};
+
+#ifndef I2CM_HOST_SIM
+
+/* LL: el contexto es el periférico (I2C_TypeDef *); NULL equivale a I2C1. */
+static I2C_TypeDef *ll_instance(void *bus)
+{
+    return bus ? (I2C_TypeDef *)bus : I2C1;
+}
+
+static HAL_StatusTypeDef ll_write(void *bus, uint8_t address, uint8_t *data, uint16_t len)
+{
+    return I2CM_LL_Write(ll_instance(bus), address, data, len);
+}
+
+static HAL_StatusTypeDef ll_read_reg(void *bus, uint8_t address, uint8_t reg, uint8_t *data, uint16_t len)
+{
+    return I2CM_LL_Read_Sr(ll_instance(bus), address, reg, data, len);
+}
+
+static HAL_StatusTypeDef ll_is_ready(void *bus, uint8_t address, uint32_t trials)
+{
+    return I2CM_LL_IsDeviceReady(ll_instance(bus), address, trials);
+}
+
+const DS3231_Transport DS3231_Transport_LL = {
+    .write    = ll_write,
+    .read_reg = ll_read_reg,
+    .is_ready = ll_is_ready,
+};
+
+#define DS3231_DEFAULT_TRANSPORT   (&DS3231_Transport_HAL)
+#else
+#include "ds3231_sim.h"
+#define DS3231_DEFAULT_TRANSPORT   (&DS3231_Transport_Sim)
+#endif /* I2CM_HOST_SIM */
+
+static DS3231_Port ds3231_port = {
+    .transport = DS3231_DEFAULT_TRANSPORT,
+    .bus       = NULL,
+    .address   = DS3231_ADDRESS,
+};
+
+/* -------------------------------------------------------------------------- */
+/*  Acceso por puerto                                                         */
+/* -------------------------------------------------------------------------- */
+
+void DS3231_port_init(DS3231_Port *port, const DS3231_Transport *transport, void *bus, uint8_t address)
+{
+    if (!port) return;
+    port->transport = transport ? transport : DS3231_DEFAULT_TRANSPORT;
+    port->bus       = bus;
+    port->address   = address;
+}
+
+const DS3231_Port *DS3231_port_default(void)
+{
+    return &ds3231_port;
+}
+
+bool DS3231_port_busy(const DS3231_Port *port)
 {
+    return port->transport->async_busy ? port->transport->async_busy(port->bus, port->address) : false;
+}
+
+HAL_StatusTypeDef DS3231_port_is_ready(const DS3231_Port *port)
+{
+    PROF_SCOPE(PROF_ID_DS3231_IS_READY, 0, NULL);
+
+    return port->transport->is_ready(port->bus, port->address, DS3231_RETRY_COUNT);
+}
+
+HAL_StatusTypeDef DS3231_port_write(const DS3231_Port *port, uint8_t reg, uint8_t data)
+{
+    PROF_SCOPE(PROF_ID_DS3231_REG_WRITE, 2, NULL);
+
     //Genero el buffer con la direccion del registro y el byte de data.
     uint8_t buf[2] = { reg, data };
-    return I2CM_Write(DS3231_ADDRESS, buf, 2);
+    return port->transport->write(port->bus, port->address, buf, 2);
 }
 
-HAL_StatusTypeDef DS3231_register_block_write(uint8_t *data, uint16_t len)
+HAL_StatusTypeDef DS3231_port_block_write(const DS3231_Port *port, uint8_t *data, uint16_t len)
 {
+    PROF_SCOPE(PROF_ID_DS3231_REG_BLOCK_WRITE, len, NULL);
+
     if (!data || len == 0) return HAL_ERROR;
 
-    return I2CM_Write(DS3231_ADDRESS, data, len);
+    return port->transport->write(port->bus, port->address, data, len);
 }
 
-HAL_StatusTypeDef DS3231_register_read(uint8_t reg, uint8_t *data)
+HAL_StatusTypeDef DS3231_port_read(const DS3231_Port *port, uint8_t reg, uint8_t *data)
 {
+    PROF_SCOPE(PROF_ID_DS3231_REG_READ, 1, NULL);
+
     if (!data) return HAL_ERROR;
-    return I2CM_Read_Sr(DS3231_ADDRESS, reg, data, 1);
+    return port->transport->read_reg(port->bus, port->address, reg, data, 1);
 }
 
-HAL_StatusTypeDef DS3231_register_block_read(uint8_t reg, uint8_t *data, uint16_t len)
+HAL_StatusTypeDef DS3231_port_block_read(const DS3231_Port *port, uint8_t reg, uint8_t *data, uint16_t len)
+{
+    PROF_SCOPE(PROF_ID_DS3231_REG_BLOCK_READ, len, NULL);
+
+    if (!data || len == 0) return HAL_ERROR;
+    return port->transport->read_reg(port->bus, port->address, reg, data, len);
+}
+
+HAL_StatusTypeDef DS3231_port_block_read_async(const DS3231_Port *port, uint8_t reg, uint8_t *data, uint16_t len,
+                                               I2CM_Callback cb, void *ctx)
 {
+    PROF_SCOPE(PROF_ID_DS3231_REG_BLOCK_READ_ASYNC, len, NULL);
+
     if (!data || len == 0) return HAL_ERROR;
-    return I2CM_Read_Sr(DS3231_ADDRESS, reg, data, len);
-}
\ No newline at end of file
+    if (!port->transport->read_reg_async) return HAL_ERROR;
+    return port->transport->read_reg_async(port->bus, port->address, reg, data, len, cb, ctx);
+}
+
+HAL_StatusTypeDef DS3231_port_block_read_dma(const DS3231_Port *port, uint8_t reg, uint8_t *data, uint16_t len,
+                                             I2CM_Callback cb, void *ctx)
+{
+    PROF_SCOPE(PROF_ID_DS3231_REG_BLOCK_READ_DMA, len, NULL);
+
+    if (!data || len == 0) return HAL_ERROR;
+    if (!port->transport->read_reg_dma) return HAL_ERROR;
+    return port->transport->read_reg_dma(port->bus, port->address, reg, data, len, cb, ctx);
+}
+
+/* -------------------------------------------------------------------------- */
+/*  API pública (puerto por defecto)                                          */
+/* -------------------------------------------------------------------------- */
+
+void DS3231_port_set_transport(const DS3231_Transport *transport, void *bus)
+{
+    DS3231_port_init(&ds3231_port, transport, bus, DS3231_ADDRESS);
+}
+
+bool DS3231_port_async_busy(void)
+{
+    return DS3231_port_busy(&ds3231_port);
+}
+
+HAL_StatusTypeDef DS3231_is_ready(void)
+{
+    return DS3231_port_is_ready(&ds3231_port);
+}
+
+HAL_StatusTypeDef DS3231_register_write(uint8_t reg, uint8_t data)
+{
+    return DS3231_port_write(&ds3231_port, reg, data);
+}
+
+HAL_StatusTypeDef DS3231_register_block_write(uint8_t *data, uint16_t len)
+{
+    return DS3231_port_block_write(&ds3231_port, data, len);
+}
+
+HAL_StatusTypeDef DS3231_register_read(uint8_t reg, uint8_t *data)
+{
+    return DS3231_port_read(&ds3231_port, reg, data);
+}
+
+HAL_StatusTypeDef DS3231_register_block_read(uint8_t reg, uint8_t *data, uint16_t len)
+{
+    return DS3231_port_block_read(&ds3231_port, reg, data, len);
+}
+
+HAL_StatusTypeDef DS3231_register_block_read_async(uint8_t reg, uint8_t *data, uint16_t len,
+                                                   I2CM_Callback cb, void *ctx)
+{
+    return DS3231_port_block_read_async(&ds3231_port, reg, data, len, cb, ctx);
+}
+
+HAL_StatusTypeDef DS3231_register_block_read_dma(uint8_t reg, uint8_t *data, uint16_t len,
+                                                 I2CM_Callback cb, void *ctx)
+{
+    return DS3231_port_block_read_dma(&ds3231_port, reg, data, len, cb, ctx);
+}
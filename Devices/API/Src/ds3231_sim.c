@@ -0,0 +1,458 @@
+/**
+ * @file    ds3231_sim.c
+ * @brief   DS3231 simulado en memoria (transporte para builds de host).
+ */
+
+#include "ds3231_sim.h"
+#include <string.h>
+
+#define SIM_US_PER_S    (1000000U)
+#define SIM_PPB         (1000000000LL)
+
+static DS3231_Sim ds3231_sim_default;
+static bool ds3231_sim_default_init = false;
+
+/* -------------------------------------------------------------------------- */
+/*  Helpers                                                                   */
+/* -------------------------------------------------------------------------- */
+
+static uint8_t sim_bcd2dec(uint8_t v) { return (uint8_t)(((v >> 4) * 10) + (v & 0x0F)); }
+static uint8_t sim_dec2bcd(uint8_t v) { return (uint8_t)(((v / 10) << 4) | (v % 10)); }
+
+static DS3231_Sim *sim_instance(void *bus)
+{
+    return bus ? (DS3231_Sim *)bus : DS3231_Sim_Default();
+}
+
+/* El puntero interno se incrementa tras cada byte y vuelve a 0x00 después de 0x12. */
+static void sim_ptr_advance(DS3231_Sim *sim)
+{
+    sim->ptr = (uint8_t)((sim->ptr + 1) % DS3231_REG_MAP_SIZE);
+}
+
+static void sim_edge(DS3231_Sim *sim, DS3231_SimEdge edge)
+{
+    if (sim->on_edge) sim->on_edge(edge, sim->edge_ctx);
+}
+
+static void sim_power_on_regs(DS3231_Sim *sim)
+{
+    memset(sim->regs, 0, sizeof(sim->regs));
+
+    // Valores de power-on (datasheet): EOSC = 0, RS2 = RS1 = 1, INTCN = 1; OSF = 1, EN32KHZ = 1.
+    sim->regs[DS3231_REG_CONTROL] = DS3231_CTRL_RS2 | DS3231_CTRL_RS1 | DS3231_CTRL_INTCN;
+    sim->regs[DS3231_REG_STATUS]  = DS3231_STATUS_OSF | DS3231_STATUS_EN32KHZ;
+    sim->regs[DS3231_REG_DAY]     = 1;
+    sim->regs[DS3231_REG_DATE]    = 1;
+    sim->regs[DS3231_REG_MONTH]   = 1;
+    sim->ptr          = 0;
+    sim->subsec_us    = 0;
+    sim->conv_left_us = 0;
+    sim->tcxo_left_s  = DS3231_SIM_TCXO_PERIOD_S;
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Modelo de registros                                                       */
+/* -------------------------------------------------------------------------- */
+
+static void sim_start_conversion(DS3231_Sim *sim)
+{
+    sim->regs[DS3231_REG_STATUS] |= DS3231_STATUS_BSY;
+    sim->conv_left_us = DS3231_SIM_CONV_US;
+}
+
+static void sim_finish_conversion(DS3231_Sim *sim)
+{
+    sim->regs[DS3231_REG_TEMP_MSB] = (uint8_t)(int8_t)(sim->temp_q2 >> 2);
+    sim->regs[DS3231_REG_TEMP_LSB] = (uint8_t)((sim->temp_q2 & 0x03) << 6);
+    sim->regs[DS3231_REG_STATUS]  &= (uint8_t)~DS3231_STATUS_BSY;
+    sim->regs[DS3231_REG_CONTROL] &= (uint8_t)~DS3231_CTRL_CONV;
+    sim->conv_left_us = 0;
+    // El nuevo AGING recién afecta al oscilador después de una conversión.
+    sim->aging_applied = (int8_t)sim->regs[DS3231_REG_AGING];
+}
+
+static void sim_reg_write(DS3231_Sim *sim, uint8_t reg, uint8_t value)
+{
+    uint8_t old = sim->regs[reg];
+
+    switch (reg) {
+        case DS3231_REG_SECONDS:
+            // Escribir los segundos reinicia la cadena de cuenta.
+            sim->regs[reg] = value & 0x7F;
+            sim->subsec_us = 0;
+            break;
+
+        case DS3231_REG_CONTROL:
+            sim->regs[reg] = value;
+            // CONV inicia una conversión; si hay una en curso se atiende al terminar.
+            if ((value & DS3231_CTRL_CONV) && !(old & DS3231_CTRL_CONV) && sim->conv_left_us == 0)
+                sim_start_conversion(sim);
+            break;
+
+        case DS3231_REG_STATUS:
+            // BSY es solo lectura; OSF, A1F y A2F solo pueden escribirse a 0.
+            sim->regs[reg] = (uint8_t)((value & DS3231_STATUS_EN32KHZ) |
+                                       (old & DS3231_STATUS_BSY) |
+                                       (old & value & (DS3231_STATUS_OSF | DS3231_STATUS_A2F | DS3231_STATUS_A1F)));
+            break;
+
+        case DS3231_REG_TEMP_MSB:
+        case DS3231_REG_TEMP_LSB:
+            break;  // Solo lectura.
+
+        default:
+            sim->regs[reg] = value;
+            break;
+    }
+}
+
+/* Hora en formato 24 h a partir del registro (bit6 = 12 h, bit5 = PM). */
+static uint8_t sim_hours24(uint8_t reg)
+{
+    if (reg & 0x40) {
+        uint8_t h = sim_bcd2dec(reg & 0x1F) % 12;
+        return (uint8_t)(h + ((reg & 0x20) ? 12 : 0));
+    }
+    return sim_bcd2dec(reg & 0x3F);
+}
+
+static uint8_t sim_hours_reg(uint8_t h24, bool mode12)
+{
+    if (mode12) {
+        uint8_t h12 = (uint8_t)(h24 % 12);
+        return (uint8_t)(0x40 | (h24 >= 12 ? 0x20 : 0) | sim_dec2bcd(h12 ? h12 : 12));
+    }
+    return sim_dec2bcd(h24);
+}
+
+/* El chip considera bisiesto todo año divisible por 4 (00..99). */
+static uint8_t sim_days_in_month(uint8_t month, uint8_t year)
+{
+    static const uint8_t days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    if (month == 2 && (year % 4) == 0) return 29;
+    return days[(month - 1) % 12];
+}
+
+static void sim_tick_calendar(DS3231_Sim *sim)
+{
+    uint8_t *r = sim->regs;
+    uint8_t sec  = sim_bcd2dec(r[DS3231_REG_SECONDS] & 0x7F);
+    uint8_t min  = sim_bcd2dec(r[DS3231_REG_MINUTES] & 0x7F);
+    uint8_t hour = sim_hours24(r[DS3231_REG_HOURS]);
+    bool mode12  = (r[DS3231_REG_HOURS] & 0x40) != 0;
+
+    if (++sec < 60) { r[DS3231_REG_SECONDS] = sim_dec2bcd(sec); return; }
+    r[DS3231_REG_SECONDS] = 0;
+    if (++min < 60) { r[DS3231_REG_MINUTES] = sim_dec2bcd(min); return; }
+    r[DS3231_REG_MINUTES] = 0;
+    if (++hour < 24) { r[DS3231_REG_HOURS] = sim_hours_reg(hour, mode12); return; }
+    r[DS3231_REG_HOURS] = sim_hours_reg(0, mode12);
+
+    uint8_t day     = r[DS3231_REG_DAY] & 0x07;
+    uint8_t date    = sim_bcd2dec(r[DS3231_REG_DATE] & 0x3F);
+    uint8_t month   = sim_bcd2dec(r[DS3231_REG_MONTH] & 0x1F);
+    uint8_t century = r[DS3231_REG_MONTH] & 0x80;
+    uint8_t year    = sim_bcd2dec(r[DS3231_REG_YEAR]);
+
+    r[DS3231_REG_DAY] = (uint8_t)((day % 7) + 1);
+    if (++date <= sim_days_in_month(month, year)) { r[DS3231_REG_DATE] = sim_dec2bcd(date); return; }
+    r[DS3231_REG_DATE] = 0x01;
+    if (++month <= 12) { r[DS3231_REG_MONTH] = (uint8_t)(century | sim_dec2bcd(month)); return; }
+
+    // Desborde de 99 a 00: se invierte el bit de siglo.
+    if (++year > 99) { year = 0; century ^= 0x80; }
+    r[DS3231_REG_MONTH] = (uint8_t)(century | 0x01);
+    r[DS3231_REG_YEAR]  = sim_dec2bcd(year);
+}
+
+/* Compara los campos de alarma cuyo bit de máscara AxMn vale 0. */
+static bool sim_alarm_match(const uint8_t *r, const uint8_t *alarm, bool has_seconds)
+{
+    uint8_t i = 0;
+
+    if (has_seconds) {
+        if (!(alarm[i] & 0x80) && (alarm[i] & 0x7F) != (r[DS3231_REG_SECONDS] & 0x7F)) return false;
+        i++;
+    } else if ((r[DS3231_REG_SECONDS] & 0x7F) != 0) {
+        return false;   // La Alarma 2 solo evalúa con segundos = 00.
+    }
+    if (!(alarm[i] & 0x80) && (alarm[i] & 0x7F) != (r[DS3231_REG_MINUTES] & 0x7F)) return false;
+    i++;
+    if (!(alarm[i] & 0x80) && sim_hours24(alarm[i] & 0x7F) != sim_hours24(r[DS3231_REG_HOURS])) return false;
+    i++;
+    if (!(alarm[i] & 0x80)) {
+        if (alarm[i] & 0x40) {
+            if ((alarm[i] & 0x07) != (r[DS3231_REG_DAY] & 0x07)) return false;
+        } else {
+            if ((alarm[i] & 0x3F) != (r[DS3231_REG_DATE] & 0x3F)) return false;
+        }
+    }
+    return true;
+}
+
+static void sim_tick_second(DS3231_Sim *sim)
+{
+    uint8_t *r = sim->regs;
+    uint8_t ctrl = r[DS3231_REG_CONTROL];
+    bool fire_int = false;
+
+    sim_tick_calendar(sim);
+
+    if (sim_alarm_match(r, &r[DS3231_REG_ALARM_1], true)) {
+        r[DS3231_REG_STATUS] |= DS3231_STATUS_A1F;
+        fire_int |= (ctrl & DS3231_CTRL_A1IE) != 0;
+    }
+    if (sim_alarm_match(r, &r[DS3231_REG_ALARM_2], false)) {
+        r[DS3231_REG_STATUS] |= DS3231_STATUS_A2F;
+        fire_int |= (ctrl & DS3231_CTRL_A2IE) != 0;
+    }
+
+    if (ctrl & DS3231_CTRL_INTCN) {
+        if (fire_int) sim_edge(sim, DS3231_SIM_EDGE_INT);
+    } else if ((ctrl & (DS3231_CTRL_RS2 | DS3231_CTRL_RS1)) == DS3231_SQW_1HZ) {
+        sim_edge(sim, DS3231_SIM_EDGE_SQW);
+    }
+    if (r[DS3231_REG_STATUS] & DS3231_STATUS_EN32KHZ) sim_edge(sim, DS3231_SIM_EDGE_32KHZ);
+
+    if (--sim->tcxo_left_s == 0) {
+        sim->tcxo_left_s = DS3231_SIM_TCXO_PERIOD_S;
+        if (sim->conv_left_us == 0) sim_start_conversion(sim);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Operaciones de transporte                                                 */
+/* -------------------------------------------------------------------------- */
+
+/* Avanza el reloj virtual lo que ocupan @p cycles ciclos de SCL (solo con scl_hz != 0). */
+static void sim_bus_cycles(DS3231_Sim *sim, uint32_t cycles)
+{
+    if (sim->scl_hz == 0) return;
+
+    uint64_t ns = (uint64_t)cycles * 1000000000ULL / sim->scl_hz + sim->bus_ns;
+    sim->bus_ns = (uint32_t)(ns % 1000U);
+    DS3231_Sim_Advance(sim, ns / 1000U);
+}
+
+static HAL_StatusTypeDef sim_write(void *bus, uint8_t address, uint8_t *data, uint16_t len)
+{
+    DS3231_Sim *sim = sim_instance(bus);
+
+    sim->stats.transactions++;
+    sim->stats.starts++;
+    sim->stats.stops++;
+    sim->stats.bytes++;                         // Dirección + W
+    if (!sim->present || address != DS3231_ADDRESS) return HAL_ERROR;
+
+    sim->stats.bytes += len;
+    if (len == 0) return HAL_OK;
+
+    sim_bus_cycles(sim, 1 + 9 + 9);             // START, dirección y puntero
+    sim->ptr = data[0] % DS3231_REG_MAP_SIZE;
+    for (uint16_t i = 1; i < len; i++) {
+        sim_bus_cycles(sim, 9);                 // El registro se escribe en el ACK.
+        sim_reg_write(sim, sim->ptr, data[i]);
+        sim_ptr_advance(sim);
+    }
+    sim_bus_cycles(sim, 1);                     // STOP
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef sim_read_reg(void *bus, uint8_t address, uint8_t reg, uint8_t *data, uint16_t len)
+{
+    DS3231_Sim *sim = sim_instance(bus);
+
+    sim->stats.transactions++;
+    sim->stats.starts++;
+    sim->stats.stops++;
+    sim->stats.bytes++;                         // Dirección + W
+    if (!sim->present || address != DS3231_ADDRESS) return HAL_ERROR;
+
+    sim->stats.starts++;                        // Repeated start
+    sim->stats.bytes += 2 + len;                // Registro, dirección + R, datos
+    sim->ptr = reg % DS3231_REG_MAP_SIZE;
+    for (uint16_t i = 0; i < len; i++) {
+        data[i] = sim->regs[sim->ptr];
+        sim_ptr_advance(sim);
+    }
+    sim_bus_cycles(sim, 1 + 9 + 9 + 1 + 9 + 9U * len + 1);
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef sim_is_ready(void *bus, uint8_t address, uint32_t trials)
+{
+    DS3231_Sim *sim = sim_instance(bus);
+
+    sim->stats.transactions++;
+    sim->stats.starts++;
+    sim->stats.stops++;
+    sim->stats.bytes++;
+    sim_bus_cycles(sim, 1 + 9 + 1);
+    return (sim->present && address == DS3231_ADDRESS) ? HAL_OK : HAL_ERROR;
+}
+
+/* En el simulador las lecturas asíncronas finalizan en el acto. */
+static HAL_StatusTypeDef sim_read_reg_async(void *bus, uint8_t address, uint8_t reg, uint8_t *data, uint16_t len,
+                                            I2CM_Callback cb, void *ctx)
+{
+    HAL_StatusTypeDef status = sim_read_reg(bus, address, reg, data, len);
+
+    if (status == HAL_OK && cb) {
+        cb(HAL_OK, ctx);
+    }
+    return status;
+}
+
+static bool sim_async_busy(void *bus, uint8_t address)
+{
+    return false;
+}
+
+const DS3231_Transport DS3231_Transport_Sim = {
+    .write          = sim_write,
+    .read_reg       = sim_read_reg,
+    .is_ready       = sim_is_ready,
+    .read_reg_async = sim_read_reg_async,
+    .read_reg_dma   = sim_read_reg_async,
+    .async_busy     = sim_async_busy,
+};
+
+/* -------------------------------------------------------------------------- */
+/*  API pública                                                               */
+/* -------------------------------------------------------------------------- */
+
+void DS3231_Sim_Init(DS3231_Sim *sim)
+{
+    if (!sim) return;
+
+    memset(sim, 0, sizeof(*sim));
+    sim->present = true;
+    sim->temp_q2 = 25 * 4;
+    sim->aging_ppb = DS3231_SIM_AGING_PPB;
+    sim_power_on_regs(sim);
+
+    // Primera conversión al encender.
+    sim_start_conversion(sim);
+}
+
+void DS3231_Sim_ResetCounters(DS3231_Sim *sim)
+{
+    if (!sim) return;
+
+    memset(&sim->stats, 0, sizeof(sim->stats));
+}
+
+DS3231_Sim *DS3231_Sim_Default(void)
+{
+    if (!ds3231_sim_default_init) {
+        DS3231_Sim_Init(&ds3231_sim_default);
+        ds3231_sim_default_init = true;
+    }
+    return &ds3231_sim_default;
+}
+
+void DS3231_Sim_Advance(DS3231_Sim *sim, uint64_t us)
+{
+    if (!sim) return;
+
+    while (us > 0) {
+        // Tiempo del chip = tiempo real * (1 + error); el resto queda en frac.
+        int64_t  rate = SIM_PPB + DS3231_Sim_FrequencyError(sim);
+        uint64_t left = (uint64_t)(SIM_US_PER_S - sim->subsec_us) * SIM_PPB - sim->frac;
+
+        // Avanzo hasta el próximo evento: fin de segundo o fin de conversión.
+        uint64_t step = (left + (uint64_t)rate - 1U) / (uint64_t)rate;
+        if (sim->conv_left_us && sim->conv_left_us < step) step = sim->conv_left_us;
+        if (us < step) step = us;
+
+        uint64_t chip = step * (uint64_t)rate + sim->frac;
+        sim->frac       = (uint32_t)(chip % SIM_PPB);
+        sim->now_us    += step;
+        sim->subsec_us += (uint32_t)(chip / SIM_PPB);
+        us             -= step;
+
+        if (sim->conv_left_us) {
+            sim->conv_left_us -= (uint32_t)step;
+            if (sim->conv_left_us == 0) {
+                sim_finish_conversion(sim);
+                // CONV escrito durante una conversión automática: se atiende ahora.
+                if (sim->regs[DS3231_REG_CONTROL] & DS3231_CTRL_CONV) sim_start_conversion(sim);
+            }
+        }
+        if (sim->subsec_us >= SIM_US_PER_S) {
+            sim->subsec_us -= SIM_US_PER_S;
+            sim_tick_second(sim);
+        }
+    }
+}
+
+void DS3231_Sim_SetBusSpeed(DS3231_Sim *sim, uint32_t scl_hz)
+{
+    if (!sim) return;
+
+    sim->scl_hz = scl_hz;
+    sim->bus_ns = 0;
+}
+
+void DS3231_Sim_PowerLoss(DS3231_Sim *sim, uint64_t outage_us, bool battery)
+{
+    if (!sim) return;
+
+    if (battery && !(sim->regs[DS3231_REG_CONTROL] & DS3231_CTRL_EOSC)) {
+        // Con VBAT el oscilador sigue; la SQW solo sale si BBSQW = 1.
+        DS3231_SimEdgeCallback on_edge = sim->on_edge;
+        if (!(sim->regs[DS3231_REG_CONTROL] & DS3231_CTRL_BBSQW)) sim->on_edge = NULL;
+        DS3231_Sim_Advance(sim, outage_us);
+        sim->on_edge = on_edge;
+        return;
+    }
+
+    // Oscilador detenido: la hora queda congelada durante el corte.
+    sim->now_us += outage_us;
+    if (!battery) {
+        sim_power_on_regs(sim);
+    }
+    sim->regs[DS3231_REG_STATUS] |= DS3231_STATUS_OSF;
+    sim_start_conversion(sim);
+}
+
+void DS3231_Sim_SetTemperature(DS3231_Sim *sim, int16_t temp_q2)
+{
+    if (!sim) return;
+
+    sim->temp_q2 = temp_q2;
+}
+
+void DS3231_Sim_SetFrequencyError(DS3231_Sim *sim, int32_t ppb)
+{
+    if (!sim) return;
+
+    sim->ppb = ppb;
+}
+
+void DS3231_Sim_SetTempCoefficient(DS3231_Sim *sim, int16_t tc_ppb)
+{
+    if (!sim) return;
+
+    sim->tc_ppb = tc_ppb;
+}
+
+int32_t DS3231_Sim_FrequencyError(const DS3231_Sim *sim)
+{
+    if (!sim) return 0;
+
+    // (T - 25)^2 con T en cuartos de °C: d^2 / 16.
+    int32_t d  = sim->temp_q2 - 25 * 4;
+    int32_t tc = (int32_t)(((int64_t)sim->tc_ppb * d * d + 8) / 16);
+
+    return sim->ppb - tc - (int32_t)sim->aging_applied * sim->aging_ppb;
+}
+
+uint64_t DS3231_Sim_BusTimeNs(const DS3231_Sim *sim, uint32_t scl_hz)
+{
+    if (!sim || scl_hz == 0) return 0;
+
+    uint64_t bits = (uint64_t)sim->stats.bytes * 9U + sim->stats.starts + sim->stats.stops;
+    return (bits * 1000000000ULL) / scl_hz;
+}
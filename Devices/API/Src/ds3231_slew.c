@@ -0,0 +1,109 @@
+/**
+ * @file    ds3231_slew.c
+ * @brief   Corrección de fase sub-segundo del DS3231 por AGING (slew).
+ */
+
+#include "ds3231_slew.h"
+#include "dev_prof.h"
+#include <string.h>
+
+/* -------------------------------------------------------------------------- */
+/*  Helpers                                                                   */
+/* -------------------------------------------------------------------------- */
+
+/* Fin de la conversión que aplica AGING; Poll procesa el cambio de estado con su tick. */
+static void slew_conv_done(DS3231_Status status, DS3231_Temp temp, void *ctx)
+{
+    DS3231_Slew *slew = (DS3231_Slew *)ctx;
+
+    if (status == DS3231_OK) slew->applied = true;   // Si falló, se reintenta en el próximo Poll.
+}
+
+/* -------------------------------------------------------------------------- */
+/*  API pública                                                               */
+/* -------------------------------------------------------------------------- */
+
+DS3231_Status DS3231_Slew_Start(DS3231_Slew *slew, DS3231_Handle *dev, int32_t offset_us,
+                                int32_t sens_ppb, uint8_t lsb, uint32_t now_ms)
+{
+    if (!slew || !dev || lsb > INT8_MAX) return DS3231_INVALID_PARAM;
+    if (offset_us > DS3231_SLEW_MAX_US || offset_us < -DS3231_SLEW_MAX_US) return DS3231_INVALID_PARAM;
+
+    memset(slew, 0, sizeof(*slew));
+    slew->dev       = dev;
+    slew->offset_us = offset_us;
+    DS3231_CalApply_Init(&slew->apply, slew_conv_done, slew);
+    if (offset_us == 0) {
+        slew->state = DS3231_SLEW_DONE;
+        return DS3231_OK;
+    }
+
+    PROF_SCOPE(PROF_ID_DS3231_SLEW_STEP, 0, NULL);
+
+    DS3231_Status st = DS3231_Dev_GetAging(dev, &slew->base_aging);
+    if (st != DS3231_OK) return st;
+
+    // AGING positivo atrasa el oscilador: para adelantar el chip se baja.
+    int32_t step = (lsb != 0) ? lsb : (int32_t)DS3231_SLEW_LSB;
+    int32_t next = slew->base_aging + (offset_us > 0 ? -step : step);
+    if (next > INT8_MAX) next = INT8_MAX;
+    if (next < INT8_MIN) next = INT8_MIN;
+    if (next == slew->base_aging) return DS3231_INVALID_PARAM;
+
+    if (sens_ppb <= 0) sens_ppb = DS3231_CAL_SENS_PPB;
+    slew->slew_aging  = (int8_t)next;
+    slew->rate_ppb    = (slew->base_aging - next) * sens_ppb;
+
+    // t = offset / rate: µs * 1e6 / ppb da ms.
+    uint64_t num = (uint64_t)(offset_us > 0 ? offset_us : -offset_us) * 1000000U;
+    uint32_t den = (uint32_t)(slew->rate_ppb > 0 ? slew->rate_ppb : -slew->rate_ppb);
+    slew->duration_ms = (uint32_t)((num + den / 2U) / den);
+
+    st = DS3231_Dev_SetAging(dev, slew->slew_aging);
+    if (st != DS3231_OK) return st;
+
+    slew->state = DS3231_SLEW_APPLYING;
+    return DS3231_CalApply_Poll(&slew->apply, slew->dev, now_ms);
+}
+
+DS3231_Status DS3231_Slew_Poll(DS3231_Slew *slew, uint32_t now_ms)
+{
+    if (!slew || !slew->dev) return DS3231_INVALID_PARAM;
+
+    switch (slew->state) {
+        case DS3231_SLEW_APPLYING:
+        case DS3231_SLEW_RESTORING: {
+            DS3231_Status st = DS3231_CalApply_Poll(&slew->apply, slew->dev, now_ms);
+            if (!slew->applied) return st;
+            slew->applied = false;
+
+            // Ambas conversiones tardan lo mismo: contar desde el inicio de la
+            // primera hace que la segunda termine cuando vence el slew.
+            if (slew->state == DS3231_SLEW_APPLYING) {
+                slew->restore_ms = slew->apply.conv_ms + slew->duration_ms;
+                slew->state      = DS3231_SLEW_RUNNING;
+            } else {
+                slew->state      = DS3231_SLEW_DONE;
+            }
+            return DS3231_OK;
+        }
+
+        case DS3231_SLEW_RUNNING:
+            break;
+
+        case DS3231_SLEW_DONE:
+            return DS3231_OK;
+
+        default:
+            return DS3231_NOT_READY;
+    }
+    if ((int32_t)(now_ms - slew->restore_ms) < 0) return DS3231_OK;
+
+    PROF_SCOPE(PROF_ID_DS3231_SLEW_STEP, 0, NULL);
+
+    DS3231_Status st = DS3231_Dev_SetAging(slew->dev, slew->base_aging);
+    if (st != DS3231_OK) return st;
+
+    slew->state = DS3231_SLEW_RESTORING;
+    return DS3231_CalApply_Poll(&slew->apply, slew->dev, now_ms);
+}
@@ -10,14 +10,26 @@
  * @note
  *  - La dirección del esclavo se pasa en 7-bit (p.ej. 0x68) y la capa hace (addr<<1).
  *  - Timeout por defecto: I2C_TIMEOUT (ms).
+ *  - Cada esclavo se registra con I2CM_Register (bus, dirección, velocidad y
+ *    timeout propios). Las funciones por dirección operan sobre hi2c1; una
+ *    dirección no registrada usa la velocidad del bus e I2C_TIMEOUT.
+ *  - I2CM_Submit encola transferencias asíncronas de varios dispositivos y
+ *    las despacha de a una, alternando entre dispositivos (round-robin).
+ *  - Las funciones bloqueantes comparten el bus con las asíncronas: si hay una
+ *    transferencia en curso retornan HAL_BUSY sin tocar el bus.
+ *  - Las variantes *_IT no bloquean: retornan al iniciar la transferencia y
+ *    notifican el resultado mediante un I2CM_Callback desde la ISR de I2C1.
+ *  - I2CM_Read_Sr_DMA usa el stream de RX de I2C1 (DMA1 Stream0, canal 1).
+ *  - Con I2CM_HOST_SIM definido se excluye el acceso a HAL y la finalización
+ *    se simula llamando a I2CM_Async_Complete() (tests en host).
  */
 
 #ifndef DEV_I2CM_H
 #define DEV_I2CM_H
 
 #include "stm32f4xx_hal.h"
-#include "ds3231_port.h"
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -33,6 +45,57 @@ extern "C" {
 #define I2C_TIMEOUT           (5000)
 #endif
 
+/**
+ * @brief  Callback de finalización de una transferencia asíncrona.
+ * @param  status  HAL_OK si la transferencia finalizó correctamente.
+ * @param  ctx     Contexto de usuario pasado al iniciar la transferencia.
+ * @note   Se ejecuta en contexto de interrupción (I2C1_EV / I2C1_ER).
+ */
+typedef void (*I2CM_Callback)(HAL_StatusTypeDef status, void *ctx);
+
+#ifndef I2CM_MAX_DEVICES
+/** Cantidad máxima de dispositivos registrados */
+#define I2CM_MAX_DEVICES      (4)
+#endif
+
+/** Handle de un dispositivo registrado (índice en el registro). */
+typedef uint8_t I2CM_Device;
+
+/** Handle inválido (dispositivo no registrado). */
+#define I2CM_DEVICE_INVALID   ((I2CM_Device)0xFF)
+
+/**
+ * @brief  Configuración de un dispositivo del bus.
+ */
+typedef struct {
+    I2C_HandleTypeDef *bus;     /**< Bus del dispositivo (NULL = hi2c1). */
+    uint8_t  address;           /**< Dirección 7-bit. */
+    uint32_t speed_hz;          /**< Velocidad de SCL (0 = la del bus). */
+    uint32_t timeout_ms;        /**< Timeout bloqueante (0 = I2C_TIMEOUT). */
+} I2CM_DeviceConfig;
+
+/** Operación de una transferencia encolada. */
+typedef enum {
+    I2CM_OP_WRITE = 0,          /**< Escritura (Master_Transmit_IT). */
+    I2CM_OP_READ_SR,            /**< Lectura desde registro (Mem_Read_IT). */
+    I2CM_OP_READ_SR_DMA         /**< Lectura desde registro por DMA. */
+} I2CM_Op;
+
+/**
+ * @brief  Transferencia asíncrona para I2CM_Submit.
+ * @note   La memoria es del llamador y debe permanecer válida hasta el callback.
+ */
+typedef struct I2CM_Request {
+    I2CM_Device   dev;          /**< Dispositivo destino. */
+    I2CM_Op       op;           /**< Operación. */
+    uint8_t       reg;          /**< Registro de inicio (lecturas). */
+    uint8_t      *data;         /**< Buffer de la transferencia. */
+    uint16_t      size;         /**< Cantidad de bytes. */
+    I2CM_Callback cb;           /**< Callback de finalización (puede ser NULL). */
+    void         *ctx;          /**< Contexto de usuario para el callback. */
+    struct I2CM_Request *next;  /**< Uso interno (cola del dispositivo). */
+} I2CM_Request;
+
 /**
  * @brief  Inicializa I2C1 a 400 kHz, 7-bit, sin dual address.
  * @return HAL_OK si se configuró correctamente.
@@ -45,12 +108,89 @@ HAL_StatusTypeDef I2CM_I2C1_Init(void);
  */
 HAL_StatusTypeDef I2CM_I2C1_DeInit(void);
 
+/**
+ * @brief  Registra un dispositivo, o actualiza su configuración si ya existe.
+ * @param  config  Bus, dirección, velocidad y timeout.
+ * @param  dev     Handle de salida.
+ * @return HAL_OK si se registró, HAL_ERROR si no hay lugar.
+ */
+HAL_StatusTypeDef I2CM_Register(const I2CM_DeviceConfig *config, I2CM_Device *dev);
+
+/**
+ * @brief  Elimina un dispositivo del registro.
+ * @param  dev  Handle del dispositivo.
+ * @return HAL_OK si se eliminó, HAL_BUSY si tiene transferencias encoladas.
+ */
+HAL_StatusTypeDef I2CM_Unregister(I2CM_Device dev);
+
+/**
+ * @brief  Busca un dispositivo registrado.
+ * @param  bus      Bus (NULL = hi2c1).
+ * @param  address  Dirección 7-bit.
+ * @return Handle del dispositivo, o I2CM_DEVICE_INVALID.
+ */
+I2CM_Device I2CM_Find(I2C_HandleTypeDef *bus, uint8_t address);
+
+/**
+ * @brief  Escribe un buffer en un dispositivo registrado.
+ * @param  dev   Handle del dispositivo.
+ * @param  data  Puntero a buffer a transmitir.
+ * @param  size  Cantidad de bytes a transmitir.
+ * @return HAL_OK si finalizó correctamente,
+ *         HAL_BUSY si el bus está ocupado por otra transferencia (reintentar).
+ */
+HAL_StatusTypeDef I2CM_Dev_Write(I2CM_Device dev, uint8_t *data, uint16_t size);
+
+/**
+ * @brief  Lee un buffer crudo desde un dispositivo registrado.
+ * @param  dev   Handle del dispositivo.
+ * @param  data  Puntero a buffer de recepción.
+ * @param  size  Cantidad de bytes a recibir.
+ * @return HAL_OK si finalizó correctamente,
+ *         HAL_BUSY si el bus está ocupado por otra transferencia (reintentar).
+ */
+HAL_StatusTypeDef I2CM_Dev_Read(I2CM_Device dev, uint8_t *data, uint16_t size);
+
+/**
+ * @brief  Lee bytes desde un registro interno de un dispositivo registrado.
+ * @param  dev   Handle del dispositivo.
+ * @param  reg   Dirección interna (8-bit) de inicio.
+ * @param  data  Buffer de salida.
+ * @param  size  Número de bytes a leer.
+ * @return HAL_OK si finalizó correctamente,
+ *         HAL_BUSY si el bus está ocupado por otra transferencia (reintentar).
+ */
+HAL_StatusTypeDef I2CM_Dev_Read_Sr(I2CM_Device dev, uint8_t reg, uint8_t *data, uint16_t size);
+
+/**
+ * @brief  Verifica si un dispositivo registrado responde (ACK).
+ * @param  dev     Handle del dispositivo.
+ * @param  trials  Numero de reintentos.
+ * @return HAL_OK si respondió,
+ *         HAL_BUSY si el bus está ocupado por otra transferencia (reintentar).
+ */
+HAL_StatusTypeDef I2CM_Dev_IsReady(I2CM_Device dev, uint32_t trials);
+
+/**
+ * @brief  Encola una transferencia asíncrona.
+ *
+ * Si el bus está libre arranca en el momento; si no, espera en la cola de su
+ * dispositivo. Al terminar cada transferencia se atiende al siguiente
+ * dispositivo con pendientes, de modo que ninguno acapara el bus.
+ *
+ * @param  req  Transferencia (ver I2CM_Request).
+ * @return HAL_OK si fue aceptada: el resultado llega por req->cb (también si
+ *         falla al arrancar). HAL_ERROR si los parámetros son inválidos.
+ */
+HAL_StatusTypeDef I2CM_Submit(I2CM_Request *req);
+
 /**
  * @brief  Escribe un buffer en un esclavo I²C.
  * @param  address  Dirección 7-bit (p.ej. 0x68).
  * @param  data     Puntero a buffer a transmitir.
  * @param  size     Cantidad de bytes a transmitir.
- * @return HAL_OK si finalizó correctamente.
+ * @return HAL_OK si finalizó correctamente,
+ *         HAL_BUSY si el bus está ocupado por otra transferencia (reintentar).
  */
 HAL_StatusTypeDef I2CM_Write(uint8_t address, uint8_t *data, uint16_t size);
 
@@ -59,7 +199,8 @@ HAL_StatusTypeDef I2CM_Write(uint8_t address, uint8_t *data, uint16_t size);
  * @param  address  Dirección 7-bit (p.ej. 0x68).
  * @param  data     Puntero a buffer de recepción.
  * @param  size     Cantidad de bytes a recibir.
- * @return HAL_OK si finalizó correctamente.
+ * @return HAL_OK si finalizó correctamente,
+ *         HAL_BUSY si el bus está ocupado por otra transferencia (reintentar).
  */
 HAL_StatusTypeDef I2CM_Read(uint8_t address, uint8_t *data, uint16_t size);
 
@@ -69,7 +210,8 @@ HAL_StatusTypeDef I2CM_Read(uint8_t address, uint8_t *data, uint16_t size);
  * @param  reg      Dirección interna (8-bit) de inicio.
  * @param  data     Buffer de salida.
  * @param  size     Número de bytes a leer.
- * @return HAL_OK si finalizó correctamente.
+ * @return HAL_OK si finalizó correctamente,
+ *         HAL_BUSY si el bus está ocupado por otra transferencia (reintentar).
  */
 HAL_StatusTypeDef I2CM_Read_Sr(uint8_t address, uint8_t reg, uint8_t *data, uint16_t size);
 
@@ -77,10 +219,88 @@ HAL_StatusTypeDef I2CM_Read_Sr(uint8_t address, uint8_t reg, uint8_t *data, uint
  * @brief  Verifica si un esclavo responde (ACK) en la dirección dada.
  * @param  address  Dirección 7-bit.
  * @param  trials   Numero de reintentos.
- * @return HAL_OK si respondió el esclavo a la direccion dada.
+ * @return HAL_OK si respondió el esclavo a la direccion dada,
+ *         HAL_BUSY si el bus está ocupado por otra transferencia (reintentar).
  */
 HAL_StatusTypeDef I2CM_IsDeviceReady(uint8_t address, uint32_t trials);
 
+/**
+ * @brief  Escribe un buffer en un esclavo I²C sin bloquear (HAL_I2C_Master_Transmit_IT).
+ * @param  address  Dirección 7-bit (p.ej. 0x68).
+ * @param  data     Buffer a transmitir, debe permanecer válido hasta el callback.
+ * @param  size     Cantidad de bytes a transmitir.
+ * @param  cb       Callback de finalización (puede ser NULL).
+ * @param  ctx      Contexto de usuario para el callback.
+ * @return HAL_OK si la transferencia se inició, HAL_BUSY si hay otra en curso
+ *         o encolada.
+ */
+HAL_StatusTypeDef I2CM_Write_IT(uint8_t address, uint8_t *data, uint16_t size,
+                                I2CM_Callback cb, void *ctx);
+
+/**
+ * @brief  Lee bytes desde un registro interno sin bloquear (HAL_I2C_Mem_Read_IT).
+ * @param  address  Dirección 7-bit (p.ej. 0x68).
+ * @param  reg      Dirección interna (8-bit) de inicio.
+ * @param  data     Buffer de salida, debe permanecer válido hasta el callback.
+ * @param  size     Número de bytes a leer.
+ * @param  cb       Callback de finalización (puede ser NULL).
+ * @param  ctx      Contexto de usuario para el callback.
+ * @return HAL_OK si la transferencia se inició, HAL_BUSY si hay otra en curso
+ *         o encolada.
+ */
+HAL_StatusTypeDef I2CM_Read_Sr_IT(uint8_t address, uint8_t reg, uint8_t *data, uint16_t size,
+                                  I2CM_Callback cb, void *ctx);
+
+/**
+ * @brief  Lee bytes desde un registro interno por DMA (HAL_I2C_Mem_Read_DMA).
+ *
+ * Los datos se copian a @p data sin intervención de la CPU; la finalización
+ * se notifica igual que en I2CM_Read_Sr_IT.
+ *
+ * @param  address  Dirección 7-bit (p.ej. 0x68).
+ * @param  reg      Dirección interna (8-bit) de inicio.
+ * @param  data     Buffer de salida, debe permanecer válido hasta el callback.
+ * @param  size     Número de bytes a leer.
+ * @param  cb       Callback de finalización (puede ser NULL).
+ * @param  ctx      Contexto de usuario para el callback.
+ * @return HAL_OK si la transferencia se inició, HAL_BUSY si hay otra en curso
+ *         o encolada.
+ */
+HAL_StatusTypeDef I2CM_Read_Sr_DMA(uint8_t address, uint8_t reg, uint8_t *data, uint16_t size,
+                                   I2CM_Callback cb, void *ctx);
+
+/**
+ * @brief  Indica si hay una transferencia asíncrona en curso.
+ * @return true mientras no se haya notificado la finalización.
+ */
+bool I2CM_Async_IsBusy(void);
+
+/**
+ * @brief  Finaliza la transferencia asíncrona en curso y ejecuta su callback.
+ * @param  status  Resultado de la transferencia.
+ * @note   La llaman los callbacks de HAL; en host se usa para simular la ISR.
+ */
+void I2CM_Async_Complete(HAL_StatusTypeDef status);
+
+#ifdef I2CM_HOST_SIM
+/**
+ * @brief  Transferencia pendiente en el bus simulado (solo host).
+ */
+typedef struct {
+    uint8_t  address;   /**< Dirección 7-bit del esclavo. */
+    bool     is_read;   /**< true: lectura desde registro, false: escritura. */
+    bool     use_dma;   /**< true si se inició con I2CM_Read_Sr_DMA. */
+    uint8_t  reg;       /**< Registro de inicio (solo lectura). */
+    uint8_t *data;      /**< Buffer de la transferencia. */
+    uint16_t size;      /**< Cantidad de bytes. */
+} I2CM_SimTransfer;
+
+/**
+ * @brief  Devuelve la transferencia pendiente, o NULL si el bus está libre.
+ */
+const I2CM_SimTransfer *I2CM_Sim_GetPending(void);
+#endif
+
 /** @} */ // end group DEV_I2CM
 
 #ifdef __cplusplus
@@ -0,0 +1,69 @@
+/**
+ * @file    dev_i2cm_ll.h
+ * @brief   Capa de I2C Master (LL) para STM32.
+ * @author  > Matias D. <
+ * @date    2025
+ *
+ * @details
+ *  Variante liviana de dev_i2cm basada en los drivers LL: opera por polling
+ *  directo sobre los registros del periférico, sin el manejo de estados de
+ *  HAL. El periférico debe estar inicializado (p.ej. con I2CM_I2C1_Init).
+ *
+ * @note
+ *  - La dirección del esclavo se pasa en 7-bit (p.ej. 0x68) y la capa hace (addr<<1).
+ *  - Timeout por defecto: I2C_TIMEOUT (ms).
+ */
+
+#ifndef DEV_I2CM_LL_H
+#define DEV_I2CM_LL_H
+
+#include "stm32f4xx_hal.h"
+#include "stm32f4xx_ll_i2c.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup DEV_I2CM_LL I2C Master (LL)
+ *  @brief Operaciones I²C Master por polling sobre LL.
+ *  @{
+ */
+
+/**
+ * @brief  Escribe un buffer en un esclavo I²C.
+ * @param  I2Cx     Periférico (p.ej. I2C1).
+ * @param  address  Dirección 7-bit (p.ej. 0x68).
+ * @param  data     Puntero a buffer a transmitir.
+ * @param  size     Cantidad de bytes a transmitir.
+ * @return HAL_OK si finalizó correctamente.
+ */
+HAL_StatusTypeDef I2CM_LL_Write(I2C_TypeDef *I2Cx, uint8_t address, const uint8_t *data, uint16_t size);
+
+/**
+ * @brief  Lee bytes desde un registro interno (escritura del registro + repeated start).
+ * @param  I2Cx     Periférico (p.ej. I2C1).
+ * @param  address  Dirección 7-bit (p.ej. 0x68).
+ * @param  reg      Dirección interna (8-bit) de inicio.
+ * @param  data     Buffer de salida.
+ * @param  size     Número de bytes a leer.
+ * @return HAL_OK si finalizó correctamente.
+ */
+HAL_StatusTypeDef I2CM_LL_Read_Sr(I2C_TypeDef *I2Cx, uint8_t address, uint8_t reg, uint8_t *data, uint16_t size);
+
+/**
+ * @brief  Verifica si un esclavo responde (ACK) en la dirección dada.
+ * @param  I2Cx     Periférico (p.ej. I2C1).
+ * @param  address  Dirección 7-bit.
+ * @param  trials   Numero de reintentos.
+ * @return HAL_OK si respondió el esclavo a la direccion dada.
+ */
+HAL_StatusTypeDef I2CM_LL_IsDeviceReady(I2C_TypeDef *I2Cx, uint8_t address, uint32_t trials);
+
+/** @} */ // end group DEV_I2CM_LL
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEV_I2CM_LL_H */
@@ -0,0 +1,231 @@
+/**
+ * @file    dev_prof.h
+ * @brief   Instrumentación por ciclos (DWT CYCCNT) de las llamadas I2CM_* y DS3231_*.
+ * @author  > Matias D. <
+ * @date    2025
+ *
+ * @details
+ *  Cada llamada instrumentada guarda un registro {id, CYCCNT inicio/fin,
+ *  bytes, código de error HAL} en un buffer circular de tamaño fijo. La
+ *  reserva de cada entrada es atómica, por lo que se puede registrar desde
+ *  el lazo principal y desde ISR sin bloquear. Sobre los registros se
+ *  calculan min/avg/max/p99 por llamada y se vuelcan por USART2 (huart2).
+ *
+ * @note
+ *  - Solo se compila con DEV_PROF_ENABLE definido; sin él, PROF_SCOPE() no
+ *    genera código y dev_prof.c queda vacío.
+ *  - El contador de ciclos es intercambiable (PROF_SetCycleSource) para
+ *    probar la agregación en host con un contador falso.
+ *  - Los registros de llamadas DS3231_* de alto nivel llevan bytes = 0 y como
+ *    error el último código HAL registrado durante la llamada (si lo hubo).
+ */
+
+#ifndef DEV_PROF_H
+#define DEV_PROF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup DEV_PROF Profiling por ciclos
+ *  @brief Registro y agregación de ciclos por llamada.
+ *  @{
+ */
+
+/** Lista de llamadas instrumentadas (X-macro: genera ids y nombres). */
+#define PROF_CALL_LIST(X)               \
+    X(I2CM_WRITE)                       \
+    X(I2CM_READ)                        \
+    X(I2CM_READ_SR)                     \
+    X(I2CM_IS_READY)                    \
+    X(I2CM_WRITE_IT)                    \
+    X(I2CM_READ_SR_IT)                  \
+    X(I2CM_READ_SR_DMA)                 \
+    X(DS3231_IS_READY)                  \
+    X(DS3231_REG_WRITE)                 \
+    X(DS3231_REG_BLOCK_WRITE)           \
+    X(DS3231_REG_READ)                  \
+    X(DS3231_REG_BLOCK_READ)            \
+    X(DS3231_REG_BLOCK_READ_ASYNC)      \
+    X(DS3231_REG_BLOCK_READ_DMA)        \
+    X(DS3231_INIT)                      \
+    X(DS3231_CACHE_REFRESH)             \
+    X(DS3231_READ_TIME)                 \
+    X(DS3231_SET_TIME)                  \
+    X(DS3231_GET_TEMPERATURE)           \
+    X(DS3231_READ_SNAPSHOT)             \
+    X(DS3231_READ_TIME_ASYNC)           \
+    X(DS3231_GET_TEMPERATURE_ASYNC)     \
+    X(DS3231_SNAPSHOT_DMA_START)        \
+    X(DS3231_GET_STATUS)                \
+    X(DS3231_CLEAR_STATUS)              \
+    X(DS3231_GET_CONTROL)               \
+    X(DS3231_UPDATE_CONTROL)            \
+    X(DS3231_CLEAR_CONTROL)             \
+    X(DS3231_ENABLE_32KHZ)              \
+    X(DS3231_SET_SQW_FREQ)              \
+    X(DS3231_SET_AGING)                 \
+    X(DS3231_GET_AGING)                 \
+    X(DS3231_SET_ALARM)                 \
+    X(DS3231_GET_ALARM)                 \
+    X(DS3231_ARM_ALARM)                 \
+    X(DS3231_DISARM_ALARM)              \
+    X(DS3231_ACK_ALARMS)                \
+    X(DS3231_CLOCK_RESYNC)              \
+    X(DS3231_CLOCK_CHECK)               \
+    X(DS3231_SET_HOUR_MODE)             \
+    X(DS3231_GET_HOUR_MODE)             \
+    X(DS3231_CONVERT_START)             \
+    X(DS3231_CONVERT_POLL)              \
+    X(DS3231_GET_TEMPERATURE_Q4)        \
+    X(DS3231_CAL_STEP)                  \
+    X(DS3231_DRIFT_UPDATE)              \
+    X(DS3231_SUPERVISE)                 \
+    X(DS3231_SET_TIME_ALIGNED)          \
+    X(DS3231_ADJUST_TIME)               \
+    X(DS3231_SLEW_STEP)
+
+/** Identificador de llamada instrumentada. */
+typedef enum {
+#define PROF_ID_ENUM(name) PROF_ID_##name,
+    PROF_CALL_LIST(PROF_ID_ENUM)
+#undef PROF_ID_ENUM
+    PROF_ID_COUNT
+} PROF_CallId;
+
+#ifdef DEV_PROF_ENABLE
+
+#ifndef PROF_RING_SIZE
+/** Cantidad de registros del buffer circular (potencia de 2). */
+#define PROF_RING_SIZE        (256U)
+#endif
+
+#if (PROF_RING_SIZE & (PROF_RING_SIZE - 1U)) != 0
+#error "PROF_RING_SIZE debe ser potencia de 2"
+#endif
+
+/** Registro de una llamada. */
+typedef struct {
+    uint32_t start;     /**< CYCCNT al entrar. */
+    uint32_t end;       /**< CYCCNT al salir. */
+    uint16_t id;        /**< PROF_CallId. */
+    uint16_t bytes;     /**< Bytes pedidos al bus (0 si no aplica). */
+    uint32_t error;     /**< Código de error HAL (HAL_I2C_ERROR_*), 0 si no hubo. */
+} PROF_Record;
+
+/** Estadísticas de una llamada, en ciclos. */
+typedef struct {
+    uint32_t count;     /**< Registros considerados. */
+    uint32_t errors;    /**< Registros con error distinto de 0. */
+    uint32_t min;
+    uint32_t avg;
+    uint32_t max;
+    uint32_t p99;       /**< Percentil 99 (nearest-rank). */
+} PROF_Stats;
+
+/** Fuente de ciclos (por defecto DWT->CYCCNT). */
+typedef uint32_t (*PROF_CycleSource)(void);
+
+/** Salida de texto usada por PROF_Dump. */
+typedef void (*PROF_WriteFn)(const char *text, uint16_t len);
+
+/** Contexto de una llamada en curso (ver PROF_SCOPE). */
+typedef struct {
+    uint32_t start;
+    uint32_t err_seq;
+    const volatile uint32_t *error;
+    uint16_t id;
+    uint16_t bytes;
+} PROF_Scope;
+
+/**
+ * @brief  Habilita el contador de ciclos del DWT y vacía el buffer.
+ * @note   En host (I2CM_HOST_SIM) solo vacía el buffer.
+ */
+void PROF_Init(void);
+
+/**
+ * @brief  Vacía el buffer de registros.
+ */
+void PROF_Reset(void);
+
+/**
+ * @brief  Reemplaza la fuente de ciclos.
+ * @param  source  Función que devuelve el contador actual; NULL restaura DWT->CYCCNT.
+ */
+void PROF_SetCycleSource(PROF_CycleSource source);
+
+/**
+ * @brief  Lee la fuente de ciclos actual.
+ */
+uint32_t PROF_Cycles(void);
+
+/**
+ * @brief  Guarda un registro en el buffer (seguro desde ISR).
+ * @param  id     Llamada.
+ * @param  start  Ciclos al entrar.
+ * @param  end    Ciclos al salir.
+ * @param  bytes  Bytes pedidos al bus.
+ * @param  error  Código de error HAL, 0 si no hubo.
+ */
+void PROF_Log(PROF_CallId id, uint32_t start, uint32_t end, uint16_t bytes, uint32_t error);
+
+/**
+ * @brief  Calcula min/avg/max/p99 de una llamada sobre los registros presentes.
+ * @param  id     Llamada.
+ * @param  stats  Estadísticas de salida.
+ * @return true si hay al menos un registro de esa llamada.
+ * @note   No es reentrante: llamar desde el lazo principal.
+ */
+bool PROF_Aggregate(PROF_CallId id, PROF_Stats *stats);
+
+/**
+ * @brief  Devuelve el nombre de una llamada (p.ej. "DS3231_READ_TIME").
+ */
+const char *PROF_Name(PROF_CallId id);
+
+/**
+ * @brief  Vuelca una línea CSV por llamada con registros.
+ * @param  write  Salida de texto.
+ */
+void PROF_Dump(PROF_WriteFn write);
+
+#ifndef I2CM_HOST_SIM
+/**
+ * @brief  Vuelca las estadísticas por USART2 (huart2), bloqueante.
+ */
+void PROF_DumpUART(void);
+#endif
+
+/* Uso interno de PROF_SCOPE. */
+PROF_Scope PROF_ScopeBegin(PROF_CallId id, uint16_t bytes, const volatile uint32_t *error);
+void PROF_ScopeEnd(PROF_Scope *scope);
+
+/**
+ * @brief  Instrumenta el resto del bloque actual como llamada @p id.
+ *
+ * El registro se guarda al salir del bloque por cualquier return.
+ * @p error apunta al código de error HAL a leer al salir (p.ej.
+ * &hi2c1.ErrorCode); con NULL se toma el último error registrado por las
+ * llamadas anidadas.
+ */
+#define PROF_SCOPE(id, bytes, error) \
+    PROF_Scope prof_scope __attribute__((cleanup(PROF_ScopeEnd))) = \
+        PROF_ScopeBegin((id), (uint16_t)(bytes), (error))
+
+#else /* !DEV_PROF_ENABLE */
+
+#define PROF_SCOPE(id, bytes, error)   do { } while (0)
+
+#endif /* DEV_PROF_ENABLE */
+
+/** @} */ // end group DEV_PROF
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEV_PROF_H */
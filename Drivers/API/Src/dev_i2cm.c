@@ -19,12 +19,93 @@
 /* USER CODE END Header */
 /* Includes ------------------------------------------------------------------*/
 #include "dev_i2cm.h"
+#include "dev_prof.h"
 
 /* USER CODE BEGIN 0 */
 
+/* Entrada del registro de dispositivos, con su cola de transferencias. */
+typedef struct {
+	bool used;
+	I2CM_DeviceConfig cfg;
+	I2CM_Request *head;
+	I2CM_Request *tail;
+} I2CM_DeviceEntry;
+
+static I2CM_DeviceEntry i2cm_devices[I2CM_MAX_DEVICES];
+static uint8_t i2cm_rr_last = I2CM_MAX_DEVICES - 1;	// Último dispositivo atendido.
+
+/* Estado de la transferencia asíncrona en curso (una por vez). */
+typedef struct {
+	volatile bool busy;
+	I2C_HandleTypeDef *bus;
+	I2CM_Callback cb;
+	void *ctx;
+#ifdef I2CM_HOST_SIM
+	I2CM_SimTransfer xfer;
+#endif
+} I2CM_AsyncState;
+
+static I2CM_AsyncState i2cm_async;
+
+/* La cola se comparte con la ISR de fin de transferencia. */
+#ifndef I2CM_HOST_SIM
+#define I2CM_CRITICAL_ENTER()	uint32_t i2cm_primask = __get_PRIMASK(); __disable_irq()
+#define I2CM_CRITICAL_EXIT()	__set_PRIMASK(i2cm_primask)
+#else
+#define I2CM_CRITICAL_ENTER()	do { } while (0)
+#define I2CM_CRITICAL_EXIT()	do { } while (0)
+#endif
+
+static I2CM_DeviceEntry *I2CM_Get_Device(I2CM_Device dev)
+{
+	if (dev >= I2CM_MAX_DEVICES || !i2cm_devices[dev].used) {
+		return NULL;
+	}
+	return &i2cm_devices[dev];
+}
+
+static bool I2CM_Queue_Pending(void)
+{
+	for (uint8_t i = 0; i < I2CM_MAX_DEVICES; i++) {
+		if (i2cm_devices[i].used && i2cm_devices[i].head) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static HAL_StatusTypeDef I2CM_Async_Begin(I2C_HandleTypeDef *bus, I2CM_Callback cb, void *ctx)
+{
+	I2CM_CRITICAL_ENTER();
+	if (i2cm_async.busy || I2CM_Queue_Pending()) {
+		I2CM_CRITICAL_EXIT();
+		return HAL_BUSY;
+	}
+	i2cm_async.busy = true;
+	i2cm_async.bus  = bus;
+	i2cm_async.cb   = cb;
+	i2cm_async.ctx  = ctx;
+	I2CM_CRITICAL_EXIT();
+	return HAL_OK;
+}
+
+static void I2CM_Async_Abort(void)
+{
+	i2cm_async.cb   = NULL;
+	i2cm_async.ctx  = NULL;
+	i2cm_async.busy = false;
+}
+
+static void I2CM_Sched_Next(void);
+
 /* USER CODE END 0 */
 
+#ifndef I2CM_HOST_SIM
+
 I2C_HandleTypeDef hi2c1;
+DMA_HandleTypeDef hdma_i2c1_rx;
+
+#define I2CM_DEFAULT_BUS	(&hi2c1)
 
 /* I2C1 init function */
 HAL_StatusTypeDef I2CM_I2C1_Init(void)
@@ -54,76 +135,488 @@ HAL_StatusTypeDef I2CM_I2C1_DeInit(void)
 	return HAL_OK;
 }
 
-HAL_StatusTypeDef I2CM_Write(uint8_t address, uint8_t *data, uint16_t size)
+static uint32_t I2CM_Timeout(const I2CM_DeviceEntry *d)
 {
-	HAL_StatusTypeDef ret = HAL_OK;
-	I2C_HandleTypeDef *i2c_handler;
+	return d->cfg.timeout_ms ? d->cfg.timeout_ms : I2C_TIMEOUT;
+}
 
-	if (address == DS3231_ADDRESS) {
-		i2c_handler = &hi2c1;
-	} else {
-		return HAL_ERROR; // Invalid I2C address
+/*
+ * Ajusta el SCL del bus a la velocidad del dispositivo. Solo reconfigura si
+ * cambia, y nunca con una transferencia en curso.
+ */
+static HAL_StatusTypeDef I2CM_Apply_Speed(const I2CM_DeviceEntry *d)
+{
+	I2C_HandleTypeDef *bus = d->cfg.bus;
+
+	if (d->cfg.speed_hz == 0 || bus->Init.ClockSpeed == d->cfg.speed_hz) {
+		return HAL_OK;
 	}
-	if (HAL_I2C_Master_Transmit(i2c_handler, (address << 1), data, size, I2C_TIMEOUT) != HAL_OK) {
-		if (HAL_I2C_GetError(i2c_handler) != HAL_I2C_ERROR_AF) {
-			return HAL_ERROR;
+	if (bus->State != HAL_I2C_STATE_READY) {
+		return HAL_BUSY;
+	}
+	bus->Init.ClockSpeed = d->cfg.speed_hz;
+	return HAL_I2C_Init(bus);
+}
+
+/*
+ * Las transferencias bloqueantes toman el mismo turno que las asíncronas: con
+ * una en curso devuelven HAL_BUSY para que el llamador reintente, y lo que se
+ * encole mientras tanto arranca al liberar el bus.
+ */
+static void I2CM_Blocking_End(void)
+{
+	I2CM_Async_Abort();
+	I2CM_Sched_Next();
+}
+
+/* Resultado de una llamada bloqueante de HAL: HAL_BUSY se propaga y un NACK (AF) vale on_af. */
+static HAL_StatusTypeDef I2CM_Blocking_Result(I2C_HandleTypeDef *bus, HAL_StatusTypeDef st,
+                                              HAL_StatusTypeDef on_af)
+{
+	if (st == HAL_OK || st == HAL_BUSY) {
+		return st;
+	}
+	return (HAL_I2C_GetError(bus) == HAL_I2C_ERROR_AF) ? on_af : HAL_ERROR;
+}
+
+static HAL_StatusTypeDef I2CM_Blocking_Write(const I2CM_DeviceEntry *d, uint8_t *data, uint16_t size)
+{
+	I2C_HandleTypeDef *i2c_handler = d->cfg.bus;
+	PROF_SCOPE(PROF_ID_I2CM_WRITE, size, &i2c_handler->ErrorCode);
+
+	if (I2CM_Async_Begin(i2c_handler, NULL, NULL) != HAL_OK) {
+		return HAL_BUSY; // Bus ocupado por otra transferencia
+	}
+	HAL_StatusTypeDef ret = I2CM_Apply_Speed(d);
+	if (ret == HAL_OK) {
+		ret = HAL_I2C_Master_Transmit(i2c_handler, (d->cfg.address << 1), data, size, I2CM_Timeout(d));
+		ret = I2CM_Blocking_Result(i2c_handler, ret, HAL_OK);
+	}
+	I2CM_Blocking_End();
+	return ret;
+}
+
+static HAL_StatusTypeDef I2CM_Blocking_Read(const I2CM_DeviceEntry *d, uint8_t *data, uint16_t size)
+{
+	I2C_HandleTypeDef *i2c_handler = d->cfg.bus;
+	PROF_SCOPE(PROF_ID_I2CM_READ, size, &i2c_handler->ErrorCode);
+
+	if (I2CM_Async_Begin(i2c_handler, NULL, NULL) != HAL_OK) {
+		return HAL_BUSY; // Bus ocupado por otra transferencia
+	}
+	HAL_StatusTypeDef ret = I2CM_Apply_Speed(d);
+	if (ret == HAL_OK) {
+		ret = HAL_I2C_Master_Receive(i2c_handler, (d->cfg.address << 1), data, size, I2CM_Timeout(d));
+		ret = I2CM_Blocking_Result(i2c_handler, ret, HAL_OK);
+	}
+	I2CM_Blocking_End();
+	return ret;
+}
+
+static HAL_StatusTypeDef I2CM_Blocking_Read_Sr(const I2CM_DeviceEntry *d, uint8_t reg, uint8_t *data, uint16_t size)
+{
+	I2C_HandleTypeDef *i2c_handler = d->cfg.bus;
+	PROF_SCOPE(PROF_ID_I2CM_READ_SR, size, &i2c_handler->ErrorCode);
+
+	if (I2CM_Async_Begin(i2c_handler, NULL, NULL) != HAL_OK) {
+		return HAL_BUSY; // Bus ocupado por otra transferencia
+	}
+	HAL_StatusTypeDef ret = I2CM_Apply_Speed(d);
+	if (ret == HAL_OK) {
+		ret = HAL_I2C_Mem_Read(i2c_handler, (d->cfg.address << 1), reg, I2C_MEMADD_SIZE_8BIT, data, size, I2CM_Timeout(d));
+		ret = I2CM_Blocking_Result(i2c_handler, ret, HAL_ERROR);
+	}
+	I2CM_Blocking_End();
+	return ret;
+}
+
+static HAL_StatusTypeDef I2CM_Blocking_IsReady(const I2CM_DeviceEntry *d, uint32_t trials)
+{
+	I2C_HandleTypeDef *i2c_handler = d->cfg.bus;
+	PROF_SCOPE(PROF_ID_I2CM_IS_READY, 0, &i2c_handler->ErrorCode);
+
+	if (I2CM_Async_Begin(i2c_handler, NULL, NULL) != HAL_OK) {
+		return HAL_BUSY; // Bus ocupado por otra transferencia
+	}
+	HAL_StatusTypeDef ret = I2CM_Apply_Speed(d);
+	if (ret == HAL_OK) {
+		ret = HAL_I2C_IsDeviceReady(i2c_handler, (d->cfg.address << 1), trials, I2CM_Timeout(d));
+		ret = I2CM_Blocking_Result(i2c_handler, ret, HAL_ERROR);
+	}
+	I2CM_Blocking_End();
+	return ret;
+}
+
+/* Arranca en el hardware la transferencia ya reservada en i2cm_async. */
+static HAL_StatusTypeDef I2CM_Start(const I2CM_DeviceEntry *d, I2CM_Op op, uint8_t reg,
+                                    uint8_t *data, uint16_t size)
+{
+	I2C_HandleTypeDef *bus = d->cfg.bus;
+	uint16_t addr = (uint16_t)(d->cfg.address << 1);
+
+	if (I2CM_Apply_Speed(d) != HAL_OK) {
+		return HAL_ERROR;
+	}
+	switch (op) {
+	case I2CM_OP_WRITE: {
+		PROF_SCOPE(PROF_ID_I2CM_WRITE_IT, size, &bus->ErrorCode);
+		return HAL_I2C_Master_Transmit_IT(bus, addr, data, size);
+	}
+	case I2CM_OP_READ_SR: {
+		PROF_SCOPE(PROF_ID_I2CM_READ_SR_IT, size, &bus->ErrorCode);
+		return HAL_I2C_Mem_Read_IT(bus, addr, reg, I2C_MEMADD_SIZE_8BIT, data, size);
+	}
+	case I2CM_OP_READ_SR_DMA: {
+		PROF_SCOPE(PROF_ID_I2CM_READ_SR_DMA, size, &bus->ErrorCode);
+		if (!bus->hdmarx) {
+			return HAL_ERROR; // Bus sin stream de RX asignado
 		}
+		return HAL_I2C_Mem_Read_DMA(bus, addr, reg, I2C_MEMADD_SIZE_8BIT, data, size);
+	}
+	default:
+		return HAL_ERROR;
 	}
-	return ret; 
 }
 
-HAL_StatusTypeDef I2CM_Read(uint8_t address, uint8_t *data, uint16_t size)
+/* -------------------------------------------------------------------------- */
+/* Callbacks de HAL (contexto de interrupción I2C1_EV / I2C1_ER)               */
+/* -------------------------------------------------------------------------- */
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	if (hi2c == i2cm_async.bus) {
+		I2CM_Async_Complete(HAL_OK);
+	}
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
 {
-	HAL_StatusTypeDef ret = HAL_OK;
-	I2C_HandleTypeDef *i2c_handler;
+	if (hi2c == i2cm_async.bus) {
+		I2CM_Async_Complete(HAL_OK);
+	}
+}
 
-	if (address == DS3231_ADDRESS) {
-		i2c_handler = &hi2c1;
-	} else {
-		return HAL_ERROR; // Invalid I2C address
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+	if (hi2c == i2cm_async.bus) {
+		I2CM_Async_Complete(HAL_ERROR);
+	}
+}
+
+#else /* I2CM_HOST_SIM */
+
+#define I2CM_DEFAULT_BUS	(NULL)
+
+/* En host no hay bus real: las operaciones bloqueantes fallan siempre. */
+HAL_StatusTypeDef I2CM_I2C1_Init(void) { return HAL_OK; }
+HAL_StatusTypeDef I2CM_I2C1_DeInit(void) { return HAL_OK; }
+static HAL_StatusTypeDef I2CM_Blocking_Write(const I2CM_DeviceEntry *d, uint8_t *data, uint16_t size) { return HAL_ERROR; }
+static HAL_StatusTypeDef I2CM_Blocking_Read(const I2CM_DeviceEntry *d, uint8_t *data, uint16_t size) { return HAL_ERROR; }
+static HAL_StatusTypeDef I2CM_Blocking_Read_Sr(const I2CM_DeviceEntry *d, uint8_t reg, uint8_t *data, uint16_t size) { return HAL_ERROR; }
+static HAL_StatusTypeDef I2CM_Blocking_IsReady(const I2CM_DeviceEntry *d, uint32_t trials) { return HAL_ERROR; }
+
+/* La transferencia queda pendiente hasta que el test llame a I2CM_Async_Complete(). */
+static HAL_StatusTypeDef I2CM_Start(const I2CM_DeviceEntry *d, I2CM_Op op, uint8_t reg,
+                                    uint8_t *data, uint16_t size)
+{
+	i2cm_async.xfer = (I2CM_SimTransfer){ d->cfg.address, op != I2CM_OP_WRITE,
+	                                      op == I2CM_OP_READ_SR_DMA, reg, data, size };
+	return HAL_OK;
+}
+
+#endif /* I2CM_HOST_SIM */
+
+/* -------------------------------------------------------------------------- */
+/* Registro de dispositivos                                                   */
+/* -------------------------------------------------------------------------- */
+
+HAL_StatusTypeDef I2CM_Register(const I2CM_DeviceConfig *config, I2CM_Device *dev)
+{
+	if (!config || !dev) {
+		return HAL_ERROR;
+	}
+	I2CM_Device found = I2CM_Find(config->bus, config->address);
+	I2CM_Device slot = found;
+
+	for (uint8_t i = 0; slot == I2CM_DEVICE_INVALID && i < I2CM_MAX_DEVICES; i++) {
+		if (!i2cm_devices[i].used) {
+			slot = i;
+		}
+	}
+	if (slot == I2CM_DEVICE_INVALID) {
+		return HAL_ERROR; // Registro lleno
+	}
+
+	I2CM_DeviceEntry *d = &i2cm_devices[slot];
+	d->cfg = *config;
+	if (!d->cfg.bus) {
+		d->cfg.bus = I2CM_DEFAULT_BUS;
+	}
+	if (found == I2CM_DEVICE_INVALID) {
+		d->head = NULL;
+		d->tail = NULL;
+		d->used = true;
+	}
+	*dev = slot;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef I2CM_Unregister(I2CM_Device dev)
+{
+	I2CM_DeviceEntry *d = I2CM_Get_Device(dev);
+
+	if (!d) {
+		return HAL_ERROR;
+	}
+	if (d->head) {
+		return HAL_BUSY;
+	}
+	d->used = false;
+	return HAL_OK;
+}
+
+I2CM_Device I2CM_Find(I2C_HandleTypeDef *bus, uint8_t address)
+{
+	if (!bus) {
+		bus = I2CM_DEFAULT_BUS;
 	}
-	if (HAL_I2C_Master_Receive(i2c_handler, (address << 1), data, size, I2C_TIMEOUT) != HAL_OK) {
-		if (HAL_I2C_GetError(i2c_handler) != HAL_I2C_ERROR_AF) {
-			return HAL_ERROR;
+	for (uint8_t i = 0; i < I2CM_MAX_DEVICES; i++) {
+		if (i2cm_devices[i].used && i2cm_devices[i].cfg.bus == bus &&
+		    i2cm_devices[i].cfg.address == address) {
+			return i;
 		}
 	}
-	return ret; 
+	return I2CM_DEVICE_INVALID;
+}
+
+/* -------------------------------------------------------------------------- */
+/* Transferencias bloqueantes                                                 */
+/* -------------------------------------------------------------------------- */
+
+HAL_StatusTypeDef I2CM_Dev_Write(I2CM_Device dev, uint8_t *data, uint16_t size)
+{
+	const I2CM_DeviceEntry *d = I2CM_Get_Device(dev);
+
+	if (!d) {
+		return HAL_ERROR; // Dispositivo no registrado
+	}
+	return I2CM_Blocking_Write(d, data, size);
+}
+
+HAL_StatusTypeDef I2CM_Dev_Read(I2CM_Device dev, uint8_t *data, uint16_t size)
+{
+	const I2CM_DeviceEntry *d = I2CM_Get_Device(dev);
+
+	if (!d) {
+		return HAL_ERROR; // Dispositivo no registrado
+	}
+	return I2CM_Blocking_Read(d, data, size);
+}
+
+HAL_StatusTypeDef I2CM_Dev_Read_Sr(I2CM_Device dev, uint8_t reg, uint8_t *data, uint16_t size)
+{
+	const I2CM_DeviceEntry *d = I2CM_Get_Device(dev);
+
+	if (!d) {
+		return HAL_ERROR; // Dispositivo no registrado
+	}
+	return I2CM_Blocking_Read_Sr(d, reg, data, size);
+}
+
+HAL_StatusTypeDef I2CM_Dev_IsReady(I2CM_Device dev, uint32_t trials)
+{
+	const I2CM_DeviceEntry *d = I2CM_Get_Device(dev);
+
+	if (!d) {
+		return HAL_ERROR; // Dispositivo no registrado
+	}
+	return I2CM_Blocking_IsReady(d, trials);
+}
+
+/* -------------------------------------------------------------------------- */
+/* API por dirección (bus por defecto)                                         */
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Entrada del dispositivo registrado en el bus por defecto. Una dirección no
+ * registrada se atiende como antes del registro: acceso directo con la
+ * velocidad del bus e I2C_TIMEOUT, usando @p tmp como entrada.
+ */
+static const I2CM_DeviceEntry *I2CM_Address_Device(uint8_t address, I2CM_DeviceEntry *tmp)
+{
+	const I2CM_DeviceEntry *d = I2CM_Get_Device(I2CM_Find(NULL, address));
+
+	if (d) {
+		return d;
+	}
+	*tmp = (I2CM_DeviceEntry){ .cfg = { .bus = I2CM_DEFAULT_BUS, .address = address } };
+	return tmp;
+}
+
+HAL_StatusTypeDef I2CM_Write(uint8_t address, uint8_t *data, uint16_t size)
+{
+	I2CM_DeviceEntry tmp;
+	return I2CM_Blocking_Write(I2CM_Address_Device(address, &tmp), data, size);
+}
+
+HAL_StatusTypeDef I2CM_Read(uint8_t address, uint8_t *data, uint16_t size)
+{
+	I2CM_DeviceEntry tmp;
+	return I2CM_Blocking_Read(I2CM_Address_Device(address, &tmp), data, size);
 }
 
 HAL_StatusTypeDef I2CM_Read_Sr(uint8_t address, uint8_t reg, uint8_t *data, uint16_t size)
 {
-	HAL_StatusTypeDef ret = HAL_OK;
-	I2C_HandleTypeDef *i2c_handler;
+	I2CM_DeviceEntry tmp;
+	return I2CM_Blocking_Read_Sr(I2CM_Address_Device(address, &tmp), reg, data, size);
+}
 
-	if (address == DS3231_ADDRESS) {
-		i2c_handler = &hi2c1;
-	} else {
-		return HAL_ERROR; // Invalid I2C address
+HAL_StatusTypeDef I2CM_IsDeviceReady(uint8_t address, uint32_t trials)
+{
+	I2CM_DeviceEntry tmp;
+	return I2CM_Blocking_IsReady(I2CM_Address_Device(address, &tmp), trials);
+}
+
+/* -------------------------------------------------------------------------- */
+/* Transferencias asíncronas                                                  */
+/* -------------------------------------------------------------------------- */
+
+static HAL_StatusTypeDef I2CM_Async_Start_Now(uint8_t address, I2CM_Op op, uint8_t reg,
+                                              uint8_t *data, uint16_t size,
+                                              I2CM_Callback cb, void *ctx)
+{
+	I2CM_DeviceEntry tmp;
+	const I2CM_DeviceEntry *d = I2CM_Address_Device(address, &tmp);
+
+	if (!data || size == 0) {
+		return HAL_ERROR;
+	}
+	if (I2CM_Async_Begin(d->cfg.bus, cb, ctx) != HAL_OK) {
+		return HAL_BUSY;
 	}
-	if (HAL_I2C_Mem_Read(i2c_handler, (address << 1), reg, I2C_MEMADD_SIZE_8BIT, data, size, I2C_TIMEOUT) != HAL_OK) {
-		if (HAL_I2C_GetError(i2c_handler) != HAL_I2C_ERROR_AF) {
-			return HAL_ERROR;
+	if (I2CM_Start(d, op, reg, data, size) != HAL_OK) {
+		I2CM_Async_Abort();
+		return HAL_ERROR;
+	}
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef I2CM_Write_IT(uint8_t address, uint8_t *data, uint16_t size,
+                                I2CM_Callback cb, void *ctx)
+{
+	return I2CM_Async_Start_Now(address, I2CM_OP_WRITE, 0, data, size, cb, ctx);
+}
+
+HAL_StatusTypeDef I2CM_Read_Sr_IT(uint8_t address, uint8_t reg, uint8_t *data, uint16_t size,
+                                  I2CM_Callback cb, void *ctx)
+{
+	return I2CM_Async_Start_Now(address, I2CM_OP_READ_SR, reg, data, size, cb, ctx);
+}
+
+HAL_StatusTypeDef I2CM_Read_Sr_DMA(uint8_t address, uint8_t reg, uint8_t *data, uint16_t size,
+                                   I2CM_Callback cb, void *ctx)
+{
+	return I2CM_Async_Start_Now(address, I2CM_OP_READ_SR_DMA, reg, data, size, cb, ctx);
+}
+
+/*
+ * Con el bus libre, toma la próxima transferencia encolada recorriendo los
+ * dispositivos a partir del último atendido (round-robin) y la arranca. Si
+ * falla al arrancar se notifica y se prueba con la siguiente.
+ */
+static void I2CM_Sched_Next(void)
+{
+	for (;;) {
+		I2CM_Request *req = NULL;
+		const I2CM_DeviceEntry *d = NULL;
+
+		I2CM_CRITICAL_ENTER();
+		if (!i2cm_async.busy) {
+			for (uint8_t k = 1; k <= I2CM_MAX_DEVICES; k++) {
+				uint8_t i = (uint8_t)((i2cm_rr_last + k) % I2CM_MAX_DEVICES);
+				I2CM_DeviceEntry *e = &i2cm_devices[i];
+				if (e->used && e->head) {
+					req = e->head;
+					e->head = req->next;
+					if (!e->head) {
+						e->tail = NULL;
+					}
+					i2cm_rr_last = i;
+					d = e;
+					break;
+				}
+			}
+			if (req) {
+				i2cm_async.busy = true;
+				i2cm_async.bus  = d->cfg.bus;
+				i2cm_async.cb   = req->cb;
+				i2cm_async.ctx  = req->ctx;
+			}
+		}
+		I2CM_CRITICAL_EXIT();
+
+		if (!req) {
+			return;
+		}
+		if (I2CM_Start(d, req->op, req->reg, req->data, req->size) == HAL_OK) {
+			return;
+		}
+		I2CM_Async_Abort();
+		if (req->cb) {
+			req->cb(HAL_ERROR, req->ctx);
 		}
-		ret = HAL_ERROR;
 	}
-	return ret; 
 }
 
-HAL_StatusTypeDef I2CM_IsDeviceReady(uint8_t address, uint32_t trials)
+HAL_StatusTypeDef I2CM_Submit(I2CM_Request *req)
 {
-	HAL_StatusTypeDef ret = HAL_OK;
-	I2C_HandleTypeDef *i2c_handler;
+	if (!req || !req->data || req->size == 0 || req->op > I2CM_OP_READ_SR_DMA) {
+		return HAL_ERROR;
+	}
+	I2CM_DeviceEntry *d = I2CM_Get_Device(req->dev);
+	if (!d) {
+		return HAL_ERROR;
+	}
 
-	if (address == DS3231_ADDRESS) {
-		i2c_handler = &hi2c1;
+	req->next = NULL;
+	I2CM_CRITICAL_ENTER();
+	if (d->tail) {
+		d->tail->next = req;
 	} else {
-		return HAL_ERROR; // Invalid I2C address
+		d->head = req;
 	}
-	if (HAL_I2C_IsDeviceReady(i2c_handler, (address << 1), trials, I2C_TIMEOUT) != HAL_OK) {
-		if (HAL_I2C_GetError(i2c_handler) != HAL_I2C_ERROR_AF) {
-			return HAL_ERROR;
-		}
-		ret = HAL_ERROR;
+	d->tail = req;
+	I2CM_CRITICAL_EXIT();
+
+	I2CM_Sched_Next();
+	return HAL_OK;
+}
+
+bool I2CM_Async_IsBusy(void)
+{
+	return i2cm_async.busy;
+}
+
+void I2CM_Async_Complete(HAL_StatusTypeDef status)
+{
+	if (!i2cm_async.busy) {
+		return;
 	}
-	return ret; 
-}
\ No newline at end of file
+	// Libero el bus y arranco la siguiente en cola antes del callback: lo que
+	// encole el callback espera su turno detrás de los demás dispositivos.
+	I2CM_Callback cb = i2cm_async.cb;
+	void *ctx = i2cm_async.ctx;
+	I2CM_Async_Abort();
+	I2CM_Sched_Next();
+
+	if (cb) {
+		cb(status, ctx);
+	}
+}
+
+#ifdef I2CM_HOST_SIM
+const I2CM_SimTransfer *I2CM_Sim_GetPending(void)
+{
+	return i2cm_async.busy ? &i2cm_async.xfer : NULL;
+}
+#endif
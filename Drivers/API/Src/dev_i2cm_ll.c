@@ -0,0 +1,178 @@
+/**
+ * @file    dev_i2cm_ll.c
+ * @brief   I2C Master por polling sobre los drivers LL (STM32F4, I2C v1).
+ */
+
+#include "dev_i2cm_ll.h"
+#include "dev_i2cm.h"
+
+#ifndef I2CM_HOST_SIM
+
+/* Espera a que se active un flag, abortando ante NACK o timeout. */
+static HAL_StatusTypeDef I2CM_LL_WaitFlag(I2C_TypeDef *I2Cx, uint32_t (*is_active)(I2C_TypeDef *),
+                                          uint32_t tickstart)
+{
+	while (!is_active(I2Cx)) {
+		if (LL_I2C_IsActiveFlag_AF(I2Cx)) {
+			LL_I2C_ClearFlag_AF(I2Cx);
+			LL_I2C_GenerateStopCondition(I2Cx);
+			return HAL_ERROR;
+		}
+		if ((HAL_GetTick() - tickstart) > I2C_TIMEOUT) {
+			LL_I2C_GenerateStopCondition(I2Cx);
+			return HAL_TIMEOUT;
+		}
+	}
+	return HAL_OK;
+}
+
+/* START + dirección. Deja ADDR sin limpiar para que el llamador prepare ACK/POS. */
+static HAL_StatusTypeDef I2CM_LL_Start(I2C_TypeDef *I2Cx, uint8_t addr8, uint32_t tickstart)
+{
+	LL_I2C_GenerateStartCondition(I2Cx);
+	if (I2CM_LL_WaitFlag(I2Cx, LL_I2C_IsActiveFlag_SB, tickstart) != HAL_OK) {
+		return HAL_ERROR;
+	}
+	LL_I2C_TransmitData8(I2Cx, addr8);
+	return I2CM_LL_WaitFlag(I2Cx, LL_I2C_IsActiveFlag_ADDR, tickstart);
+}
+
+static HAL_StatusTypeDef I2CM_LL_WaitIdle(I2C_TypeDef *I2Cx, uint32_t tickstart)
+{
+	while (LL_I2C_IsActiveFlag_BUSY(I2Cx)) {
+		if ((HAL_GetTick() - tickstart) > I2C_TIMEOUT) {
+			return HAL_BUSY;
+		}
+	}
+	return HAL_OK;
+}
+
+static HAL_StatusTypeDef I2CM_LL_Send(I2C_TypeDef *I2Cx, const uint8_t *data, uint16_t size, uint32_t tickstart)
+{
+	for (uint16_t i = 0; i < size; i++) {
+		if (I2CM_LL_WaitFlag(I2Cx, LL_I2C_IsActiveFlag_TXE, tickstart) != HAL_OK) {
+			return HAL_ERROR;
+		}
+		LL_I2C_TransmitData8(I2Cx, data[i]);
+	}
+	return I2CM_LL_WaitFlag(I2Cx, LL_I2C_IsActiveFlag_BTF, tickstart);
+}
+
+HAL_StatusTypeDef I2CM_LL_Write(I2C_TypeDef *I2Cx, uint8_t address, const uint8_t *data, uint16_t size)
+{
+	uint32_t tickstart = HAL_GetTick();
+
+	if (!data || size == 0) {
+		return HAL_ERROR;
+	}
+	if (I2CM_LL_WaitIdle(I2Cx, tickstart) != HAL_OK) {
+		return HAL_BUSY;
+	}
+	if (I2CM_LL_Start(I2Cx, (uint8_t)(address << 1), tickstart) != HAL_OK) {
+		return HAL_ERROR;
+	}
+	LL_I2C_ClearFlag_ADDR(I2Cx);
+
+	if (I2CM_LL_Send(I2Cx, data, size, tickstart) != HAL_OK) {
+		return HAL_ERROR;
+	}
+	LL_I2C_GenerateStopCondition(I2Cx);
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef I2CM_LL_Read_Sr(I2C_TypeDef *I2Cx, uint8_t address, uint8_t reg, uint8_t *data, uint16_t size)
+{
+	uint32_t tickstart = HAL_GetTick();
+	uint16_t remaining = size;
+
+	if (!data || size == 0) {
+		return HAL_ERROR;
+	}
+	if (I2CM_LL_WaitIdle(I2Cx, tickstart) != HAL_OK) {
+		return HAL_BUSY;
+	}
+
+	// Fase de escritura: dirección del registro interno.
+	if (I2CM_LL_Start(I2Cx, (uint8_t)(address << 1), tickstart) != HAL_OK) {
+		return HAL_ERROR;
+	}
+	LL_I2C_ClearFlag_ADDR(I2Cx);
+	if (I2CM_LL_Send(I2Cx, &reg, 1, tickstart) != HAL_OK) {
+		return HAL_ERROR;
+	}
+
+	// Repeated start en modo lectura.
+	if (I2CM_LL_Start(I2Cx, (uint8_t)((address << 1) | 0x01), tickstart) != HAL_OK) {
+		return HAL_ERROR;
+	}
+
+	// Secuencias de recepción del I2C v1 (RM0390, 1 / 2 / N bytes).
+	if (size == 1) {
+		LL_I2C_AcknowledgeNextData(I2Cx, LL_I2C_NACK);
+		LL_I2C_ClearFlag_ADDR(I2Cx);
+		LL_I2C_GenerateStopCondition(I2Cx);
+		if (I2CM_LL_WaitFlag(I2Cx, LL_I2C_IsActiveFlag_RXNE, tickstart) != HAL_OK) {
+			return HAL_ERROR;
+		}
+		data[0] = LL_I2C_ReceiveData8(I2Cx);
+		return HAL_OK;
+	}
+
+	if (size == 2) {
+		LL_I2C_AcknowledgeNextData(I2Cx, LL_I2C_NACK);
+		LL_I2C_EnableBitPOS(I2Cx);
+		LL_I2C_ClearFlag_ADDR(I2Cx);
+		if (I2CM_LL_WaitFlag(I2Cx, LL_I2C_IsActiveFlag_BTF, tickstart) != HAL_OK) {
+			LL_I2C_DisableBitPOS(I2Cx);
+			return HAL_ERROR;
+		}
+		LL_I2C_GenerateStopCondition(I2Cx);
+		data[0] = LL_I2C_ReceiveData8(I2Cx);
+		data[1] = LL_I2C_ReceiveData8(I2Cx);
+		LL_I2C_DisableBitPOS(I2Cx);
+		return HAL_OK;
+	}
+
+	LL_I2C_AcknowledgeNextData(I2Cx, LL_I2C_ACK);
+	LL_I2C_ClearFlag_ADDR(I2Cx);
+	while (remaining > 3) {
+		if (I2CM_LL_WaitFlag(I2Cx, LL_I2C_IsActiveFlag_RXNE, tickstart) != HAL_OK) {
+			return HAL_ERROR;
+		}
+		*data++ = LL_I2C_ReceiveData8(I2Cx);
+		remaining--;
+	}
+
+	// Últimos 3 bytes: NACK al penúltimo y STOP antes de leer los dos finales.
+	if (I2CM_LL_WaitFlag(I2Cx, LL_I2C_IsActiveFlag_BTF, tickstart) != HAL_OK) {
+		return HAL_ERROR;
+	}
+	LL_I2C_AcknowledgeNextData(I2Cx, LL_I2C_NACK);
+	*data++ = LL_I2C_ReceiveData8(I2Cx);
+	if (I2CM_LL_WaitFlag(I2Cx, LL_I2C_IsActiveFlag_BTF, tickstart) != HAL_OK) {
+		return HAL_ERROR;
+	}
+	LL_I2C_GenerateStopCondition(I2Cx);
+	*data++ = LL_I2C_ReceiveData8(I2Cx);
+	*data   = LL_I2C_ReceiveData8(I2Cx);
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef I2CM_LL_IsDeviceReady(I2C_TypeDef *I2Cx, uint8_t address, uint32_t trials)
+{
+	for (uint32_t i = 0; i < trials; i++) {
+		uint32_t tickstart = HAL_GetTick();
+
+		if (I2CM_LL_WaitIdle(I2Cx, tickstart) != HAL_OK) {
+			return HAL_BUSY;
+		}
+		if (I2CM_LL_Start(I2Cx, (uint8_t)(address << 1), tickstart) == HAL_OK) {
+			LL_I2C_ClearFlag_ADDR(I2Cx);
+			LL_I2C_GenerateStopCondition(I2Cx);
+			return HAL_OK;
+		}
+	}
+	return HAL_ERROR;
+}
+
+#endif /* I2CM_HOST_SIM */
@@ -0,0 +1,239 @@
+/**
+ * @file    dev_prof.c
+ * @brief   Buffer circular de registros de ciclos y agregación por llamada.
+ */
+
+#include "dev_prof.h"
+
+#ifdef DEV_PROF_ENABLE
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef I2CM_HOST_SIM
+#include "stm32f4xx_hal.h"
+#include "usart.h"
+#endif
+
+/* Entrada del buffer: seq = índice de escritura + 1 una vez completa, 0 mientras se escribe. */
+typedef struct {
+    volatile uint32_t seq;
+    PROF_Record rec;
+} PROF_Slot;
+
+static PROF_Slot prof_ring[PROF_RING_SIZE];
+static uint32_t prof_head;                  /* Próximo índice a reservar (atómico). */
+static volatile uint32_t prof_err_seq;      /* Registros con error desde el inicio. */
+static volatile uint32_t prof_last_error;   /* Último código de error registrado. */
+static uint32_t prof_scratch[PROF_RING_SIZE];
+
+static const char *const prof_names[PROF_ID_COUNT] = {
+#define PROF_ID_NAME(name) #name,
+    PROF_CALL_LIST(PROF_ID_NAME)
+#undef PROF_ID_NAME
+};
+
+/* -------------------------------------------------------------------------- */
+/*  Fuente de ciclos                                                          */
+/* -------------------------------------------------------------------------- */
+
+static uint32_t prof_dwt_cycles(void)
+{
+#ifndef I2CM_HOST_SIM
+    return DWT->CYCCNT;
+#else
+    return 0;
+#endif
+}
+
+static PROF_CycleSource prof_source = prof_dwt_cycles;
+
+void PROF_SetCycleSource(PROF_CycleSource source)
+{
+    prof_source = source ? source : prof_dwt_cycles;
+}
+
+uint32_t PROF_Cycles(void)
+{
+    return prof_source();
+}
+
+void PROF_Init(void)
+{
+#ifndef I2CM_HOST_SIM
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    PROF_Reset();
+}
+
+void PROF_Reset(void)
+{
+    for (uint32_t i = 0; i < PROF_RING_SIZE; i++) {
+        prof_ring[i].seq = 0;
+    }
+    __atomic_store_n(&prof_head, 0, __ATOMIC_RELAXED);
+    prof_err_seq = 0;
+    prof_last_error = 0;
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Registro                                                                  */
+/* -------------------------------------------------------------------------- */
+
+void PROF_Log(PROF_CallId id, uint32_t start, uint32_t end, uint16_t bytes, uint32_t error)
+{
+    // Reserva sin lock (LDREX/STREX en Cortex-M4): una ISR puede registrar en medio.
+    uint32_t idx = __atomic_fetch_add(&prof_head, 1, __ATOMIC_RELAXED);
+    PROF_Slot *slot = &prof_ring[idx & (PROF_RING_SIZE - 1U)];
+
+    slot->seq = 0;
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    slot->rec.start = start;
+    slot->rec.end   = end;
+    slot->rec.id    = (uint16_t)id;
+    slot->rec.bytes = bytes;
+    slot->rec.error = error;
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    slot->seq = idx + 1U;
+
+    if (error) {
+        prof_last_error = error;
+        prof_err_seq++;
+    }
+}
+
+PROF_Scope PROF_ScopeBegin(PROF_CallId id, uint16_t bytes, const volatile uint32_t *error)
+{
+    PROF_Scope scope = {
+        .err_seq = prof_err_seq,
+        .error   = error,
+        .id      = (uint16_t)id,
+        .bytes   = bytes,
+    };
+    scope.start = prof_source();
+    return scope;
+}
+
+void PROF_ScopeEnd(PROF_Scope *scope)
+{
+    uint32_t end = prof_source();
+    uint32_t error;
+
+    if (scope->error) {
+        error = *scope->error;
+    } else {
+        // Sin fuente propia: hereda el error de alguna llamada anidada.
+        error = (prof_err_seq != scope->err_seq) ? prof_last_error : 0;
+    }
+    PROF_Log((PROF_CallId)scope->id, scope->start, end, scope->bytes, error);
+}
+
+/* -------------------------------------------------------------------------- */
+/*  Agregación                                                                */
+/* -------------------------------------------------------------------------- */
+
+/* Copia el registro de un slot; false si está vacío o se estaba escribiendo. */
+static bool prof_read_slot(const PROF_Slot *slot, PROF_Record *rec)
+{
+    uint32_t seq = slot->seq;
+    if (seq == 0) {
+        return false;
+    }
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    *rec = slot->rec;
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    return slot->seq == seq;
+}
+
+static void prof_sort(uint32_t *v, uint32_t n)
+{
+    // Inserción: n <= PROF_RING_SIZE y los datos suelen venir casi ordenados.
+    for (uint32_t i = 1; i < n; i++) {
+        uint32_t x = v[i];
+        uint32_t j = i;
+        while (j > 0 && v[j - 1] > x) {
+            v[j] = v[j - 1];
+            j--;
+        }
+        v[j] = x;
+    }
+}
+
+bool PROF_Aggregate(PROF_CallId id, PROF_Stats *stats)
+{
+    if (!stats || id >= PROF_ID_COUNT) return false;
+
+    uint32_t n = 0;
+    uint32_t errors = 0;
+    uint64_t sum = 0;
+
+    for (uint32_t i = 0; i < PROF_RING_SIZE; i++) {
+        PROF_Record rec;
+        if (!prof_read_slot(&prof_ring[i], &rec) || rec.id != (uint16_t)id) {
+            continue;
+        }
+        uint32_t cycles = rec.end - rec.start;   // válido aunque CYCCNT desborde
+        prof_scratch[n++] = cycles;
+        sum += cycles;
+        if (rec.error) errors++;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    if (n == 0) return false;
+
+    prof_sort(prof_scratch, n);
+    stats->count  = n;
+    stats->errors = errors;
+    stats->min    = prof_scratch[0];
+    stats->max    = prof_scratch[n - 1];
+    stats->avg    = (uint32_t)(sum / n);
+    stats->p99    = prof_scratch[(99U * n + 99U) / 100U - 1U];
+    return true;
+}
+
+const char *PROF_Name(PROF_CallId id)
+{
+    return (id < PROF_ID_COUNT) ? prof_names[id] : "?";
+}
+
+void PROF_Dump(PROF_WriteFn write)
+{
+    char line[96];
+    int len;
+
+    if (!write) return;
+
+    len = snprintf(line, sizeof(line), "call,count,errors,min,avg,max,p99\r\n");
+    write(line, (uint16_t)len);
+
+    for (uint32_t id = 0; id < PROF_ID_COUNT; id++) {
+        PROF_Stats s;
+        if (!PROF_Aggregate((PROF_CallId)id, &s)) {
+            continue;
+        }
+        len = snprintf(line, sizeof(line), "%s,%lu,%lu,%lu,%lu,%lu,%lu\r\n",
+                       prof_names[id],
+                       (unsigned long)s.count, (unsigned long)s.errors,
+                       (unsigned long)s.min, (unsigned long)s.avg,
+                       (unsigned long)s.max, (unsigned long)s.p99);
+        if (len > 0) {
+            write(line, (uint16_t)((len < (int)sizeof(line)) ? len : (int)sizeof(line) - 1));
+        }
+    }
+}
+
+#ifndef I2CM_HOST_SIM
+static void prof_uart_write(const char *text, uint16_t len)
+{
+    HAL_UART_Transmit(&huart2, (uint8_t *)text, len, HAL_MAX_DELAY);
+}
+
+void PROF_DumpUART(void)
+{
+    PROF_Dump(prof_uart_write);
+}
+#endif
+
+#endif /* DEV_PROF_ENABLE */